@@ -0,0 +1,578 @@
+/* bench.c - Last modified: 16-Oct-2026 (kobayasy)
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* 性能測定
+ * 使い方: bench [-t スレッド数] [-m 最大バイト数] [-s 測定秒数] [-o 処理名] [-b キー長]
+ *  -t: 測定する最大スレッド数 (1, 2, 4, ... と指定値まで倍々に増やす, 省略時はCPU数)
+ *  -m: 測定する最大データサイズ (16バイトから4倍ずつ増やす, 省略時は64MB)
+ *  -s: 1項目あたりの最短測定時間 (省略時は0.1秒)
+ *  -o: 測定する処理 (keysche, single, bulk, bulkinv, ctr, cbcenc, cbcdec, cbcstreams, gcm, xtsenc, xtsdec, 省略時は全て)
+ *  -b: 測定するキー長 (128, 192, 256, 省略時は全て)
+ * 使い方: bench -k [-m バイト数] [-s 測定秒数] [-o 処理名] [-b キー長] [-w 記録ファイル] [-c 基準ファイル] [-x 許容低下率]
+ *  -k: 利用可能なカーネルを1スレッドで5回ずつ交互に測定し, 中央値の汎用カーネル比を使う (性能低下の検出用)
+ *  -m: 1回の処理のバイト数 (省略時は64KB)
+ *  -o: 測定する処理 (keysche 以外, 省略時は bulk, ctr, gcm, xtsenc)
+ *  -b: 測定するキー長 (省略時は128)
+ *  -w: 測定結果を基準として記録する (1行に カーネル名 処理名 汎用カーネル比)
+ *  -c: 基準と比較し, 基準より許容低下率を超えて遅いカーネルと処理があれば異常終了する
+ *  -x: 許容低下率 (省略時は0.3, 1CPU の負荷のあるマシンで汎用カーネル比が実行ごとに最大3割ほど揺らぐため)
+ *  自動選択されるカーネルが汎用カーネルより許容低下率を超えて遅い場合も異常終了する
+ * 結果はタブ区切りで1行1項目を出力する(#で始まる行はコメント)
+ *  op: 処理名, key: キー長, size: 1回の処理のバイト数, threads: スレッド数,
+ *  ops: 全スレッドの合計処理回数, seconds: 経過時間,
+ *  cycles_op: 1スレッドの1回の処理あたりの TSC サイクル数,
+ *  cycles_byte: 1スレッドの1バイトあたりの TSC サイクル数 (TSC がない場合は0),
+ *  gbps: 全スレッド合計のスループット (10^9 バイト/秒)
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "camellia.h"
+#include "camellia_ctr.h"
+#include "camellia_gcm.h"
+#include "camellia_cbc.h"
+#include "camellia_xts.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define tsc() __rdtsc()
+#else  /* #if defined(__GNUC__) && ... */
+#define tsc() 0
+#endif  /* #if defined(__GNUC__) && ... */
+
+/* XTS モードのセクタのバイト数 */
+#define SECTOR 4096
+
+/* CBC モード複数ストリームのストリーム数(データを等分する) */
+#define STREAMS 64
+
+/* カーネル種別の数(CamelliaKernel の最後の値 + 1) */
+#define KERNELS (CamelliaKernelAvx512 + 1)
+
+/* カーネルごとの測定で1項目を測定する回数(中央値を使う, 奇数) */
+#define REPEAT 5
+
+/* 測定対象の処理 */
+typedef struct {  /* 測定条件 */
+    CamelliaKeytype type;  /* 暗号キー種別 */
+    CamelliaData data;     /* 変換テーブル(暗号キー) */
+    CamelliaData data2;    /* 変換テーブル(XTS モードの調整値用キー) */
+    uint8_t key[32];       /* キー */
+    uint8_t *buf;          /* データ */
+    size_t size;           /* 1回の処理のバイト数 */
+} Work;
+typedef struct {  /* 処理 */
+    const char *name;                            /* 処理名 */
+    int (*run)(Work *work, unsigned long ops);   /* 処理を ops 回繰り返す */
+    int regress;                                 /* 0以外=カーネルごとの測定(-k)で既定の測定対象 */
+} Op;
+
+/* キースケジューリング処理 */
+static int runKeysche(Work *work, unsigned long ops) {
+    int status = -1;
+
+    while (ops-- > 0)
+        if (camelliaKeysche(work->type, work->key, &work->data) < 0)
+            goto error;
+    status = 0;
+error:
+    return status;
+}
+
+/* データランダム化処理(1ブロックずつ) */
+static int runSingle(Work *work, unsigned long ops) {
+    int status = -1;
+    size_t n;
+
+    while (ops-- > 0)
+        for (n = 0; n < work->size; n += 16)
+            if (camelliaDatarand(work->buf + n, &work->data, work->buf + n) < 0)
+                goto error;
+    status = 0;
+error:
+    return status;
+}
+
+/* データランダム化処理(複数ブロック一括) */
+static int runBulk(Work *work, unsigned long ops) {
+    int status = -1;
+
+    while (ops-- > 0)
+        if (camelliaDatarandBulk(work->buf, &work->data, work->buf, work->size / 16) < 0)
+            goto error;
+    status = 0;
+error:
+    return status;
+}
+
+/* データランダム化処理の逆変換(複数ブロック一括) */
+static int runBulkinv(Work *work, unsigned long ops) {
+    int status = -1;
+
+    while (ops-- > 0)
+        if (camelliaDatarandInvBulk(work->buf, &work->data, work->buf, work->size / 16) < 0)
+            goto error;
+    status = 0;
+error:
+    return status;
+}
+
+/* CTR モード */
+static int runCtr(Work *work, unsigned long ops) {
+    int status = -1;
+    CamelliaCtr ctr;
+
+    while (ops-- > 0) {
+        if (camelliaCtrInit(&ctr, &work->data, work->key) < 0)
+            goto error;
+        if (camelliaCtrUpdate(&ctr, work->buf, work->buf, work->size) < 0)
+            goto error;
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* CBC モードの暗号化 */
+static int runCbcenc(Work *work, unsigned long ops) {
+    int status = -1;
+    uint8_t iv[16];
+
+    while (ops-- > 0) {
+        memcpy(iv, work->key, sizeof(iv));
+        if (camelliaCbcEncrypt(&work->data, iv, work->buf, work->buf, work->size / 16) < 0)
+            goto error;
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* CBC モードの復号 */
+static int runCbcdec(Work *work, unsigned long ops) {
+    int status = -1;
+    uint8_t iv[16];
+
+    while (ops-- > 0) {
+        memcpy(iv, work->key, sizeof(iv));
+        if (camelliaCbcDecrypt(&work->data, iv, work->buf, work->buf, work->size / 16) < 0)
+            goto error;
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* CBC モードの複数ストリーム暗号化 */
+static int runCbcstreams(Work *work, unsigned long ops) {
+    int status = -1;
+    CamelliaCbcStream stream[STREAMS];
+    size_t blocks, ns, n;
+
+    blocks = work->size / 16;
+    ns = blocks < STREAMS ? blocks : STREAMS;
+    while (ops-- > 0) {
+        for (n = 0; n < ns; ++n) {
+            stream[n].data = &work->data;
+            memcpy(stream[n].iv, work->key, sizeof(stream[n].iv));
+            stream[n].out = work->buf + 16 * (blocks * n / ns), stream[n].in = stream[n].out;
+            stream[n].n = blocks * (n + 1) / ns - blocks * n / ns;
+        }
+        if (camelliaCbcEncryptStreams(stream, ns) < 0)
+            goto error;
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* GCM モードの暗号化 */
+static int runGcm(Work *work, unsigned long ops) {
+    int status = -1;
+    CamelliaGcm gcm;
+    uint8_t tag[16];
+
+    while (ops-- > 0) {
+        if (camelliaGcmInit(&gcm, &work->data, work->key, 12) < 0)
+            goto error;
+        if (camelliaGcmEncrypt(&gcm, work->buf, work->buf, work->size) < 0)
+            goto error;
+        if (camelliaGcmFinal(&gcm, tag, sizeof(tag)) < 0)
+            goto error;
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* XTS モードの連続したセクタの処理
+ * dec: 0=暗号化, 0以外=復号
+ */
+static int runXts(Work *work, unsigned long ops, int dec) {
+    int status = -1;
+
+    while (ops-- > 0)
+        if ((dec ? camelliaXtsDecryptSectors : camelliaXtsEncryptSectors)(&work->data, &work->data2, 0, SECTOR,
+                                                                           work->buf, work->buf, work->size ) < 0)
+            goto error;
+    status = 0;
+error:
+    return status;
+}
+
+/* XTS モードの暗号化 */
+static int runXtsenc(Work *work, unsigned long ops) {
+    return runXts(work, ops, 0);
+}
+
+/* XTS モードの復号 */
+static int runXtsdec(Work *work, unsigned long ops) {
+    return runXts(work, ops, 1);
+}
+
+/* ファイル内共有定数 */
+static const Op ops[] = {
+    {"keysche",    runKeysche,    0},
+    {"single",     runSingle,     0},
+    {"bulk",       runBulk,       1},
+    {"bulkinv",    runBulkinv,    0},
+    {"ctr",        runCtr,        1},
+    {"cbcenc",     runCbcenc,     0},
+    {"cbcdec",     runCbcdec,     0},
+    {"cbcstreams", runCbcstreams, 0},
+    {"gcm",        runGcm,        1},
+    {"xtsenc",     runXtsenc,     1},
+    {"xtsdec",     runXtsdec,     0}
+};
+
+/* スレッドごとの測定状態 */
+typedef struct {  /* スレッド */
+    pthread_t thread;     /* スレッド */
+    const Op *op;         /* 処理 */
+    Work work;            /* 測定条件 */
+    unsigned long count;  /* 処理回数 */
+    int status;           /* 処理結果 */
+} Thread;
+
+/* 測定スレッド */
+static void *thread(void *arg) {
+    Thread *t = arg;
+
+    t->status = t->op->run(&t->work, t->count);
+    return NULL;
+}
+
+/* 現在時刻(秒) */
+static double now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* 1項目の測定
+ * op: 処理
+ * type: 暗号キー種別
+ * size: 1回の処理のバイト数
+ * nthreads: スレッド数
+ * seconds: 最短測定時間
+ * gbps: 全スレッド合計のスループットを返す (NULL=返さない)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了
+ */
+static int measure(const Op *op, CamelliaKeytype type, size_t size,
+                   int nthreads, double seconds, double *gbps ) {
+    int status = -1;
+    Thread *t = NULL;
+    unsigned long count;
+    double t0, t1;
+    uint64_t c0, c1;
+    uint8_t key2[32];
+    int i, n;
+
+    t = calloc(nthreads, sizeof(*t));
+    if (t == NULL)
+        goto error;
+    for (i = 0; i < nthreads; ++i) {
+        t[i].op = op;
+        t[i].work.type = type;
+        for (n = 0; n < 32; ++n)
+            t[i].work.key[n] = n * 17 + i, key2[n] = n * 29 + i + 1;
+        if (camelliaKeysche(type, t[i].work.key, &t[i].work.data) < 0)
+            goto error;
+        if (camelliaKeysche(type, key2, &t[i].work.data2) < 0)
+            goto error;
+        t[i].work.size = size;
+        t[i].work.buf = calloc(1, size > 0 ? size : 1);
+        if (t[i].work.buf == NULL)
+            goto error;
+    }
+    count = 1;
+    for (;;) {  /* 最短測定時間を超えるまで処理回数を増やす */
+        t0 = now(), c0 = tsc();
+        for (n = 0; n < nthreads; ++n) {
+            t[n].count = count;
+            if (pthread_create(&t[n].thread, NULL, thread, &t[n]))
+                break;
+        }
+        for (i = 0; i < n; ++i)
+            pthread_join(t[i].thread, NULL);
+        t1 = now(), c1 = tsc();
+        if (n < nthreads)
+            goto error;
+        for (i = 0; i < nthreads; ++i)
+            if (t[i].status < 0)
+                goto error;
+        if (t1 - t0 >= seconds)
+            break;
+        if (t1 - t0 > seconds / 100)
+            count = count * (seconds * 1.2 / (t1 - t0)) + 1;
+        else
+            count *= 100;
+    }
+    printf("%s\t%d\t%zu\t%d\t%lu\t%.6f\t%.1f\t%.3f\t%.3f\n",
+           op->name, type == Camellia128Encrypt ? 128 : type == Camellia192Encrypt ? 192 : 256,
+           size, nthreads, count * nthreads, t1 - t0,
+           (double)(c1 - c0) / count, size > 0 ? (double)(c1 - c0) / count / size : 0.0,
+           (double)size * count * nthreads / (t1 - t0) * 1e-9 );
+    fflush(stdout);
+    if (gbps != NULL)
+        *gbps = (double)size * count * nthreads / (t1 - t0) * 1e-9;
+    status = 0;
+error:
+    if (t != NULL) {
+        for (i = 0; i < nthreads; ++i)
+            free(t[i].work.buf);
+        free(t);
+    }
+    return status;
+}
+
+/* 2つの測定値の比較(qsort 用) */
+static int compare(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+/* カーネルごとの測定と性能低下の検出
+ * 処理ごとに全カーネルを REPEAT 回ずつ交互に測定し, 中央値の汎用カーネル比で比べる
+ * (同じ実行の中での比なので, マシンの負荷やクロックの変動の影響を受けにくい)
+ * name: 測定する処理名 (NULL=既定の測定対象)
+ * type: 暗号キー種別
+ * size: 1回の処理のバイト数
+ * seconds: 最短測定時間
+ * record: 測定結果を記録するファイル名 (NULL=記録しない)
+ * base: 比較する基準のファイル名 (NULL=比較しない)
+ * tol: 許容低下率
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(性能低下を検出した場合を含む)
+ */
+static int regress(const char *name, CamelliaKeytype type, size_t size,
+                   double seconds, const char *record, const char *base,
+                   double tol ) {
+    int status = -1;
+    double sample[KERNELS][REPEAT];                          /* 測定値(gbps) */
+    double ratio[KERNELS][sizeof(ops) / sizeof(*ops)] = {{0}};  /* 中央値の汎用カーネル比(0=未測定) */
+    double median[KERNELS];
+    FILE *file = NULL;
+    char kname[32], oname[32];
+    double value;
+    CamelliaKernel kernel, best;
+    size_t o;
+    int n;
+    int slow = 0;
+
+    printf("# op\tkey\tsize\tthreads\tops\tseconds\tcycles_op\tcycles_byte\tgbps\n");
+    for (o = 0; o < sizeof(ops) / sizeof(*ops); ++o) {
+        if (name != NULL ? strcmp(name, ops[o].name) : !ops[o].regress)
+            continue;
+        for (n = 0; n < REPEAT; ++n)
+            for (kernel = CamelliaKernelGeneric; kernel < KERNELS; ++kernel) {
+                if (!camelliaKernelSupported(kernel))
+                    continue;
+                if (camelliaKernelSelect(kernel) < 0)
+                    goto error;
+                printf("# kernel=%s\n", camelliaKernelName(kernel));
+                if (measure(&ops[o], type, size, 1, seconds, &sample[kernel][n]) < 0)
+                    goto error;
+            }
+        for (kernel = CamelliaKernelGeneric; kernel < KERNELS; ++kernel)
+            if (camelliaKernelSupported(kernel)) {
+                qsort(sample[kernel], REPEAT, sizeof(*sample[kernel]), compare);
+                median[kernel] = sample[kernel][REPEAT / 2];
+            }
+        for (kernel = CamelliaKernelGeneric; kernel < KERNELS; ++kernel)
+            if (camelliaKernelSupported(kernel) && median[CamelliaKernelGeneric] > 0) {
+                ratio[kernel][o] = median[kernel] / median[CamelliaKernelGeneric];
+                printf("# ratio: %s %s %.3f (median %.3f gbps, spread %.3f-%.3f)\n",
+                       camelliaKernelName(kernel), ops[o].name, ratio[kernel][o],
+                       median[kernel], sample[kernel][0], sample[kernel][REPEAT - 1] );
+            }
+    }
+    if (camelliaKernelSelect(CamelliaKernelAuto) < 0)
+        goto error;
+    best = camelliaKernelCurrent();
+    if (best < KERNELS)
+        for (o = 0; o < sizeof(ops) / sizeof(*ops); ++o)  /* 自動選択されるカーネルと汎用カーネルの比較 */
+            if (ratio[best][o] > 0 && ratio[best][o] < 1 - tol) {
+                printf("# slow: %s %s %.3f times %s\n", camelliaKernelName(best), ops[o].name, ratio[best][o],
+                       camelliaKernelName(CamelliaKernelGeneric) );
+                slow = 1;
+            }
+    if (base != NULL) {  /* 基準との比較 (基準にない, または今回測定していないカーネルと処理は無視する) */
+        file = fopen(base, "r");
+        if (file == NULL)
+            goto error;
+        while (fscanf(file, "%31s %31s %lf", kname, oname, &value) == 3)
+            for (kernel = CamelliaKernelGeneric; kernel < KERNELS; ++kernel) {
+                if (strcmp(kname, camelliaKernelName(kernel)))
+                    continue;
+                for (o = 0; o < sizeof(ops) / sizeof(*ops); ++o)
+                    if (!strcmp(oname, ops[o].name) && ratio[kernel][o] > 0 && ratio[kernel][o] < value * (1 - tol)) {
+                        printf("# slow: %s %s %.3f times generic < baseline %.3f\n", kname, oname, ratio[kernel][o], value);
+                        slow = 1;
+                    }
+            }
+        fclose(file), file = NULL;
+    }
+    if (record != NULL) {
+        file = fopen(record, "w");
+        if (file == NULL)
+            goto error;
+        for (kernel = CamelliaKernelGeneric; kernel < KERNELS; ++kernel)
+            for (o = 0; o < sizeof(ops) / sizeof(*ops); ++o)
+                if (ratio[kernel][o] > 0)
+                    fprintf(file, "%s %s %.3f\n", camelliaKernelName(kernel), ops[o].name, ratio[kernel][o]);
+        if (fclose(file) != 0) {
+            file = NULL;
+            goto error;
+        }
+        file = NULL;
+    }
+    if (slow)
+        goto error;
+    status = 0;
+error:
+    if (file != NULL)
+        fclose(file);
+    return status;
+}
+
+int main(int argc, char *argv[]) {
+    const CamelliaKeytype types[] = {Camellia128Encrypt, Camellia192Encrypt, Camellia256Encrypt};
+    int maxThreads = 0;
+    size_t maxSize = 0;
+    double seconds = 0.1;
+    const char *name = NULL;
+    int bits = 0;
+    int perKernel = 0;
+    const char *record = NULL, *base = NULL;
+    double tol = 0.3;
+    size_t size;
+    int nthreads;
+    size_t o, k;
+    int opt;
+    int status = -1;
+
+    while ((opt = getopt(argc, argv, "t:m:s:o:b:kw:c:x:")) != -1)
+        switch (opt) {
+        case 't':
+            maxThreads = atoi(optarg);
+            break;
+        case 'm':
+            maxSize = strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            seconds = atof(optarg);
+            break;
+        case 'o':
+            name = optarg;
+            break;
+        case 'b':
+            bits = atoi(optarg);
+            break;
+        case 'k':
+            perKernel = 1;
+            break;
+        case 'w':
+            record = optarg;
+            break;
+        case 'c':
+            base = optarg;
+            break;
+        case 'x':
+            tol = atof(optarg);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-t threads] [-m maxsize] [-s seconds] [-o op] [-b bits]\n"
+                            "       %s -k [-m size] [-s seconds] [-o op] [-b bits] [-w record] [-c baseline] [-x tolerance]\n",
+                    argv[0], argv[0] );
+            goto error;
+        }
+    if (perKernel) {
+        for (k = sizeof(types) / sizeof(*types) - 1; k > 0; --k)
+            if (bits == (int)(128 + k * 64))
+                break;
+        if (regress(name, types[k], maxSize > 0 ? maxSize : (size_t)64 << 10, seconds, record, base, tol) < 0)
+            goto error;
+        status = 0;
+        goto error;
+    }
+    if (maxSize == 0)
+        maxSize = (size_t)64 << 20;
+    if (maxThreads <= 0)
+        maxThreads = sysconf(_SC_NPROCESSORS_ONLN) > 0 ? sysconf(_SC_NPROCESSORS_ONLN) : 1;
+    printf("# kernel=%s threads=%d maxsize=%zu seconds=%g\n",
+           camelliaKernelName(camelliaKernelCurrent()), maxThreads, maxSize, seconds );
+    printf("# op\tkey\tsize\tthreads\tops\tseconds\tcycles_op\tcycles_byte\tgbps\n");
+    for (o = 0; o < sizeof(ops) / sizeof(*ops); ++o) {
+        if (name != NULL && strcmp(name, ops[o].name))
+            continue;
+        for (k = 0; k < sizeof(types) / sizeof(*types); ++k) {
+            if (bits != 0 && bits != (int)(128 + k * 64))
+                continue;
+            for (nthreads = 1; ; nthreads = nthreads * 2 < maxThreads ? nthreads * 2 : maxThreads) {
+                if (ops[o].run == runKeysche) {
+                    if (measure(&ops[o], types[k], 0, nthreads, seconds, NULL) < 0)
+                        goto error;
+                }
+                else
+                    for (size = 16; size <= maxSize; size *= 4)
+                        if (measure(&ops[o], types[k], size, nthreads, seconds, NULL) < 0)
+                            goto error;
+                if (nthreads >= maxThreads)
+                    break;
+            }
+        }
+    }
+    status = 0;
+error:
+    return status < 0 ? 1 : 0;
+}
@@ -1,4 +1,4 @@
-/* camellia.c - Last modified: 31-Jul-2021 (kobayasy)
+/* camellia.c - Last modified: 16-Oct-2026 (kobayasy)
  * The Camellia Encryption Algorithm (RFC 3713).
  *
  * Copyright (c) 2021 by Yuichi Kobayashi <kobayasy@kobayasy.com>
@@ -26,51 +26,34 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include "camellia.h"
+#include "camellia_kernel.h"
 
 #ifndef ASSERT
 #include <assert.h>
 #define ASSERT(_test) assert(_test)
 #endif  /* #ifndef ASSERT */
 
-#if 0  // インライン展開の判断をコンパイラに任せるなら1
-#define inline static
-#endif  /* #if 0  // インライン展開の判断をコンパイラに任せるなら1 */
-
-#if 0  // 変数のレジスタ割り当て判断をコンパイラに任せるなら1
-#define register /* 定義なし */
-#endif  /* #if 0  // 変数のレジスタ割り当て判断をコンパイラに任せるなら1 */
-
-/* ビッグエンディアン(ネットワークバイトオーダー)の8バイトデータを変換 */
-#define n8u64(_n64) \
-    ((uint64_t)((uint8_t *)(_n64))[0] << 56 | \
-     (uint64_t)((uint8_t *)(_n64))[1] << 48 | \
-     (uint64_t)((uint8_t *)(_n64))[2] << 40 | \
-     (uint64_t)((uint8_t *)(_n64))[3] << 32 | \
-     (uint64_t)((uint8_t *)(_n64))[4] << 24 | \
-     (uint64_t)((uint8_t *)(_n64))[5] << 16 | \
-     (uint64_t)((uint8_t *)(_n64))[6] <<  8 | \
-     (uint64_t)((uint8_t *)(_n64))[7] <<  0 )
-
-/* ビッグエンディアン(ネットワークバイトオーダー)の8バイトデータに変換 */
-#define u8n64_set(_u64, _n64) \
-    do { \
-        ((uint8_t *)(_n64))[0] = (uint8_t)((uint64_t)(_u64) >> 56); \
-        ((uint8_t *)(_n64))[1] = (uint8_t)((uint64_t)(_u64) >> 48); \
-        ((uint8_t *)(_n64))[2] = (uint8_t)((uint64_t)(_u64) >> 40); \
-        ((uint8_t *)(_n64))[3] = (uint8_t)((uint64_t)(_u64) >> 32); \
-        ((uint8_t *)(_n64))[4] = (uint8_t)((uint64_t)(_u64) >> 24); \
-        ((uint8_t *)(_n64))[5] = (uint8_t)((uint64_t)(_u64) >> 16); \
-        ((uint8_t *)(_n64))[6] = (uint8_t)((uint64_t)(_u64) >>  8); \
-        ((uint8_t *)(_n64))[7] = (uint8_t)((uint64_t)(_u64) >>  0); \
-    } while (0)
+#ifndef SPTABLE  // F関数に32ビットSPテーブル(4KB)を使うなら1, S-boxテーブル(1KB)のみ使うなら0
+#define SPTABLE 1
+#endif  /* #ifndef SPTABLE */
+
+#if defined(__GNUC__)  // ラウンド処理の関数はインライン展開を強制し, グループのループは展開する
+#define FORCE_INLINE __inline__ __attribute__((always_inline))
+#define UNROLL _Pragma("GCC unroll 4")
+#else  /* #if defined(__GNUC__) */
+#define FORCE_INLINE /* 定義なし */
+#define UNROLL /* 定義なし */
+#endif  /* #if defined(__GNUC__) */
 
 /* 64ビット変数値スワップ
  * uint64_t _n1, _n2: 値を入れ替える変数
  */
 #define s64(_n1, _n2) \
     do { \
-        register uint64_t d; \
+        uint64_t d; \
         d = (_n1), (_n1) = (_n2), (_n2) = d; \
     } while (0)
 
@@ -79,7 +62,7 @@
  * bit: 回転ビット数
  * 戻り値: dataIn を bit 数分左回転した値
  */
-inline uint8_t r8(uint8_t dataIn, uint8_t bit) {
+static inline uint8_t r8(uint8_t dataIn, uint8_t bit) {
     uint8_t dataOut;
     uint8_t bit1, bit2;
 
@@ -93,7 +76,7 @@ inline uint8_t r8(uint8_t dataIn, uint8_t bit) {
  * bit: 回転ビット数
  * 戻り値: dataIn を bit 数分左回転した値
  */
-inline uint32_t r32(uint32_t dataIn, uint8_t bit) {
+static inline uint32_t r32(uint32_t dataIn, uint8_t bit) {
     uint32_t dataOut;
     uint32_t bit1, bit2;
 
@@ -144,6 +127,9 @@ static void r128(const uint64_t *dataIn, uint8_t bit,
 static const struct {
     uint64_t sigma1, sigma2, sigma3, sigma4, sigma5, sigma6;
     uint8_t sbox1[256], sbox2[256], sbox3[256], sbox4[256];
+#if SPTABLE
+    uint32_t sp1110[256], sp0222[256], sp3033[256], sp4404[256];
+#endif  /* #if SPTABLE */
 } camellia = {
     .sigma1 = 0xa09e667f3bcc908b,
     .sigma2 = 0xb67ae8584caa73b2,
@@ -222,12 +208,172 @@ static const struct {
          92,   2,  74,  51, 103, 243, 127, 226, 155,  38,  55,  59, 150,  75, 190,  46,
         121, 140, 110, 142, 245, 182, 253,  89, 152, 106,  70, 186,  37,  66, 162, 250,
           7,  85, 238,  10,  73, 104,  56, 164,  40, 123, 201, 193, 227, 244, 199, 158
+    },
+#if SPTABLE
+    .sp1110 = {
+        0x70707000, 0x82828200, 0x2c2c2c00, 0xececec00, 0xb3b3b300, 0x27272700, 0xc0c0c000, 0xe5e5e500,
+        0xe4e4e400, 0x85858500, 0x57575700, 0x35353500, 0xeaeaea00, 0x0c0c0c00, 0xaeaeae00, 0x41414100,
+        0x23232300, 0xefefef00, 0x6b6b6b00, 0x93939300, 0x45454500, 0x19191900, 0xa5a5a500, 0x21212100,
+        0xededed00, 0x0e0e0e00, 0x4f4f4f00, 0x4e4e4e00, 0x1d1d1d00, 0x65656500, 0x92929200, 0xbdbdbd00,
+        0x86868600, 0xb8b8b800, 0xafafaf00, 0x8f8f8f00, 0x7c7c7c00, 0xebebeb00, 0x1f1f1f00, 0xcecece00,
+        0x3e3e3e00, 0x30303000, 0xdcdcdc00, 0x5f5f5f00, 0x5e5e5e00, 0xc5c5c500, 0x0b0b0b00, 0x1a1a1a00,
+        0xa6a6a600, 0xe1e1e100, 0x39393900, 0xcacaca00, 0xd5d5d500, 0x47474700, 0x5d5d5d00, 0x3d3d3d00,
+        0xd9d9d900, 0x01010100, 0x5a5a5a00, 0xd6d6d600, 0x51515100, 0x56565600, 0x6c6c6c00, 0x4d4d4d00,
+        0x8b8b8b00, 0x0d0d0d00, 0x9a9a9a00, 0x66666600, 0xfbfbfb00, 0xcccccc00, 0xb0b0b000, 0x2d2d2d00,
+        0x74747400, 0x12121200, 0x2b2b2b00, 0x20202000, 0xf0f0f000, 0xb1b1b100, 0x84848400, 0x99999900,
+        0xdfdfdf00, 0x4c4c4c00, 0xcbcbcb00, 0xc2c2c200, 0x34343400, 0x7e7e7e00, 0x76767600, 0x05050500,
+        0x6d6d6d00, 0xb7b7b700, 0xa9a9a900, 0x31313100, 0xd1d1d100, 0x17171700, 0x04040400, 0xd7d7d700,
+        0x14141400, 0x58585800, 0x3a3a3a00, 0x61616100, 0xdedede00, 0x1b1b1b00, 0x11111100, 0x1c1c1c00,
+        0x32323200, 0x0f0f0f00, 0x9c9c9c00, 0x16161600, 0x53535300, 0x18181800, 0xf2f2f200, 0x22222200,
+        0xfefefe00, 0x44444400, 0xcfcfcf00, 0xb2b2b200, 0xc3c3c300, 0xb5b5b500, 0x7a7a7a00, 0x91919100,
+        0x24242400, 0x08080800, 0xe8e8e800, 0xa8a8a800, 0x60606000, 0xfcfcfc00, 0x69696900, 0x50505000,
+        0xaaaaaa00, 0xd0d0d000, 0xa0a0a000, 0x7d7d7d00, 0xa1a1a100, 0x89898900, 0x62626200, 0x97979700,
+        0x54545400, 0x5b5b5b00, 0x1e1e1e00, 0x95959500, 0xe0e0e000, 0xffffff00, 0x64646400, 0xd2d2d200,
+        0x10101000, 0xc4c4c400, 0x00000000, 0x48484800, 0xa3a3a300, 0xf7f7f700, 0x75757500, 0xdbdbdb00,
+        0x8a8a8a00, 0x03030300, 0xe6e6e600, 0xdadada00, 0x09090900, 0x3f3f3f00, 0xdddddd00, 0x94949400,
+        0x87878700, 0x5c5c5c00, 0x83838300, 0x02020200, 0xcdcdcd00, 0x4a4a4a00, 0x90909000, 0x33333300,
+        0x73737300, 0x67676700, 0xf6f6f600, 0xf3f3f300, 0x9d9d9d00, 0x7f7f7f00, 0xbfbfbf00, 0xe2e2e200,
+        0x52525200, 0x9b9b9b00, 0xd8d8d800, 0x26262600, 0xc8c8c800, 0x37373700, 0xc6c6c600, 0x3b3b3b00,
+        0x81818100, 0x96969600, 0x6f6f6f00, 0x4b4b4b00, 0x13131300, 0xbebebe00, 0x63636300, 0x2e2e2e00,
+        0xe9e9e900, 0x79797900, 0xa7a7a700, 0x8c8c8c00, 0x9f9f9f00, 0x6e6e6e00, 0xbcbcbc00, 0x8e8e8e00,
+        0x29292900, 0xf5f5f500, 0xf9f9f900, 0xb6b6b600, 0x2f2f2f00, 0xfdfdfd00, 0xb4b4b400, 0x59595900,
+        0x78787800, 0x98989800, 0x06060600, 0x6a6a6a00, 0xe7e7e700, 0x46464600, 0x71717100, 0xbababa00,
+        0xd4d4d400, 0x25252500, 0xababab00, 0x42424200, 0x88888800, 0xa2a2a200, 0x8d8d8d00, 0xfafafa00,
+        0x72727200, 0x07070700, 0xb9b9b900, 0x55555500, 0xf8f8f800, 0xeeeeee00, 0xacacac00, 0x0a0a0a00,
+        0x36363600, 0x49494900, 0x2a2a2a00, 0x68686800, 0x3c3c3c00, 0x38383800, 0xf1f1f100, 0xa4a4a400,
+        0x40404000, 0x28282800, 0xd3d3d300, 0x7b7b7b00, 0xbbbbbb00, 0xc9c9c900, 0x43434300, 0xc1c1c100,
+        0x15151500, 0xe3e3e300, 0xadadad00, 0xf4f4f400, 0x77777700, 0xc7c7c700, 0x80808000, 0x9e9e9e00
+    },
+    .sp0222 = {
+        0x00e0e0e0, 0x00050505, 0x00585858, 0x00d9d9d9, 0x00676767, 0x004e4e4e, 0x00818181, 0x00cbcbcb,
+        0x00c9c9c9, 0x000b0b0b, 0x00aeaeae, 0x006a6a6a, 0x00d5d5d5, 0x00181818, 0x005d5d5d, 0x00828282,
+        0x00464646, 0x00dfdfdf, 0x00d6d6d6, 0x00272727, 0x008a8a8a, 0x00323232, 0x004b4b4b, 0x00424242,
+        0x00dbdbdb, 0x001c1c1c, 0x009e9e9e, 0x009c9c9c, 0x003a3a3a, 0x00cacaca, 0x00252525, 0x007b7b7b,
+        0x000d0d0d, 0x00717171, 0x005f5f5f, 0x001f1f1f, 0x00f8f8f8, 0x00d7d7d7, 0x003e3e3e, 0x009d9d9d,
+        0x007c7c7c, 0x00606060, 0x00b9b9b9, 0x00bebebe, 0x00bcbcbc, 0x008b8b8b, 0x00161616, 0x00343434,
+        0x004d4d4d, 0x00c3c3c3, 0x00727272, 0x00959595, 0x00ababab, 0x008e8e8e, 0x00bababa, 0x007a7a7a,
+        0x00b3b3b3, 0x00020202, 0x00b4b4b4, 0x00adadad, 0x00a2a2a2, 0x00acacac, 0x00d8d8d8, 0x009a9a9a,
+        0x00171717, 0x001a1a1a, 0x00353535, 0x00cccccc, 0x00f7f7f7, 0x00999999, 0x00616161, 0x005a5a5a,
+        0x00e8e8e8, 0x00242424, 0x00565656, 0x00404040, 0x00e1e1e1, 0x00636363, 0x00090909, 0x00333333,
+        0x00bfbfbf, 0x00989898, 0x00979797, 0x00858585, 0x00686868, 0x00fcfcfc, 0x00ececec, 0x000a0a0a,
+        0x00dadada, 0x006f6f6f, 0x00535353, 0x00626262, 0x00a3a3a3, 0x002e2e2e, 0x00080808, 0x00afafaf,
+        0x00282828, 0x00b0b0b0, 0x00747474, 0x00c2c2c2, 0x00bdbdbd, 0x00363636, 0x00222222, 0x00383838,
+        0x00646464, 0x001e1e1e, 0x00393939, 0x002c2c2c, 0x00a6a6a6, 0x00303030, 0x00e5e5e5, 0x00444444,
+        0x00fdfdfd, 0x00888888, 0x009f9f9f, 0x00656565, 0x00878787, 0x006b6b6b, 0x00f4f4f4, 0x00232323,
+        0x00484848, 0x00101010, 0x00d1d1d1, 0x00515151, 0x00c0c0c0, 0x00f9f9f9, 0x00d2d2d2, 0x00a0a0a0,
+        0x00555555, 0x00a1a1a1, 0x00414141, 0x00fafafa, 0x00434343, 0x00131313, 0x00c4c4c4, 0x002f2f2f,
+        0x00a8a8a8, 0x00b6b6b6, 0x003c3c3c, 0x002b2b2b, 0x00c1c1c1, 0x00ffffff, 0x00c8c8c8, 0x00a5a5a5,
+        0x00202020, 0x00898989, 0x00000000, 0x00909090, 0x00474747, 0x00efefef, 0x00eaeaea, 0x00b7b7b7,
+        0x00151515, 0x00060606, 0x00cdcdcd, 0x00b5b5b5, 0x00121212, 0x007e7e7e, 0x00bbbbbb, 0x00292929,
+        0x000f0f0f, 0x00b8b8b8, 0x00070707, 0x00040404, 0x009b9b9b, 0x00949494, 0x00212121, 0x00666666,
+        0x00e6e6e6, 0x00cecece, 0x00ededed, 0x00e7e7e7, 0x003b3b3b, 0x00fefefe, 0x007f7f7f, 0x00c5c5c5,
+        0x00a4a4a4, 0x00373737, 0x00b1b1b1, 0x004c4c4c, 0x00919191, 0x006e6e6e, 0x008d8d8d, 0x00767676,
+        0x00030303, 0x002d2d2d, 0x00dedede, 0x00969696, 0x00262626, 0x007d7d7d, 0x00c6c6c6, 0x005c5c5c,
+        0x00d3d3d3, 0x00f2f2f2, 0x004f4f4f, 0x00191919, 0x003f3f3f, 0x00dcdcdc, 0x00797979, 0x001d1d1d,
+        0x00525252, 0x00ebebeb, 0x00f3f3f3, 0x006d6d6d, 0x005e5e5e, 0x00fbfbfb, 0x00696969, 0x00b2b2b2,
+        0x00f0f0f0, 0x00313131, 0x000c0c0c, 0x00d4d4d4, 0x00cfcfcf, 0x008c8c8c, 0x00e2e2e2, 0x00757575,
+        0x00a9a9a9, 0x004a4a4a, 0x00575757, 0x00848484, 0x00111111, 0x00454545, 0x001b1b1b, 0x00f5f5f5,
+        0x00e4e4e4, 0x000e0e0e, 0x00737373, 0x00aaaaaa, 0x00f1f1f1, 0x00dddddd, 0x00595959, 0x00141414,
+        0x006c6c6c, 0x00929292, 0x00545454, 0x00d0d0d0, 0x00787878, 0x00707070, 0x00e3e3e3, 0x00494949,
+        0x00808080, 0x00505050, 0x00a7a7a7, 0x00f6f6f6, 0x00777777, 0x00939393, 0x00868686, 0x00838383,
+        0x002a2a2a, 0x00c7c7c7, 0x005b5b5b, 0x00e9e9e9, 0x00eeeeee, 0x008f8f8f, 0x00010101, 0x003d3d3d
+    },
+    .sp3033 = {
+        0x38003838, 0x41004141, 0x16001616, 0x76007676, 0xd900d9d9, 0x93009393, 0x60006060, 0xf200f2f2,
+        0x72007272, 0xc200c2c2, 0xab00abab, 0x9a009a9a, 0x75007575, 0x06000606, 0x57005757, 0xa000a0a0,
+        0x91009191, 0xf700f7f7, 0xb500b5b5, 0xc900c9c9, 0xa200a2a2, 0x8c008c8c, 0xd200d2d2, 0x90009090,
+        0xf600f6f6, 0x07000707, 0xa700a7a7, 0x27002727, 0x8e008e8e, 0xb200b2b2, 0x49004949, 0xde00dede,
+        0x43004343, 0x5c005c5c, 0xd700d7d7, 0xc700c7c7, 0x3e003e3e, 0xf500f5f5, 0x8f008f8f, 0x67006767,
+        0x1f001f1f, 0x18001818, 0x6e006e6e, 0xaf00afaf, 0x2f002f2f, 0xe200e2e2, 0x85008585, 0x0d000d0d,
+        0x53005353, 0xf000f0f0, 0x9c009c9c, 0x65006565, 0xea00eaea, 0xa300a3a3, 0xae00aeae, 0x9e009e9e,
+        0xec00ecec, 0x80008080, 0x2d002d2d, 0x6b006b6b, 0xa800a8a8, 0x2b002b2b, 0x36003636, 0xa600a6a6,
+        0xc500c5c5, 0x86008686, 0x4d004d4d, 0x33003333, 0xfd00fdfd, 0x66006666, 0x58005858, 0x96009696,
+        0x3a003a3a, 0x09000909, 0x95009595, 0x10001010, 0x78007878, 0xd800d8d8, 0x42004242, 0xcc00cccc,
+        0xef00efef, 0x26002626, 0xe500e5e5, 0x61006161, 0x1a001a1a, 0x3f003f3f, 0x3b003b3b, 0x82008282,
+        0xb600b6b6, 0xdb00dbdb, 0xd400d4d4, 0x98009898, 0xe800e8e8, 0x8b008b8b, 0x02000202, 0xeb00ebeb,
+        0x0a000a0a, 0x2c002c2c, 0x1d001d1d, 0xb000b0b0, 0x6f006f6f, 0x8d008d8d, 0x88008888, 0x0e000e0e,
+        0x19001919, 0x87008787, 0x4e004e4e, 0x0b000b0b, 0xa900a9a9, 0x0c000c0c, 0x79007979, 0x11001111,
+        0x7f007f7f, 0x22002222, 0xe700e7e7, 0x59005959, 0xe100e1e1, 0xda00dada, 0x3d003d3d, 0xc800c8c8,
+        0x12001212, 0x04000404, 0x74007474, 0x54005454, 0x30003030, 0x7e007e7e, 0xb400b4b4, 0x28002828,
+        0x55005555, 0x68006868, 0x50005050, 0xbe00bebe, 0xd000d0d0, 0xc400c4c4, 0x31003131, 0xcb00cbcb,
+        0x2a002a2a, 0xad00adad, 0x0f000f0f, 0xca00caca, 0x70007070, 0xff00ffff, 0x32003232, 0x69006969,
+        0x08000808, 0x62006262, 0x00000000, 0x24002424, 0xd100d1d1, 0xfb00fbfb, 0xba00baba, 0xed00eded,
+        0x45004545, 0x81008181, 0x73007373, 0x6d006d6d, 0x84008484, 0x9f009f9f, 0xee00eeee, 0x4a004a4a,
+        0xc300c3c3, 0x2e002e2e, 0xc100c1c1, 0x01000101, 0xe600e6e6, 0x25002525, 0x48004848, 0x99009999,
+        0xb900b9b9, 0xb300b3b3, 0x7b007b7b, 0xf900f9f9, 0xce00cece, 0xbf00bfbf, 0xdf00dfdf, 0x71007171,
+        0x29002929, 0xcd00cdcd, 0x6c006c6c, 0x13001313, 0x64006464, 0x9b009b9b, 0x63006363, 0x9d009d9d,
+        0xc000c0c0, 0x4b004b4b, 0xb700b7b7, 0xa500a5a5, 0x89008989, 0x5f005f5f, 0xb100b1b1, 0x17001717,
+        0xf400f4f4, 0xbc00bcbc, 0xd300d3d3, 0x46004646, 0xcf00cfcf, 0x37003737, 0x5e005e5e, 0x47004747,
+        0x94009494, 0xfa00fafa, 0xfc00fcfc, 0x5b005b5b, 0x97009797, 0xfe00fefe, 0x5a005a5a, 0xac00acac,
+        0x3c003c3c, 0x4c004c4c, 0x03000303, 0x35003535, 0xf300f3f3, 0x23002323, 0xb800b8b8, 0x5d005d5d,
+        0x6a006a6a, 0x92009292, 0xd500d5d5, 0x21002121, 0x44004444, 0x51005151, 0xc600c6c6, 0x7d007d7d,
+        0x39003939, 0x83008383, 0xdc00dcdc, 0xaa00aaaa, 0x7c007c7c, 0x77007777, 0x56005656, 0x05000505,
+        0x1b001b1b, 0xa400a4a4, 0x15001515, 0x34003434, 0x1e001e1e, 0x1c001c1c, 0xf800f8f8, 0x52005252,
+        0x20002020, 0x14001414, 0xe900e9e9, 0xbd00bdbd, 0xdd00dddd, 0xe400e4e4, 0xa100a1a1, 0xe000e0e0,
+        0x8a008a8a, 0xf100f1f1, 0xd600d6d6, 0x7a007a7a, 0xbb00bbbb, 0xe300e3e3, 0x40004040, 0x4f004f4f
+    },
+    .sp4404 = {
+        0x70700070, 0x2c2c002c, 0xb3b300b3, 0xc0c000c0, 0xe4e400e4, 0x57570057, 0xeaea00ea, 0xaeae00ae,
+        0x23230023, 0x6b6b006b, 0x45450045, 0xa5a500a5, 0xeded00ed, 0x4f4f004f, 0x1d1d001d, 0x92920092,
+        0x86860086, 0xafaf00af, 0x7c7c007c, 0x1f1f001f, 0x3e3e003e, 0xdcdc00dc, 0x5e5e005e, 0x0b0b000b,
+        0xa6a600a6, 0x39390039, 0xd5d500d5, 0x5d5d005d, 0xd9d900d9, 0x5a5a005a, 0x51510051, 0x6c6c006c,
+        0x8b8b008b, 0x9a9a009a, 0xfbfb00fb, 0xb0b000b0, 0x74740074, 0x2b2b002b, 0xf0f000f0, 0x84840084,
+        0xdfdf00df, 0xcbcb00cb, 0x34340034, 0x76760076, 0x6d6d006d, 0xa9a900a9, 0xd1d100d1, 0x04040004,
+        0x14140014, 0x3a3a003a, 0xdede00de, 0x11110011, 0x32320032, 0x9c9c009c, 0x53530053, 0xf2f200f2,
+        0xfefe00fe, 0xcfcf00cf, 0xc3c300c3, 0x7a7a007a, 0x24240024, 0xe8e800e8, 0x60600060, 0x69690069,
+        0xaaaa00aa, 0xa0a000a0, 0xa1a100a1, 0x62620062, 0x54540054, 0x1e1e001e, 0xe0e000e0, 0x64640064,
+        0x10100010, 0x00000000, 0xa3a300a3, 0x75750075, 0x8a8a008a, 0xe6e600e6, 0x09090009, 0xdddd00dd,
+        0x87870087, 0x83830083, 0xcdcd00cd, 0x90900090, 0x73730073, 0xf6f600f6, 0x9d9d009d, 0xbfbf00bf,
+        0x52520052, 0xd8d800d8, 0xc8c800c8, 0xc6c600c6, 0x81810081, 0x6f6f006f, 0x13130013, 0x63630063,
+        0xe9e900e9, 0xa7a700a7, 0x9f9f009f, 0xbcbc00bc, 0x29290029, 0xf9f900f9, 0x2f2f002f, 0xb4b400b4,
+        0x78780078, 0x06060006, 0xe7e700e7, 0x71710071, 0xd4d400d4, 0xabab00ab, 0x88880088, 0x8d8d008d,
+        0x72720072, 0xb9b900b9, 0xf8f800f8, 0xacac00ac, 0x36360036, 0x2a2a002a, 0x3c3c003c, 0xf1f100f1,
+        0x40400040, 0xd3d300d3, 0xbbbb00bb, 0x43430043, 0x15150015, 0xadad00ad, 0x77770077, 0x80800080,
+        0x82820082, 0xecec00ec, 0x27270027, 0xe5e500e5, 0x85850085, 0x35350035, 0x0c0c000c, 0x41410041,
+        0xefef00ef, 0x93930093, 0x19190019, 0x21210021, 0x0e0e000e, 0x4e4e004e, 0x65650065, 0xbdbd00bd,
+        0xb8b800b8, 0x8f8f008f, 0xebeb00eb, 0xcece00ce, 0x30300030, 0x5f5f005f, 0xc5c500c5, 0x1a1a001a,
+        0xe1e100e1, 0xcaca00ca, 0x47470047, 0x3d3d003d, 0x01010001, 0xd6d600d6, 0x56560056, 0x4d4d004d,
+        0x0d0d000d, 0x66660066, 0xcccc00cc, 0x2d2d002d, 0x12120012, 0x20200020, 0xb1b100b1, 0x99990099,
+        0x4c4c004c, 0xc2c200c2, 0x7e7e007e, 0x05050005, 0xb7b700b7, 0x31310031, 0x17170017, 0xd7d700d7,
+        0x58580058, 0x61610061, 0x1b1b001b, 0x1c1c001c, 0x0f0f000f, 0x16160016, 0x18180018, 0x22220022,
+        0x44440044, 0xb2b200b2, 0xb5b500b5, 0x91910091, 0x08080008, 0xa8a800a8, 0xfcfc00fc, 0x50500050,
+        0xd0d000d0, 0x7d7d007d, 0x89890089, 0x97970097, 0x5b5b005b, 0x95950095, 0xffff00ff, 0xd2d200d2,
+        0xc4c400c4, 0x48480048, 0xf7f700f7, 0xdbdb00db, 0x03030003, 0xdada00da, 0x3f3f003f, 0x94940094,
+        0x5c5c005c, 0x02020002, 0x4a4a004a, 0x33330033, 0x67670067, 0xf3f300f3, 0x7f7f007f, 0xe2e200e2,
+        0x9b9b009b, 0x26260026, 0x37370037, 0x3b3b003b, 0x96960096, 0x4b4b004b, 0xbebe00be, 0x2e2e002e,
+        0x79790079, 0x8c8c008c, 0x6e6e006e, 0x8e8e008e, 0xf5f500f5, 0xb6b600b6, 0xfdfd00fd, 0x59590059,
+        0x98980098, 0x6a6a006a, 0x46460046, 0xbaba00ba, 0x25250025, 0x42420042, 0xa2a200a2, 0xfafa00fa,
+        0x07070007, 0x55550055, 0xeeee00ee, 0x0a0a000a, 0x49490049, 0x68680068, 0x38380038, 0xa4a400a4,
+        0x28280028, 0x7b7b007b, 0xc9c900c9, 0xc1c100c1, 0xe3e300e3, 0xf4f400f4, 0xc7c700c7, 0x9e9e009e
     }
+#endif  /* #if SPTABLE */
 };
 
+#if SPTABLE
 /* RFC 3713 規定のF関数
+ * S関数とP関数を合成した32ビットSPテーブルで処理する
  */
-static uint64_t f(uint64_t fIn, uint64_t ke) {
+static FORCE_INLINE uint64_t f(uint64_t fIn, uint64_t ke) {
+    uint64_t fOut;
+    uint64_t x;
+    uint32_t x1, x2;
+    uint32_t z1, z2;
+
+    x = fIn ^ ke;
+    x1 = x >> 32, x2 = x;
+    z1 = camellia.sp1110[(uint8_t)(x1 >> 24)] ^ camellia.sp0222[(uint8_t)(x1 >> 16)] ^
+         camellia.sp3033[(uint8_t)(x1 >>  8)] ^ camellia.sp4404[(uint8_t)(x1 >>  0)];
+    z2 = camellia.sp1110[(uint8_t)(x2 >>  0)] ^ camellia.sp0222[(uint8_t)(x2 >> 24)] ^
+         camellia.sp3033[(uint8_t)(x2 >> 16)] ^ camellia.sp4404[(uint8_t)(x2 >>  8)];
+    z2 ^= z1;
+    z1 = z2 ^ r32(z1, 24);
+    fOut = (uint64_t)z2 << 32 | z1;
+    return fOut;
+}
+#else  /* #if SPTABLE */
+/* RFC 3713 規定のF関数
+ */
+static FORCE_INLINE uint64_t f(uint64_t fIn, uint64_t ke) {
     uint64_t fOut;
     uint64_t x;
     uint8_t t1, t2, t3, t4, t5, t6, t7, t8;
@@ -256,10 +402,11 @@ static uint64_t f(uint64_t fIn, uint64_t ke) {
            (uint64_t)y7 <<  8 | (uint64_t)y8 <<  0;
     return fOut;
 }
+#endif  /* #if SPTABLE */
 
 /* RFC 3713 規定のFL関数
  */
-static uint64_t fl(uint64_t flIn, uint64_t ke) {
+static FORCE_INLINE uint64_t fl(uint64_t flIn, uint64_t ke) {
     uint64_t flOut;
     uint32_t x1, x2;
     uint32_t k1, k2;
@@ -273,7 +420,7 @@ static uint64_t fl(uint64_t flIn, uint64_t ke) {
 
 /* RFC 3713 規定のFLINV関数
  */
-static uint64_t flinv(uint64_t flinvIn, uint64_t ke) {
+static FORCE_INLINE uint64_t flinv(uint64_t flinvIn, uint64_t ke) {
     uint64_t flinvOut;
     uint32_t y1, y2;
     uint32_t k1, k2;
@@ -285,31 +432,14 @@ static uint64_t flinv(uint64_t flinvIn, uint64_t ke) {
     return flinvOut;
 }
 
-/* RFC 3713 規定のキースケジューリング処理
- * type: 暗号/復号キー種別
- *  (Camellia128Encrypt, Camellia192Encrypt or Camellia256Encrypt)
+/* RFC 3713 規定の変数KL, KR の設定
+ * type: 暗号キー種別(確認済みであること)
  * k[n]: RFC 3713 規定の変数K
- *  (type=Camellia128Encrypt の場合 n=16, Camellia192Encrypt の場合 n=24, Camellia256Encrypt の場合 n=32)
- * data: 変換テーブル
- * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ * kl[2], kr[2]: RFC 3713 規定の変数KL, KR (上位64ビット, 下位64ビット)
  */
-int camelliaKeysche(CamelliaKeytype type, const uint8_t *k,
-                    CamelliaData *data ) {
-    int status = -1;
-    uint64_t kl[2], kr[2];
-    uint64_t d1, d2;
-    uint64_t ka[2], kb[2];
-
+static void keyload(CamelliaKeytype type, const uint8_t *k,
+                    uint64_t *kl, uint64_t *kr ) {
     switch (type) {
-    case Camellia128Encrypt:
-    case Camellia192Encrypt:
-    case Camellia256Encrypt:
-        break;
-    default:
-        goto error;
-    }
-    data->type = type;
-    switch (data->type) {
     case Camellia128Encrypt:
         kl[0] = n8u64(k +  0), kl[1] = n8u64(k +  8);
         kr[0] = 0, kr[1] = 0;
@@ -325,6 +455,17 @@ int camelliaKeysche(CamelliaKeytype type, const uint8_t *k,
     default:
         ASSERT(0);  /* never reached */
     }
+}
+
+/* RFC 3713 規定の変数KA, KB の生成
+ * kl[2], kr[2]: RFC 3713 規定の変数KL, KR
+ * ka[2]: RFC 3713 規定の変数KA
+ * kb[2]: RFC 3713 規定の変数KB (NULL=生成しない(128bit キー))
+ */
+static FORCE_INLINE void keygen(const uint64_t *kl, const uint64_t *kr,
+                                uint64_t *ka, uint64_t *kb ) {
+    uint64_t d1, d2;
+
     d1 = kl[0] ^ kr[0];
     d2 = kl[1] ^ kr[1];
     d2 ^= f(d1, camellia.sigma1); 
@@ -334,20 +475,24 @@ int camelliaKeysche(CamelliaKeytype type, const uint8_t *k,
     d2 ^= f(d1, camellia.sigma3); 
     d1 ^= f(d2, camellia.sigma4); 
     ka[0] = d1, ka[1] = d2;
-    switch (data->type) {
-    case Camellia128Encrypt:
-        break;
-    case Camellia192Encrypt:
-    case Camellia256Encrypt:
+    if (kb != NULL) {
         d1 = ka[0] ^ kr[0];
         d2 = ka[1] ^ kr[1];
         d2 ^= f(d1, camellia.sigma5); 
         d1 ^= f(d2, camellia.sigma6); 
         kb[0] = d1, kb[1] = d2;
-        break;
-    default:
-        ASSERT(0);  /* never reached */
     }
+}
+
+/* RFC 3713 規定の変数KL, KR, KA, KB からサブキーを生成
+ * type: 暗号キー種別(確認済みであること)
+ * kl[2], kr[2], ka[2], kb[2]: RFC 3713 規定の変数KL, KR, KA, KB (128bit キーは kr, kb 未使用)
+ * data: 変換テーブル
+ */
+static FORCE_INLINE void keyexpand(CamelliaKeytype type, const uint64_t *kl,
+                      const uint64_t *kr, const uint64_t *ka,
+                      const uint64_t *kb, CamelliaData *data ) {
+    data->type = type;
     switch (data->type) {
     case Camellia128Encrypt:
         r128(kl,   0, &data->kw1, &data->kw2);
@@ -364,6 +509,7 @@ int camelliaKeysche(CamelliaKeytype type, const uint8_t *k,
         r128(ka,  94, &data->k15, &data->k16);
         r128(kl, 111, &data->k17, &data->k18);
         r128(ka, 111, &data->kw3, &data->kw4);
+        memset(&data->ke5, 0, sizeof(*data->sk) * 8);  /* ke5, ke6, k19 ～ k24 は未使用 */
         break;
     case Camellia192Encrypt:
     case Camellia256Encrypt:
@@ -388,9 +534,6 @@ int camelliaKeysche(CamelliaKeytype type, const uint8_t *k,
     default:
         ASSERT(0);  /* never reached */
     }
-    status = 0;
-error:
-    return status;
 }
 
 /* 変換テーブルを暗号キーと復号キーに相互変換
@@ -399,6 +542,7 @@ error:
  */
 int camelliaKeyswap(CamelliaData *data) {
     int status = -1;
+    int n1, n2;
 
     switch (data->type) {
     case Camellia128Encrypt:
@@ -413,44 +557,8 @@ int camelliaKeyswap(CamelliaData *data) {
     }
     s64(data->kw1, data->kw3);
     s64(data->kw2, data->kw4);
-    switch (data->type) {
-    case Camellia128Encrypt:
-    case Camellia128Decrypt:
-        s64(data->k1,  data->k18);
-        s64(data->k2,  data->k17);
-        s64(data->k3,  data->k16);
-        s64(data->k4,  data->k15);
-        s64(data->k5,  data->k14);
-        s64(data->k6,  data->k13);
-        s64(data->k7,  data->k12);
-        s64(data->k8,  data->k11);
-        s64(data->k9,  data->k10);
-        s64(data->ke1, data->ke4);
-        s64(data->ke2, data->ke3);
-        break;
-    case Camellia192Encrypt:
-    case Camellia192Decrypt:
-    case Camellia256Encrypt:
-    case Camellia256Decrypt:
-        s64(data->k1,  data->k24);
-        s64(data->k2,  data->k23);
-        s64(data->k3,  data->k22);
-        s64(data->k4,  data->k21);
-        s64(data->k5,  data->k20);
-        s64(data->k6,  data->k19);
-        s64(data->k7,  data->k18);
-        s64(data->k8,  data->k17);
-        s64(data->k9,  data->k16);
-        s64(data->k10, data->k15);
-        s64(data->k11, data->k14);
-        s64(data->k12, data->k13);
-        s64(data->ke1, data->ke6);
-        s64(data->ke2, data->ke5);
-        s64(data->ke3, data->ke4);
-        break;
-    default:
-        ASSERT(0);  /* never reached */
-    }
+    for (n1 = 2, n2 = GROUPS(data) * 8 - 1; n1 < n2; ++n1, --n2)
+        s64(data->sk[n1], data->sk[n2]);
     switch (data->type) {
     case Camellia128Encrypt:
         data->type = Camellia128Decrypt;
@@ -478,6 +586,683 @@ error:
     return status;
 }
 
+/* 一括処理で並行させるブロック数 */
+#define BLOCKS 4
+
+/* RFC 3713 規定のデータランダム化処理(キー種別の確認なし)
+ * ラウンド数と変換方向を定数で渡してインライン展開し, 専用の関数を生成する
+ * m[16]: RFC 3713 規定の変数M
+ * sk[34]: サブキーの並び
+ * c[16]: RFC 3713 規定の変数C
+ * groups: 6ラウンド単位のグループ数
+ * inv: 0=順変換, 0以外=逆変換
+ */
+static FORCE_INLINE void walk(const uint8_t *m, const uint64_t *sk,
+                              uint8_t *c, int groups, int inv ) {
+    uint64_t d1, d2;
+    int g, i;
+
+    d1 = n8u64(m + 0) ^ sk[SKI(0, groups, inv)];
+    d2 = n8u64(m + 8) ^ sk[SKI(1, groups, inv)];
+    UNROLL
+    for (g = 0, i = 2; g < groups; ++g) {
+        if (g > 0) {
+            d1 = fl(d1, sk[SKI(i + 0, groups, inv)]);
+            d2 = flinv(d2, sk[SKI(i + 1, groups, inv)]);
+            i += 2;
+        }
+        d2 ^= f(d1, sk[SKI(i + 0, groups, inv)]);
+        d1 ^= f(d2, sk[SKI(i + 1, groups, inv)]);
+        d2 ^= f(d1, sk[SKI(i + 2, groups, inv)]);
+        d1 ^= f(d2, sk[SKI(i + 3, groups, inv)]);
+        d2 ^= f(d1, sk[SKI(i + 4, groups, inv)]);
+        d1 ^= f(d2, sk[SKI(i + 5, groups, inv)]);
+        i += 6;
+    }
+    d2 ^= sk[SKI(i + 0, groups, inv)];
+    d1 ^= sk[SKI(i + 1, groups, inv)];
+    u8n64_set(d2, c + 0);
+    u8n64_set(d1, c + 8);
+}
+
+/* F関数によるラウンド処理(BLOCKS ブロック並行)
+ * x[BLOCKS]: F関数の入力
+ * y[BLOCKS]: F関数の出力を排他的論理和する変数
+ * k: サブキー
+ */
+static FORCE_INLINE void fs(const uint64_t *x, uint64_t *y, uint64_t k) {
+    int n;
+
+    for (n = 0; n < BLOCKS; ++n)
+        y[n] ^= f(x[n], k);
+}
+
+/* FL関数とFLINV関数による処理(BLOCKS ブロック並行)
+ * d1[BLOCKS]: FL関数で変換する変数
+ * d2[BLOCKS]: FLINV関数で変換する変数
+ * ke1, ke2: サブキー
+ */
+static FORCE_INLINE void fls(uint64_t *d1, uint64_t *d2, uint64_t ke1, uint64_t ke2) {
+    int n;
+
+    for (n = 0; n < BLOCKS; ++n)
+        d1[n] = fl(d1[n], ke1), d2[n] = flinv(d2[n], ke2);
+}
+
+/* RFC 3713 規定のデータランダム化処理(BLOCKS ブロック並行, キー種別の確認なし)
+ * m[16*BLOCKS]: RFC 3713 規定の変数M の並び
+ * sk[34]: サブキーの並び
+ * c[16*BLOCKS]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * groups: 6ラウンド単位のグループ数
+ * inv: 0=順変換, 0以外=逆変換
+ */
+static FORCE_INLINE void walks(const uint8_t *m, const uint64_t *sk,
+                               uint8_t *c, int groups, int inv ) {
+    uint64_t d1[BLOCKS], d2[BLOCKS];
+    int g, i, n;
+
+    for (n = 0; n < BLOCKS; ++n) {
+        d1[n] = n8u64(m + n * 16 + 0) ^ sk[SKI(0, groups, inv)];
+        d2[n] = n8u64(m + n * 16 + 8) ^ sk[SKI(1, groups, inv)];
+    }
+    UNROLL
+    for (g = 0, i = 2; g < groups; ++g) {
+        if (g > 0) {
+            fls(d1, d2, sk[SKI(i + 0, groups, inv)], sk[SKI(i + 1, groups, inv)]);
+            i += 2;
+        }
+        fs(d1, d2, sk[SKI(i + 0, groups, inv)]);
+        fs(d2, d1, sk[SKI(i + 1, groups, inv)]);
+        fs(d1, d2, sk[SKI(i + 2, groups, inv)]);
+        fs(d2, d1, sk[SKI(i + 3, groups, inv)]);
+        fs(d1, d2, sk[SKI(i + 4, groups, inv)]);
+        fs(d2, d1, sk[SKI(i + 5, groups, inv)]);
+        i += 6;
+    }
+    for (n = 0; n < BLOCKS; ++n) {
+        u8n64_set(d2[n] ^ sk[SKI(i + 0, groups, inv)], c + n * 16 + 0);
+        u8n64_set(d1[n] ^ sk[SKI(i + 1, groups, inv)], c + n * 16 + 8);
+    }
+}
+
+/* RFC 3713 規定のデータランダム化処理(BLOCKS ブロック並行, ブロックごとに異なる変換テーブル, キー種別の確認なし)
+ * m[BLOCKS][16]: RFC 3713 規定の変数M
+ * data[BLOCKS]: 変換テーブル(全て groups が同じであること)
+ * c[BLOCKS][16]: RFC 3713 規定の変数C (m と同一領域も可)
+ * groups: 6ラウンド単位のグループ数
+ */
+static FORCE_INLINE void walksMulti(const uint8_t *const *m,
+                                    const CamelliaData *const *data,
+                                    uint8_t *const *c, int groups ) {
+    uint64_t d1[BLOCKS], d2[BLOCKS];
+    uint64_t k1[BLOCKS], k2[BLOCKS];
+    int g, i, n;
+
+    for (n = 0; n < BLOCKS; ++n) {
+        d1[n] = n8u64(m[n] + 0) ^ data[n]->sk[SKI(0, groups, 0)];
+        d2[n] = n8u64(m[n] + 8) ^ data[n]->sk[SKI(1, groups, 0)];
+    }
+    UNROLL
+    for (g = 0, i = 2; g < groups; ++g) {
+        if (g > 0) {
+            for (n = 0; n < BLOCKS; ++n) {
+                d1[n] = fl(d1[n], data[n]->sk[SKI(i + 0, groups, 0)]);
+                d2[n] = flinv(d2[n], data[n]->sk[SKI(i + 1, groups, 0)]);
+            }
+            i += 2;
+        }
+        for (; i < g * 8 + 8; i += 2) {
+            for (n = 0; n < BLOCKS; ++n)
+                k1[n] = data[n]->sk[SKI(i + 0, groups, 0)], k2[n] = data[n]->sk[SKI(i + 1, groups, 0)];
+            for (n = 0; n < BLOCKS; ++n)
+                d2[n] ^= f(d1[n], k1[n]);
+            for (n = 0; n < BLOCKS; ++n)
+                d1[n] ^= f(d2[n], k2[n]);
+        }
+    }
+    for (n = 0; n < BLOCKS; ++n) {
+        u8n64_set(d2[n] ^ data[n]->sk[SKI(i + 0, groups, 0)], c[n] + 0);
+        u8n64_set(d1[n] ^ data[n]->sk[SKI(i + 1, groups, 0)], c[n] + 8);
+    }
+}
+
+/* RFC 3713 規定のデータランダム化処理(2ブロック並行, 順変換のみ, キー種別の確認なし)
+ * 連鎖するブロックと独立したブロックを組にして, 連鎖の待ち時間にもう一方を処理する
+ * m1[16], m2[16]: RFC 3713 規定の変数M
+ * sk[34]: サブキーの並び
+ * c1[16], c2[16]: RFC 3713 規定の変数C (m1, m2 と同一領域も可)
+ * groups: 6ラウンド単位のグループ数
+ */
+static FORCE_INLINE void walkPair(const uint8_t *m1, const uint8_t *m2,
+                                  const uint64_t *sk,
+                                  uint8_t *c1, uint8_t *c2, int groups ) {
+    uint64_t a1, a2, b1, b2;
+    int g, i;
+
+    a1 = n8u64(m1 + 0) ^ sk[SKI(0, groups, 0)], b1 = n8u64(m2 + 0) ^ sk[SKI(0, groups, 0)];
+    a2 = n8u64(m1 + 8) ^ sk[SKI(1, groups, 0)], b2 = n8u64(m2 + 8) ^ sk[SKI(1, groups, 0)];
+    UNROLL
+    for (g = 0, i = 2; g < groups; ++g) {
+        if (g > 0) {
+            a1 = fl(a1, sk[SKI(i + 0, groups, 0)]), b1 = fl(b1, sk[SKI(i + 0, groups, 0)]);
+            a2 = flinv(a2, sk[SKI(i + 1, groups, 0)]), b2 = flinv(b2, sk[SKI(i + 1, groups, 0)]);
+            i += 2;
+        }
+        for (; i < g * 8 + 8; i += 2) {
+            a2 ^= f(a1, sk[SKI(i + 0, groups, 0)]), b2 ^= f(b1, sk[SKI(i + 0, groups, 0)]);
+            a1 ^= f(a2, sk[SKI(i + 1, groups, 0)]), b1 ^= f(b2, sk[SKI(i + 1, groups, 0)]);
+        }
+    }
+    u8n64_set(a2 ^ sk[SKI(i + 0, groups, 0)], c1 + 0);
+    u8n64_set(a1 ^ sk[SKI(i + 1, groups, 0)], c1 + 8);
+    u8n64_set(b2 ^ sk[SKI(i + 0, groups, 0)], c2 + 0);
+    u8n64_set(b1 ^ sk[SKI(i + 1, groups, 0)], c2 + 8);
+}
+
+/* RFC 3713 規定のデータランダム化処理(キー種別の確認なし)
+ * m[16]: RFC 3713 規定の変数M
+ * data: 変換テーブル
+ * c[16]: RFC 3713 規定の変数C
+ * inv: 0=順変換, 0以外=逆変換
+ */
+static void datarand(const uint8_t *m, const CamelliaData *data,
+                     uint8_t *c, int inv ) {
+    switch (GROUPS(data) * 2 + !!inv) {
+    case 3 * 2 + 0:
+        walk(m, data->sk, c, 3, 0);
+        break;
+    case 3 * 2 + 1:
+        walk(m, data->sk, c, 3, 1);
+        break;
+    case 4 * 2 + 0:
+        walk(m, data->sk, c, 4, 0);
+        break;
+    default:
+        walk(m, data->sk, c, 4, 1);
+        break;
+    }
+}
+
+/* RFC 3713 規定のデータランダム化処理(汎用カーネルの本体)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * sk[34]: サブキーの並び
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数
+ * groups: 6ラウンド単位のグループ数
+ * inv: 0=順変換, 0以外=逆変換
+ */
+static FORCE_INLINE void generic(const uint8_t *m, const uint64_t *sk,
+                                 uint8_t *c, size_t n, int groups, int inv ) {
+    while (n >= BLOCKS) {
+        walks(m, sk, c, groups, inv);
+        m += 16 * BLOCKS, c += 16 * BLOCKS, n -= BLOCKS;
+    }
+    while (n > 0) {
+        walk(m, sk, c, groups, inv);
+        m += 16, c += 16, --n;
+    }
+}
+
+/* RFC 3713 規定のデータランダム化処理(汎用カーネル, キー種別の確認なし)
+ * 18ラウンドと24ラウンド, 順変換と逆変換それぞれに専用の処理を展開する
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数
+ * inv: 0=順変換, 0以外=逆変換
+ */
+static void datarandGeneric(const uint8_t *m, const CamelliaData *data,
+                            uint8_t *c, size_t n, int inv ) {
+    switch (GROUPS(data) * 2 + !!inv) {
+    case 3 * 2 + 0:
+        generic(m, data->sk, c, n, 3, 0);
+        break;
+    case 3 * 2 + 1:
+        generic(m, data->sk, c, n, 3, 1);
+        break;
+    case 4 * 2 + 0:
+        generic(m, data->sk, c, n, 4, 0);
+        break;
+    default:
+        generic(m, data->sk, c, n, 4, 1);
+        break;
+    }
+}
+
+/* RFC 3713 規定の変数KA, KB の生成(汎用カーネル, BLOCKS キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数
+ */
+static void keygenGeneric(const uint8_t *kl, const uint8_t *kr,
+                          uint8_t *ka, uint8_t *kb, size_t n ) {
+    uint64_t l1[BLOCKS], l2[BLOCKS], r1[BLOCKS], r2[BLOCKS];
+    uint64_t d1[BLOCKS], d2[BLOCKS];
+    uint64_t l[2], r[2], a[2], b[2];
+    int i;
+
+    for (; n >= BLOCKS; n -= BLOCKS, kl += 16 * BLOCKS, kr += 16 * BLOCKS, ka += 16 * BLOCKS) {
+        for (i = 0; i < BLOCKS; ++i) {
+            l1[i] = n8u64(kl + 16 * i + 0), l2[i] = n8u64(kl + 16 * i + 8);
+            r1[i] = n8u64(kr + 16 * i + 0), r2[i] = n8u64(kr + 16 * i + 8);
+            d1[i] = l1[i] ^ r1[i], d2[i] = l2[i] ^ r2[i];
+        }
+        fs(d1, d2, camellia.sigma1);
+        fs(d2, d1, camellia.sigma2);
+        for (i = 0; i < BLOCKS; ++i)
+            d1[i] ^= l1[i], d2[i] ^= l2[i];
+        fs(d1, d2, camellia.sigma3);
+        fs(d2, d1, camellia.sigma4);
+        for (i = 0; i < BLOCKS; ++i) {
+            u8n64_set(d1[i], ka + 16 * i + 0);
+            u8n64_set(d2[i], ka + 16 * i + 8);
+            d1[i] ^= r1[i], d2[i] ^= r2[i];
+        }
+        if (kb != NULL) {
+            fs(d1, d2, camellia.sigma5);
+            fs(d2, d1, camellia.sigma6);
+            for (i = 0; i < BLOCKS; ++i) {
+                u8n64_set(d1[i], kb + 16 * i + 0);
+                u8n64_set(d2[i], kb + 16 * i + 8);
+            }
+            kb += 16 * BLOCKS;
+        }
+    }
+    for (; n > 0; --n, kl += 16, kr += 16, ka += 16) {
+        l[0] = n8u64(kl + 0), l[1] = n8u64(kl + 8);
+        r[0] = n8u64(kr + 0), r[1] = n8u64(kr + 8);
+        keygen(l, r, a, kb != NULL ? b : NULL);
+        u8n64_set(a[0], ka + 0);
+        u8n64_set(a[1], ka + 8);
+        if (kb != NULL) {
+            u8n64_set(b[0], kb + 0);
+            u8n64_set(b[1], kb + 8);
+            kb += 16;
+        }
+    }
+}
+
+/* 独立したブロック列のデータランダム化処理(汎用カーネル, 列ごとに異なる変換テーブル)
+ * BLOCKS 列ずつまとめて並行処理し, 端数は1列ずつ処理する
+ * m[n][16*blocks]: RFC 3713 規定の変数M の並び
+ * data[n]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[n][16*blocks]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[n][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列数
+ * blocks: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+static void multiGeneric(const uint8_t *const *m,
+                         const CamelliaData *const *data,
+                         uint8_t *const *c, uint8_t *const *iv,
+                         size_t n, size_t blocks, int groups ) {
+    uint8_t buf[BLOCKS][16];
+    const uint8_t *gm[BLOCKS];
+    uint8_t *gc[BLOCKS];
+    size_t o;
+    int i;
+
+    for (; n >= BLOCKS; n -= BLOCKS, m += BLOCKS, data += BLOCKS, c += BLOCKS) {
+        for (o = 0; o < 16 * blocks; o += 16) {
+            for (i = 0; i < BLOCKS; ++i) {
+                gm[i] = m[i] + o, gc[i] = c[i] + o;
+                if (iv != NULL)
+                    camelliaXor(buf[i], gm[i], iv[i], 16), gm[i] = buf[i];
+            }
+            if (groups == 3)
+                walksMulti(gm, data, gc, 3);
+            else
+                walksMulti(gm, data, gc, 4);
+            if (iv != NULL)
+                for (i = 0; i < BLOCKS; ++i)
+                    memcpy(iv[i], gc[i], 16);
+        }
+        if (iv != NULL)
+            iv += BLOCKS;
+    }
+    for (; n > 0; --n, ++m, ++data, ++c) {
+        for (o = 0; o < 16 * blocks; o += 16)
+            if (iv != NULL) {
+                camelliaXor(buf[0], *m + o, *iv, 16);
+                datarand(buf[0], *data, *c + o, 0);
+                memcpy(*iv, *c + o, 16);
+            }
+            else
+                datarand(*m + o, *data, *c + o, 0);
+        if (iv != NULL)
+            ++iv;
+    }
+}
+
+/* バイト列の排他的論理和
+ * out[len]: a ^ b (a または b と同一領域も可)
+ * a[len], b[len]: 入力
+ * len: バイト数
+ */
+void camelliaXor(uint8_t *out, const uint8_t *a, const uint8_t *b,
+                 size_t len ) {
+    uint64_t x, y;
+
+    while (len >= 8) {
+        memcpy(&x, a, 8), memcpy(&y, b, 8);
+        x ^= y;
+        memcpy(out, &x, 8);
+        out += 8, a += 8, b += 8, len -= 8;
+    }
+    while (len > 0)
+        *out++ = *a++ ^ *b++, --len;
+}
+
+/* 複数キー一括のキースケジューリング処理でまとめて処理するキー数 */
+#define KEYS_BATCH 64
+
+/* データランダム化処理のカーネル
+ * CamelliaKernel の値を添字とする
+ */
+static const struct {
+    const char *name;                   /* カーネル名 */
+    unsigned cpu;                       /* 必要な CPU 機能(CPU_* の論理和) */
+    size_t lanes;                       /* 並行処理するブロック数(2のべき乗) */
+    void (*datarand)(const uint8_t *m, const CamelliaData *data,
+                     uint8_t *c, size_t n, int inv );
+    void (*keygen)(const uint8_t *kl, const uint8_t *kr,
+                   uint8_t *ka, uint8_t *kb, size_t n );  /* lanes キー並行 */
+    void (*multi)(const uint8_t *const *m, const CamelliaData *const *data,
+                  uint8_t *const *c, uint8_t *const *iv,
+                  size_t n, int groups );  /* lanes 列並行(NULL=汎用カーネルで処理) */
+    CamelliaKernel fallback;            /* 端数ブロックを処理するカーネル */
+    int automatic;                      /* 0以外=自動選択の対象 */
+    int constant;                       /* 0以外=処理時間がデータとキーに依存しない
+                                         *  (fallback も依存しないカーネルに限り, 最後のカーネルは端数も自身で処理する,
+                                         *   NARROW_MAX 以下のブロック, 1ブロックの処理とキースケジューリングは8ブロック並行で処理する) */
+} kernels[] = {
+    [CamelliaKernelGeneric]      = {"generic",       0,          1,   datarandGeneric,              keygenGeneric,              NULL,                              CamelliaKernelGeneric, 1, 0},
+#if KERNEL_X86
+    [CamelliaKernelAesni]        = {"aesni",         CPU_AESNI,  16,  camelliaDatarandAesni,        camelliaKeygenAesni,        camelliaDatarandMultiAesni,        CamelliaKernelGeneric, 1, 0},
+    [CamelliaKernelVaes]         = {"vaes",          CPU_VAES,   32,  camelliaDatarandVaes,         camelliaKeygenVaes,         camelliaDatarandMultiVaes,         CamelliaKernelAesni,   1, 0},
+#else  /* #if KERNEL_X86 */  /* 名前のみ(datarand=NULL で利用不可) */
+    [CamelliaKernelAesni]        = {"aesni"},
+    [CamelliaKernelVaes]         = {"vaes"},
+#endif  /* #if KERNEL_X86 */
+    /* ビットスライスは端数の列とブロックを並行数の少ないビットスライスに渡し, 汎用カーネルには渡さない */
+    [CamelliaKernelBitslice]     = {"bitslice",      0,          64,  camelliaDatarandBitslice,     camelliaKeygenBitslice,     camelliaDatarandMultiBitslice,     CamelliaKernelGeneric, 0, 1},
+#if KERNEL_X86
+    [CamelliaKernelBitsliceSse2] = {"bitslice-sse2", CPU_SSE2,   128, camelliaDatarandBitsliceSse2, camelliaKeygenBitsliceSse2, camelliaDatarandMultiBitsliceSse2, CamelliaKernelBitslice, 0, 1},
+    [CamelliaKernelBitsliceAvx2] = {"bitslice-avx2", CPU_AVX2,   256, camelliaDatarandBitsliceAvx2, camelliaKeygenBitsliceAvx2, camelliaDatarandMultiBitsliceAvx2, CamelliaKernelBitsliceSse2, 0, 1},
+#else  /* #if KERNEL_X86 */  /* 名前のみ(datarand=NULL で利用不可) */
+    [CamelliaKernelBitsliceSse2] = {"bitslice-sse2"},
+    [CamelliaKernelBitsliceAvx2] = {"bitslice-avx2"},
+#endif  /* #if KERNEL_X86 */
+#if KERNEL_X86
+    [CamelliaKernelAvx512]       = {"avx512",        CPU_AVX512, 64,  camelliaDatarandAvx512,       camelliaKeygenAvx512,       camelliaDatarandMultiAvx512,       CamelliaKernelVaes,    1, 0},
+#else  /* #if KERNEL_X86 */  /* 名前のみ(datarand=NULL で利用不可) */
+    [CamelliaKernelAvx512]       = {"avx512"},
+#endif  /* #if KERNEL_X86 */
+};
+
+#if STATS  // 集計値はカーネル種別ごとに用意している
+typedef char statsKernels[sizeof(kernels) / sizeof(*kernels) <= CAMELLIA_STATS_KERNELS ? 1 : -1];
+#endif  /* #if STATS */
+
+/* ファイル内共有変数 */
+static CamelliaKernel kernelSelected = CamelliaKernelAuto;  /* 選択中のカーネル */
+static unsigned cpuProbed = 0;  /* CPU の対応機能 (CPU_PROBED | CPU_* の論理和, 0=未取得) */
+
+#define CPU_PROBED 0x80000000  /* cpuProbed 取得済み */
+
+#if defined(__GNUC__)
+#define kernelLoad() __atomic_load_n(&kernelSelected, __ATOMIC_ACQUIRE)
+#define kernelStore(_kernel) __atomic_store_n(&kernelSelected, (_kernel), __ATOMIC_RELEASE)
+#define cpuLoad() __atomic_load_n(&cpuProbed, __ATOMIC_ACQUIRE)
+#define cpuStore(_cpu) __atomic_store_n(&cpuProbed, (_cpu), __ATOMIC_RELEASE)
+#else  /* #if defined(__GNUC__) */
+#define kernelLoad() (kernelSelected)
+#define kernelStore(_kernel) (kernelSelected = (_kernel))
+#define cpuLoad() (cpuProbed)
+#define cpuStore(_cpu) (cpuProbed = (_cpu))
+#endif  /* #if defined(__GNUC__) */
+
+/* CPU の対応機能を取得(初回のみ CPUID で調べる)
+ * 複数スレッドから同時に初回呼び出しされた場合はそれぞれが調べ, 同じ値を格納する
+ * 戻り値: CPU_* の論理和
+ */
+unsigned camelliaCpu(void) {
+    unsigned cpu;
+
+    cpu = cpuLoad();
+    if (!(cpu & CPU_PROBED)) {
+        cpu = CPU_PROBED;
+#if KERNEL_X86
+        cpu |= camelliaCpuid();
+#endif  /* #if KERNEL_X86 */
+        cpuStore(cpu);
+    }
+    return cpu & ~CPU_PROBED;
+}
+
+/* カーネルがこのCPUで利用可能か調べる
+ * kernel: カーネル種別
+ * 戻り値: 0以外=利用可能, 0=利用不可
+ */
+int camelliaKernelSupported(CamelliaKernel kernel) {
+    int status = 0;
+
+    if (kernel <= CamelliaKernelAuto ||
+        kernel >= (CamelliaKernel)(sizeof(kernels) / sizeof(*kernels)) )
+        goto error;
+    if (kernels[kernel].datarand == NULL)
+        goto error;
+    if ((kernels[kernel].cpu & camelliaCpu()) != kernels[kernel].cpu)
+        goto error;
+    status = 1;
+error:
+    return status;
+}
+
+/* カーネルの名前を取得
+ * kernel: カーネル種別
+ * 戻り値: カーネル名 (未サポートな kernel の場合 NULL)
+ */
+const char *camelliaKernelName(CamelliaKernel kernel) {
+    const char *name = NULL;
+
+    if (kernel == CamelliaKernelAuto)
+        name = "auto";
+    else if (kernel > CamelliaKernelAuto &&
+             kernel < (CamelliaKernel)(sizeof(kernels) / sizeof(*kernels)) )
+        name = kernels[kernel].name;
+    return name;
+}
+
+/* 複数ブロック一括処理に使うカーネルを選択
+ * kernel: カーネル種別 (CamelliaKernelAuto=利用可能な最速のカーネル, ビットスライスは明示的な指定でのみ選択)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(このCPUで利用できない kernel を指定した)
+ */
+int camelliaKernelSelect(CamelliaKernel kernel) {
+    int status = -1;
+    CamelliaKernel n;
+
+    if (kernel == CamelliaKernelAuto) {
+        for (n = CamelliaKernelGeneric;
+             n < (CamelliaKernel)(sizeof(kernels) / sizeof(*kernels)); ++n )
+            if (kernels[n].automatic && camelliaKernelSupported(n))
+                kernel = n;
+    }
+    if (!camelliaKernelSupported(kernel))
+        goto error;
+    kernelStore(kernel);
+    status = 0;
+error:
+    return status;
+}
+
+/* 複数ブロック一括処理に使うカーネルを取得
+ * 初回は環境変数 CAMELLIA_KERNEL (カーネル名) で指定されたカーネル,
+ * 指定がなければ利用可能な最速のカーネルを選択する
+ * 戻り値: カーネル種別
+ */
+CamelliaKernel camelliaKernelCurrent(void) {
+    CamelliaKernel kernel;
+    const char *env;
+    CamelliaKernel n;
+
+    kernel = kernelLoad();
+    if (kernel == CamelliaKernelAuto) {
+        env = getenv("CAMELLIA_KERNEL");
+        if (env != NULL)
+            for (n = CamelliaKernelGeneric;
+                 n < (CamelliaKernel)(sizeof(kernels) / sizeof(*kernels)); ++n )
+                if (kernels[n].name != NULL && !strcmp(env, kernels[n].name))
+                    kernel = n;
+        if (camelliaKernelSelect(kernel) < 0)
+            camelliaKernelSelect(CamelliaKernelAuto);
+        kernel = kernelLoad();
+    }
+    return kernel;
+}
+
+/* RFC 3713 規定のキースケジューリング処理(選択中のカーネルで複数キー一括)
+ * type: 暗号キー種別(全キー共通)
+ *  (Camellia128Encrypt, Camellia192Encrypt or Camellia256Encrypt)
+ * k[len*n]: RFC 3713 規定の変数K の並び
+ *  (type=Camellia128Encrypt の場合 len=16, Camellia192Encrypt の場合 len=24, Camellia256Encrypt の場合 len=32)
+ * data[n]: 変換テーブルの並び
+ * n: キー数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaKeyscheBulk(CamelliaKeytype type, const uint8_t *k,
+                        CamelliaData *data, size_t n ) {
+    int status = -1;
+    uint8_t kl[16 * KEYS_BATCH], kr[16 * KEYS_BATCH];
+    uint8_t ka[16 * KEYS_BATCH], kb[16 * KEYS_BATCH];
+    uint64_t l[2], r[2], a[2], b[2];
+    CamelliaKernel kernel;
+    size_t len, nb, nk, i;
+
+    switch (type) {
+    case Camellia128Encrypt:
+        len = 16;
+        break;
+    case Camellia192Encrypt:
+        len = 24;
+        break;
+    case Camellia256Encrypt:
+        len = 32;
+        break;
+    default:
+        goto error;
+    }
+    STATS_ADD(keyscheBulk, 1);
+    STATS_ADD(keysche[(type - Camellia128Encrypt) / 2], n);
+    for (; n > 0; k += len * nb, data += nb, n -= nb) {
+        nb = n < KEYS_BATCH ? n : KEYS_BATCH;
+        for (i = 0; i < nb; ++i) {  /* KL, KR はビッグエンディアンのまま K から切り出す */
+            memcpy(kl + 16 * i, k + len * i, 16);
+            switch (type) {
+            case Camellia128Encrypt:
+                memset(kr + 16 * i, 0, 16);
+                break;
+            case Camellia192Encrypt:
+                memcpy(kr + 16 * i, k + len * i + 16, 8);
+                u8n64_set(~n8u64(kr + 16 * i), kr + 16 * i + 8);
+                break;
+            default:
+                memcpy(kr + 16 * i, k + len * i + 16, 16);
+            }
+        }
+        kernel = camelliaKernelCurrent();
+        for (i = 0; i < nb; i += nk) {
+            if (kernels[kernel].constant && nb - i <= NARROW_MAX) {
+                camelliaKeygenBitsliceNarrow(kl + 16 * i, kr + 16 * i, ka + 16 * i,
+                                             type == Camellia128Encrypt ? NULL : kb + 16 * i, nb - i );
+                break;
+            }
+            nk = kernels[kernel].constant && !kernels[kernels[kernel].fallback].constant ?
+                 nb - i : (nb - i) & ~(kernels[kernel].lanes - 1);
+            if (nk > 0)
+                kernels[kernel].keygen(kl + 16 * i, kr + 16 * i, ka + 16 * i,
+                                       type == Camellia128Encrypt ? NULL : kb + 16 * i, nk );
+            kernel = kernels[kernel].fallback;
+        }
+        for (i = 0; i < nb; ++i) {
+            l[0] = n8u64(kl + 16 * i + 0), l[1] = n8u64(kl + 16 * i + 8);
+            r[0] = n8u64(kr + 16 * i + 0), r[1] = n8u64(kr + 16 * i + 8);
+            a[0] = n8u64(ka + 16 * i + 0), a[1] = n8u64(ka + 16 * i + 8);
+            if (type != Camellia128Encrypt)
+                b[0] = n8u64(kb + 16 * i + 0), b[1] = n8u64(kb + 16 * i + 8);
+            keyexpand(type, l, r, a, b, &data[i]);
+        }
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* RFC 3713 規定のキースケジューリング処理
+ * 選択中のカーネルの処理時間がデータとキーに依存しない場合は KA, KB も8キー並行のビットスライスで生成する
+ * type: 暗号/復号キー種別
+ *  (Camellia128Encrypt, Camellia192Encrypt or Camellia256Encrypt)
+ * k[n]: RFC 3713 規定の変数K
+ *  (type=Camellia128Encrypt の場合 n=16, Camellia192Encrypt の場合 n=24, Camellia256Encrypt の場合 n=32)
+ * data: 変換テーブル
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaKeysche(CamelliaKeytype type, const uint8_t *k,
+                    CamelliaData *data ) {
+    int status = -1;
+    uint64_t kl[2], kr[2];
+    uint64_t ka[2], kb[2];
+    uint8_t l[16], r[16], a[16], b[16];
+    CamelliaKernel kernel;
+
+    switch (type) {
+    case Camellia128Encrypt:
+    case Camellia192Encrypt:
+    case Camellia256Encrypt:
+        break;
+    default:
+        goto error;
+    }
+    keyload(type, k, kl, kr);
+    kernel = camelliaKernelCurrent();
+    if (kernels[kernel].constant) {
+        u8n64_set(kl[0], l + 0);
+        u8n64_set(kl[1], l + 8);
+        u8n64_set(kr[0], r + 0);
+        u8n64_set(kr[1], r + 8);
+        camelliaKeygenBitsliceNarrow(l, r, a, type == Camellia128Encrypt ? NULL : b, 1);
+        ka[0] = n8u64(a + 0), ka[1] = n8u64(a + 8);
+        if (type != Camellia128Encrypt)
+            kb[0] = n8u64(b + 0), kb[1] = n8u64(b + 8);
+    }
+    else
+        keygen(kl, kr, ka, type == Camellia128Encrypt ? NULL : kb);
+    keyexpand(type, kl, kr, ka, kb, data);
+    STATS_ADD(keysche[(type - Camellia128Encrypt) / 2], 1);
+    status = 0;
+error:
+    return status;
+}
+
+/* RFC 3713 規定のデータランダム化処理(1ブロック, キー種別の確認なし)
+ * 選択中のカーネルの処理時間がデータとキーに依存しない場合は8ブロック並行のビットスライスで処理する
+ * m[16]: RFC 3713 規定の変数M
+ * data: 変換テーブル
+ * c[16]: RFC 3713 規定の変数C (m と同一領域も可)
+ * inv: 0=順変換, 0以外=逆変換
+ */
+static void single(const uint8_t *m, const CamelliaData *data,
+                   uint8_t *c, int inv ) {
+    CamelliaKernel kernel;
+
+    kernel = camelliaKernelCurrent();
+    if (kernels[kernel].constant)
+        camelliaDatarandBitsliceNarrow(m, data, c, 1, inv);
+    else
+        datarand(m, data, c, inv);
+}
+
 /* RFC 3713 規定のデータランダム化処理
  * m[16]: RFC 3713 規定の変数M
  * data: 変換テーブル
@@ -487,7 +1272,6 @@ error:
 int camelliaDatarand(const uint8_t *m, const CamelliaData *data,
                      uint8_t *c ) {
     int status = -1;
-    uint64_t d1, d2;
 
     switch (data->type) {
     case Camellia128Encrypt:
@@ -500,57 +1284,261 @@ int camelliaDatarand(const uint8_t *m, const CamelliaData *data,
     default:
         goto error;
     }
-    d1 = n8u64(m +  0);
-    d2 = n8u64(m +  8);
-    d1 ^= data->kw1;
-    d2 ^= data->kw2;
-    d2 ^= f(d1, data->k1);
-    d1 ^= f(d2, data->k2);
-    d2 ^= f(d1, data->k3);
-    d1 ^= f(d2, data->k4);
-    d2 ^= f(d1, data->k5);
-    d1 ^= f(d2, data->k6);
-    d1 = fl(d1, data->ke1);
-    d2 = flinv(d2, data->ke2);
-    d2 ^= f(d1, data->k7);
-    d1 ^= f(d2, data->k8);
-    d2 ^= f(d1, data->k9);
-    d1 ^= f(d2, data->k10);
-    d2 ^= f(d1, data->k11);
-    d1 ^= f(d2, data->k12);
-    d1 = fl(d1, data->ke3);
-    d2 = flinv(d2, data->ke4);
-    d2 ^= f(d1, data->k13);
-    d1 ^= f(d2, data->k14);
-    d2 ^= f(d1, data->k15);
-    d1 ^= f(d2, data->k16);
-    d2 ^= f(d1, data->k17);
-    d1 ^= f(d2, data->k18);
+    single(m, data, c, 0);
+    STATS_ADD(single, 1);
+    status = 0;
+error:
+    return status;
+}
+
+/* RFC 3713 規定のデータランダム化処理(選択中のカーネルで複数ブロック一括)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数
+ * inv: 0=順変換, 0以外=逆変換
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+static int bulk(const uint8_t *m, const CamelliaData *data,
+                uint8_t *c, size_t n, int inv ) {
+    int status = -1;
+    CamelliaKernel kernel;
+    size_t nk;
+#if STATS
+    uint64_t begin;
+    size_t blocks = n;
+#endif  /* #if STATS */
+
     switch (data->type) {
     case Camellia128Encrypt:
     case Camellia128Decrypt:
+    case Camellia192Encrypt:
+    case Camellia192Decrypt:
+    case Camellia256Encrypt:
+    case Camellia256Decrypt:
         break;
+    default:
+        goto error;
+    }
+#if STATS
+    begin = camelliaStatsBegin(n);
+#endif  /* #if STATS */
+    kernel = camelliaKernelCurrent();
+    while (n > 0) {
+        if (kernels[kernel].constant && n <= NARROW_MAX) {
+            camelliaDatarandBitsliceNarrow(m, data, c, n, inv);
+            STATS_ADD(kernelBytes[kernel], 16 * n);
+            break;
+        }
+        nk = kernels[kernel].constant && !kernels[kernels[kernel].fallback].constant ?
+             n : n & ~(kernels[kernel].lanes - 1);
+        if (nk > 0) {
+            kernels[kernel].datarand(m, data, c, nk, inv);
+            STATS_ADD(kernelBytes[kernel], 16 * nk);
+            m += 16 * nk, c += 16 * nk, n -= nk;
+        }
+        kernel = kernels[kernel].fallback;
+    }
+#if STATS
+    camelliaStatsEnd(begin, blocks);
+#endif  /* #if STATS */
+    status = 0;
+error:
+    return status;
+}
+
+/* 独立したブロック列のデータランダム化処理(選択中のカーネル, 列ごとに異なる変換テーブル)
+ * m[n][16*blocks]: RFC 3713 規定の変数M の並び
+ * data[n]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[n][16*blocks]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[n][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列数
+ * blocks: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+static void multi(const uint8_t *const *m, const CamelliaData *const *data,
+                  uint8_t *const *c, uint8_t *const *iv,
+                  size_t n, size_t blocks, int groups ) {
+    const uint8_t *pm[MULTI_LANES];
+    const CamelliaData *pdata[MULTI_LANES];
+    uint8_t *pc[MULTI_LANES];
+    uint8_t *piv[MULTI_LANES];
+    CamelliaKernel kernel;
+    size_t nk, i, j;
+
+    kernel = camelliaKernelCurrent();
+    if (kernels[kernel].constant)
+        for (; n > 0; n -= nk, m += nk, data += nk, c += nk) {
+            while (kernels[kernels[kernel].fallback].constant &&
+                   n <= kernels[kernels[kernel].fallback].lanes )  /* 列が少なければ並行数の少ないカーネルで埋める列を減らす */
+                kernel = kernels[kernel].fallback;
+            nk = n < kernels[kernel].lanes ? n : kernels[kernel].lanes;
+            for (i = 0; i < kernels[kernel].lanes; ++i) {  /* 端数の列は最後の列を重複させて埋める(同じ値を同じ領域に書くだけ) */
+                j = i < nk ? i : nk - 1;
+                pm[i] = m[j], pdata[i] = data[j], pc[i] = c[j], piv[i] = iv != NULL ? iv[j] : NULL;
+            }
+            kernels[kernel].multi(pm, pdata, pc, iv != NULL ? piv : NULL, blocks, groups);
+            STATS_ADD(kernelBytes[kernel], 16 * blocks * nk);
+            if (iv != NULL)
+                iv += nk;
+        }
+    else {
+        while (kernels[kernel].multi != NULL) {
+            for (; n >= kernels[kernel].lanes; n -= kernels[kernel].lanes) {
+                kernels[kernel].multi(m, data, c, iv, blocks, groups);
+                STATS_ADD(kernelBytes[kernel], 16 * blocks * kernels[kernel].lanes);
+                m += kernels[kernel].lanes, data += kernels[kernel].lanes, c += kernels[kernel].lanes;
+                if (iv != NULL)
+                    iv += kernels[kernel].lanes;
+            }
+            kernel = kernels[kernel].fallback;
+        }
+        multiGeneric(m, data, c, iv, n, blocks, groups);
+        STATS_ADD(kernelBytes[CamelliaKernelGeneric], 16 * blocks * n);
+    }
+}
+
+/* 独立したブロック列のデータランダム化処理(列ごとに異なる変換テーブル, キー種別の確認なし)
+ * ラウンド数が同じ列を MULTI_LANES 列ずつまとめ, 選択中のカーネルで列を並行処理する
+ * (サブキーの並べ替えは列のブロック数分使い回すので, blocks が大きいほど効率がよい)
+ * m[n][16*blocks]: RFC 3713 規定の変数M の並び
+ * data[n]: 変換テーブル
+ * c[n][16*blocks]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[n][16]: CBC モードの初期化ベクタ(M に排他的論理和してから処理し, 処理後は最後の C に更新)
+ *  (NULL=列のブロックを独立に処理する)
+ * n: 列数
+ * blocks: 列ごとのブロック数
+ */
+void camelliaDatarandMulti(const uint8_t *const *m,
+                           const CamelliaData *const *data,
+                           uint8_t *const *c, uint8_t *const *iv,
+                           size_t n, size_t blocks ) {
+    const uint8_t *gm[MULTI_LANES];
+    const CamelliaData *gdata[MULTI_LANES];
+    uint8_t *gc[MULTI_LANES];
+    uint8_t *giv[MULTI_LANES];
+    int groups;
+    size_t g, i;
+
+    STATS_ADD(multi, 1);
+    STATS_ADD(multiBlocks, n * blocks);
+    for (groups = 3; groups <= 4; ++groups) {
+        g = 0;
+        for (i = 0; i < n; ++i) {
+            if (GROUPS(data[i]) != groups)
+                continue;
+            gm[g] = m[i], gdata[g] = data[i], gc[g] = c[i], giv[g] = iv != NULL ? iv[i] : NULL;
+            if (++g == MULTI_LANES) {
+                multi(gm, gdata, gc, iv != NULL ? giv : NULL, g, blocks, groups);
+                g = 0;
+            }
+        }
+        if (g > 0)
+            multi(gm, gdata, gc, iv != NULL ? giv : NULL, g, blocks, groups);
+    }
+}
+
+/* RFC 3713 規定のデータランダム化処理(2ブロック並行, 順変換のみ, キー種別の確認なし)
+ * 選択中のカーネルの処理時間がデータとキーに依存しない場合は8ブロック並行のビットスライスで処理する
+ * m1[16], m2[16]: RFC 3713 規定の変数M
+ * data: 変換テーブル
+ * c1[16], c2[16]: RFC 3713 規定の変数C (m1, m2 と同一領域も可)
+ */
+void camelliaDatarandPair(const uint8_t *m1, const uint8_t *m2,
+                          const CamelliaData *data,
+                          uint8_t *c1, uint8_t *c2 ) {
+    uint8_t buf[32];
+    CamelliaKernel kernel;
+
+    STATS_ADD(pair, 1);
+    kernel = camelliaKernelCurrent();
+    if (kernels[kernel].constant) {
+        memcpy(buf + 0, m1, 16), memcpy(buf + 16, m2, 16);
+        camelliaDatarandBitsliceNarrow(buf, data, buf, 2, 0);
+        memcpy(c1, buf + 0, 16), memcpy(c2, buf + 16, 16);
+    }
+    else if (GROUPS(data) == 3)
+        walkPair(m1, m2, data->sk, c1, c2, 3);
+    else
+        walkPair(m1, m2, data->sk, c1, c2, 4);
+}
+
+/* RFC 3713 規定のデータランダム化処理(複数ブロック一括)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaDatarandBulk(const uint8_t *m, const CamelliaData *data,
+                         uint8_t *c, size_t n ) {
+    return bulk(m, data, c, n, 0);
+}
+
+/* RFC 3713 規定のデータランダム化処理の逆変換
+ * 暗号キーの変換テーブルで復号, 復号キーの変換テーブルで暗号化できる
+ * (camelliaKeyswap() した変換テーブルで camelliaDatarand() するのと同じ)
+ * c[16]: RFC 3713 規定の変数C
+ * data: 変換テーブル
+ * m[16]: RFC 3713 規定の変数M
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaDatarandInv(const uint8_t *c, const CamelliaData *data,
+                        uint8_t *m ) {
+    int status = -1;
+
+    switch (data->type) {
+    case Camellia128Encrypt:
+    case Camellia128Decrypt:
     case Camellia192Encrypt:
     case Camellia192Decrypt:
     case Camellia256Encrypt:
     case Camellia256Decrypt:
-        d1 = fl(d1, data->ke5);
-        d2 = flinv(d2, data->ke6);
-        d2 ^= f(d1, data->k19);
-        d1 ^= f(d2, data->k20);
-        d2 ^= f(d1, data->k21);
-        d1 ^= f(d2, data->k22);
-        d2 ^= f(d1, data->k23);
-        d1 ^= f(d2, data->k24);
         break;
     default:
-        ASSERT(0);  /* never reached */
+        goto error;
     }
-    d2 ^= data->kw3;
-    d1 ^= data->kw4;
-    u8n64_set(d2, c + 0);
-    u8n64_set(d1, c + 8);
+    single(c, data, m, 1);
+    STATS_ADD(single, 1);
     status = 0;
 error:
     return status;
 }
+
+/* RFC 3713 規定のデータランダム化処理の逆変換(複数ブロック一括)
+ * 暗号キーの変換テーブルで復号, 復号キーの変換テーブルで暗号化できる
+ * (camelliaKeyswap() した変換テーブルで camelliaDatarandBulk() するのと同じ)
+ * c[16*n]: RFC 3713 規定の変数C の並び
+ * data: 変換テーブル
+ * m[16*n]: RFC 3713 規定の変数M の並び (c と同一領域も可)
+ * n: ブロック数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaDatarandInvBulk(const uint8_t *c, const CamelliaData *data,
+                            uint8_t *m, size_t n ) {
+    return bulk(c, data, m, n, 1);
+}
+
+/* 復号方向のデータランダム化処理(複数ブロック一括)
+ * c[16*n]: RFC 3713 規定の変数C の並び
+ * data: 変換テーブル(暗号キーの場合は逆変換, 復号キーの場合はそのまま処理する)
+ * m[16*n]: RFC 3713 規定の変数M の並び (c と同一領域も可)
+ * n: ブロック数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaDecryptBulk(const uint8_t *c, const CamelliaData *data,
+                        uint8_t *m, size_t n ) {
+    int status = -1;
+
+    switch (data->type) {
+    case Camellia128Encrypt:
+    case Camellia192Encrypt:
+    case Camellia256Encrypt:
+        status = camelliaDatarandInvBulk(c, data, m, n);
+        break;
+    default:
+        status = camelliaDatarandBulk(c, data, m, n);
+        break;
+    }
+    return status;
+}
@@ -1,4 +1,4 @@
-/* camellia.h - Last modified: 31-Jul-2021 (kobayasy)
+/* camellia.h - Last modified: 16-Oct-2026 (kobayasy)
  * The Camellia Encryption Algorithm (RFC 3713).
  *
  * Copyright (c) 2021 by Yuichi Kobayashi <kobayasy@kobayasy.com>
@@ -27,8 +27,13 @@
 #ifndef _INCLUDE_camellia_h
 #define _INCLUDE_camellia_h
 
+#include <stddef.h>
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif  /* #ifdef __cplusplus */
+
 /* 変換テーブル
  */
 typedef enum {  /* 暗号/復号キー種別 */
@@ -40,14 +45,45 @@ typedef enum {  /* 暗号/復号キー種別 */
     Camellia256Encrypt,  /* Camellia 256bit 暗号キー */
     Camellia256Decrypt   /* Camellia 256bit 復号キー */
 } CamelliaKeytype;
-typedef struct {  /* 暗号/復号 変換テーブル */
-    CamelliaKeytype type;                                                 /* 暗号/復号キー種別 */
-    uint64_t kw1, kw2, kw3, kw4;                                          /* RFC 3713 規定のサブキー変数 */
-    uint64_t k1,  k2,  k3,  k4,  k5,  k6,  k7,  k8,  k9,  k10, k11, k12,  /* RFC 3713 規定のサブキー変数 */
-             k13, k14, k15, k16, k17, k18, k19, k20, k21, k22, k23, k24;
-    uint64_t ke1, ke2, ke3, ke4, ke5, ke6;                                /* RFC 3713 規定のサブキー変数 */
+#if defined(__GNUC__)  // サブキーの並びをキャッシュライン境界に置く
+#define CAMELLIA_ALIGNED __attribute__((aligned(64)))
+#else  /* #if defined(__GNUC__) */
+#define CAMELLIA_ALIGNED /* 定義なし */
+#endif  /* #if defined(__GNUC__) */
+typedef struct CAMELLIA_ALIGNED {  /* 暗号/復号 変換テーブル */
+    union {
+        uint64_t sk[34];                             /* サブキーの並び(下記のサブキー変数と同じ領域) */
+        struct {                                     /* RFC 3713 規定のサブキー変数(データランダム化処理で使う順) */
+            uint64_t kw1, kw2;                       /*  sk[0], sk[1] */
+            uint64_t k1,  k2,  k3,  k4,  k5,  k6;    /*  sk[2] ～ sk[7] */
+            uint64_t ke1, ke2;                       /*  sk[8], sk[9] */
+            uint64_t k7,  k8,  k9,  k10, k11, k12;   /*  sk[10] ～ sk[15] */
+            uint64_t ke3, ke4;                       /*  sk[16], sk[17] */
+            uint64_t k13, k14, k15, k16, k17, k18;   /*  sk[18] ～ sk[23] */
+            uint64_t ke5, ke6;                       /*  sk[24], sk[25] (192bit, 256bit キーのみ) */
+            uint64_t k19, k20, k21, k22, k23, k24;   /*  sk[26] ～ sk[31] (192bit, 256bit キーのみ) */
+            uint64_t kw3, kw4;                       /*  sk[32], sk[33] */
+        };
+    };
+    CamelliaKeytype type;                            /* 暗号/復号キー種別 */
 } CamelliaData;
 
+/* 複数ブロック一括処理のカーネル
+ * ビットスライスを選択すると, 1ブロックの処理, キースケジューリング, 独立したブロック列の処理も
+ * そのカーネルで行う (Camellia の処理時間がデータとキーに依存しない.
+ * ただし GCM の GHASH は PCLMULQDQ がない CPU ではテーブル参照になる)
+ */
+typedef enum {  /* カーネル種別 */
+    CamelliaKernelAuto=0,        /* 自動選択 */
+    CamelliaKernelGeneric,       /* 汎用 (C言語, 4ブロック並行) */
+    CamelliaKernelAesni,         /* AES-NI, AVX (16ブロック並行) */
+    CamelliaKernelVaes,          /* AVX2, VAES (32ブロック並行) */
+    CamelliaKernelBitslice,      /* ビットスライス (C言語, 64ブロック並行, 処理時間がデータとキーに依存しない) */
+    CamelliaKernelBitsliceSse2,  /* ビットスライス (SSE2, 128ブロック並行, 処理時間がデータとキーに依存しない) */
+    CamelliaKernelBitsliceAvx2,  /* ビットスライス (AVX2, 256ブロック並行, 処理時間がデータとキーに依存しない) */
+    CamelliaKernelAvx512         /* AVX-512, GFNI (64ブロック並行) */
+} CamelliaKernel;
+
 /* RFC 3713 規定のキースケジューリング処理
  * type: 暗号/復号キー種別
  *  (Camellia128Encrypt, Camellia192Encrypt or Camellia256Encrypt)
@@ -59,6 +95,19 @@ typedef struct {  /* 暗号/復号 変換テーブル */
 extern int camelliaKeysche(CamelliaKeytype type, const uint8_t *k,
                            CamelliaData *data );
 
+/* RFC 3713 規定のキースケジューリング処理(複数キー一括)
+ * 複数ブロック一括処理のカーネルで複数のキーの中間鍵(KA, KB)を並行して生成する
+ * type: 暗号キー種別(全キー共通)
+ *  (Camellia128Encrypt, Camellia192Encrypt or Camellia256Encrypt)
+ * k[len*n]: RFC 3713 規定の変数K の並び
+ *  (type=Camellia128Encrypt の場合 len=16, Camellia192Encrypt の場合 len=24, Camellia256Encrypt の場合 len=32)
+ * data[n]: 変換テーブルの並び
+ * n: キー数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaKeyscheBulk(CamelliaKeytype type, const uint8_t *k,
+                               CamelliaData *data, size_t n );
+
 /* 変換テーブルを暗号キーと復号キーに相互変換
  * data: 変換テーブル
  * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
@@ -74,4 +123,66 @@ extern int camelliaKeyswap(CamelliaData *data);
 extern int camelliaDatarand(const uint8_t *m, const CamelliaData *data,
                             uint8_t *c );
 
+/* RFC 3713 規定のデータランダム化処理(複数ブロック一括)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaDatarandBulk(const uint8_t *m, const CamelliaData *data,
+                                uint8_t *c, size_t n );
+
+/* RFC 3713 規定のデータランダム化処理の逆変換
+ * 暗号キーの変換テーブルで復号, 復号キーの変換テーブルで暗号化できる
+ * (camelliaKeyswap() した変換テーブルで camelliaDatarand() するのと同じ)
+ * c[16]: RFC 3713 規定の変数C
+ * data: 変換テーブル
+ * m[16]: RFC 3713 規定の変数M
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaDatarandInv(const uint8_t *c, const CamelliaData *data,
+                               uint8_t *m );
+
+/* RFC 3713 規定のデータランダム化処理の逆変換(複数ブロック一括)
+ * 暗号キーの変換テーブルで復号, 復号キーの変換テーブルで暗号化できる
+ * (camelliaKeyswap() した変換テーブルで camelliaDatarandBulk() するのと同じ)
+ * c[16*n]: RFC 3713 規定の変数C の並び
+ * data: 変換テーブル
+ * m[16*n]: RFC 3713 規定の変数M の並び (c と同一領域も可)
+ * n: ブロック数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaDatarandInvBulk(const uint8_t *c, const CamelliaData *data,
+                                   uint8_t *m, size_t n );
+
+/* カーネルがこのCPUで利用可能か調べる
+ * kernel: カーネル種別
+ * 戻り値: 0以外=利用可能, 0=利用不可
+ */
+extern int camelliaKernelSupported(CamelliaKernel kernel);
+
+/* カーネルの名前を取得
+ * kernel: カーネル種別
+ * 戻り値: カーネル名 (未サポートな kernel の場合 NULL)
+ */
+extern const char *camelliaKernelName(CamelliaKernel kernel);
+
+/* 複数ブロック一括処理に使うカーネルを選択
+ * kernel: カーネル種別 (CamelliaKernelAuto=利用可能な最速のカーネル, ビットスライスは明示的な指定でのみ選択)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(このCPUで利用できない kernel を指定した)
+ */
+extern int camelliaKernelSelect(CamelliaKernel kernel);
+
+/* 複数ブロック一括処理に使うカーネルを取得
+ * 初回は環境変数 CAMELLIA_KERNEL (カーネル名) で指定されたカーネル,
+ * 指定がなければ利用可能な最速のカーネルを選択する
+ * 戻り値: カーネル種別
+ */
+extern CamelliaKernel camelliaKernelCurrent(void);
+
+#ifdef __cplusplus
+}
+#endif  /* #ifdef __cplusplus */
+
 #endif  /* #ifndef _INCLUDE_camellia_h */
@@ -0,0 +1,365 @@
+/* camellia.hpp - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - C++ front end.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _INCLUDE_camellia_hpp
+#define _INCLUDE_camellia_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#if __cplusplus >= 202002L
+#include <span>
+#endif  /* #if __cplusplus >= 202002L */
+#include "camellia.h"
+
+/* C++ 用のキー長別クラス(C++17 以降, std::span は C++20 以降)
+ * キー長ごとにラウンド数と変換方向を定数として1ブロックの処理を完全に展開し,
+ * キー種別の実行時判定をなくす(結果は C の API と同じ)
+ * 複数ブロック一括処理は C の API (選択中のカーネル)で処理する
+ * (SPTABLE=0 でビルドした場合とビットスライスのカーネルを選択中の場合は, 1ブロックも C の API で処理する)
+ */
+namespace camellia {
+
+namespace detail {
+
+/* RFC 3713 規定の S-box SBOX1 */
+inline constexpr std::uint8_t sbox1[256] = {
+    112, 130,  44, 236, 179,  39, 192, 229, 228, 133,  87,  53, 234,  12, 174,  65,
+     35, 239, 107, 147,  69,  25, 165,  33, 237,  14,  79,  78,  29, 101, 146, 189,
+    134, 184, 175, 143, 124, 235,  31, 206,  62,  48, 220,  95,  94, 197,  11,  26,
+    166, 225,  57, 202, 213,  71,  93,  61, 217,   1,  90, 214,  81,  86, 108,  77,
+    139,  13, 154, 102, 251, 204, 176,  45, 116,  18,  43,  32, 240, 177, 132, 153,
+    223,  76, 203, 194,  52, 126, 118,   5, 109, 183, 169,  49, 209,  23,   4, 215,
+     20,  88,  58,  97, 222,  27,  17,  28,  50,  15, 156,  22,  83,  24, 242,  34,
+    254,  68, 207, 178, 195, 181, 122, 145,  36,   8, 232, 168,  96, 252, 105,  80,
+    170, 208, 160, 125, 161, 137,  98, 151,  84,  91,  30, 149, 224, 255, 100, 210,
+     16, 196,   0,  72, 163, 247, 117, 219, 138,   3, 230, 218,   9,  63, 221, 148,
+    135,  92, 131,   2, 205,  74, 144,  51, 115, 103, 246, 243, 157, 127, 191, 226,
+     82, 155, 216,  38, 200,  55, 198,  59, 129, 150, 111,  75,  19, 190,  99,  46,
+    233, 121, 167, 140, 159, 110, 188, 142,  41, 245, 249, 182,  47, 253, 180,  89,
+    120, 152,   6, 106, 231,  70, 113, 186, 212,  37, 171,  66, 136, 162, 141, 250,
+    114,   7, 185,  85, 248, 238, 172,  10,  54,  73,  42, 104,  60,  56, 241, 164,
+     64,  40, 211, 123, 187, 201,  67, 193,  21, 227, 173, 244, 119, 199, 128, 158
+};
+
+/* 8ビット値左回転 */
+constexpr std::uint8_t r8(std::uint8_t x, unsigned bit) {
+    return (std::uint8_t)(x << bit | x >> (8 - bit));
+}
+
+/* 32ビット値左回転 */
+constexpr std::uint32_t r32(std::uint32_t x, unsigned bit) {
+    return x << bit | x >> (32 - bit);
+}
+
+/* S関数とP関数を合成した32ビットSPテーブル(コンパイル時に SBOX1 から生成する) */
+struct Sp {
+    std::uint32_t sp1110[256], sp0222[256], sp3033[256], sp4404[256];
+};
+
+constexpr Sp makeSp() {
+    Sp sp = {};
+
+    for (unsigned x = 0; x < 256; ++x) {
+        std::uint32_t s1 = sbox1[x];
+        std::uint32_t s2 = r8(sbox1[x], 1);
+        std::uint32_t s3 = r8(sbox1[x], 7);
+        std::uint32_t s4 = sbox1[r8((std::uint8_t)x, 1)];
+        sp.sp1110[x] = s1 << 24 | s1 << 16 | s1 << 8;
+        sp.sp0222[x] = s2 << 16 | s2 << 8 | s2;
+        sp.sp3033[x] = s3 << 24 | s3 << 8 | s3;
+        sp.sp4404[x] = s4 << 24 | s4 << 16 | s4;
+    }
+    return sp;
+}
+
+inline constexpr Sp sp = makeSp();
+
+/* 消去(最適化で省略されないように関数ポインタ経由で呼ぶ) */
+inline void *(*const volatile wipe)(void *s, int c, std::size_t n) = std::memset;
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+/* ビッグエンディアン(ネットワークバイトオーダー)の8バイトデータを変換 */
+inline std::uint64_t n8u64(const std::uint8_t *n64) {
+    std::uint64_t u64;
+
+    std::memcpy(&u64, n64, sizeof(u64));
+    return __builtin_bswap64(u64);
+}
+
+/* ビッグエンディアン(ネットワークバイトオーダー)の8バイトデータに変換 */
+inline void u8n64_set(std::uint64_t u64, std::uint8_t *n64) {
+    u64 = __builtin_bswap64(u64);
+    std::memcpy(n64, &u64, sizeof(u64));
+}
+#else  /* #if defined(__GNUC__) && ... */
+/* ビッグエンディアン(ネットワークバイトオーダー)の8バイトデータを変換 */
+inline std::uint64_t n8u64(const std::uint8_t *n64) {
+    std::uint64_t u64 = 0;
+
+    for (int n = 0; n < 8; ++n)
+        u64 = u64 << 8 | n64[n];
+    return u64;
+}
+
+/* ビッグエンディアン(ネットワークバイトオーダー)の8バイトデータに変換 */
+inline void u8n64_set(std::uint64_t u64, std::uint8_t *n64) {
+    for (int n = 7; n >= 0; --n)
+        n64[n] = (std::uint8_t)u64, u64 >>= 8;
+}
+#endif  /* #if defined(__GNUC__) && ... */
+
+/* RFC 3713 規定のF関数 */
+inline std::uint64_t f(std::uint64_t fIn, std::uint64_t ke) {
+    std::uint64_t x = fIn ^ ke;
+    std::uint32_t x1 = (std::uint32_t)(x >> 32), x2 = (std::uint32_t)x;
+    std::uint32_t z1, z2;
+
+    z1 = sp.sp1110[(std::uint8_t)(x1 >> 24)] ^ sp.sp0222[(std::uint8_t)(x1 >> 16)] ^
+         sp.sp3033[(std::uint8_t)(x1 >>  8)] ^ sp.sp4404[(std::uint8_t)(x1 >>  0)];
+    z2 = sp.sp1110[(std::uint8_t)(x2 >>  0)] ^ sp.sp0222[(std::uint8_t)(x2 >> 24)] ^
+         sp.sp3033[(std::uint8_t)(x2 >> 16)] ^ sp.sp4404[(std::uint8_t)(x2 >>  8)];
+    z2 ^= z1;
+    z1 = z2 ^ r32(z1, 24);
+    return (std::uint64_t)z2 << 32 | z1;
+}
+
+/* RFC 3713 規定のFL関数 */
+inline std::uint64_t fl(std::uint64_t flIn, std::uint64_t ke) {
+    std::uint32_t x1 = (std::uint32_t)(flIn >> 32), x2 = (std::uint32_t)flIn;
+    std::uint32_t k1 = (std::uint32_t)(ke >> 32), k2 = (std::uint32_t)ke;
+
+    x2 ^= r32(x1 & k1, 1), x1 ^= x2 | k2;
+    return (std::uint64_t)x1 << 32 | x2;
+}
+
+/* RFC 3713 規定のFLINV関数 */
+inline std::uint64_t flinv(std::uint64_t flinvIn, std::uint64_t ke) {
+    std::uint32_t y1 = (std::uint32_t)(flinvIn >> 32), y2 = (std::uint32_t)flinvIn;
+    std::uint32_t k1 = (std::uint32_t)(ke >> 32), k2 = (std::uint32_t)ke;
+
+    y1 ^= y2 | k2, y2 ^= r32(y1 & k1, 1);
+    return (std::uint64_t)y1 << 32 | y2;
+}
+
+/* 1ブロックを展開したSPテーブル参照で処理するか
+ * 戻り値: true=展開して処理する, false=C の API で処理する
+ */
+inline bool unrolled() noexcept {
+#if defined(SPTABLE) && !SPTABLE
+    return false;
+#else  /* #if defined(SPTABLE) && !SPTABLE */
+    switch (camelliaKernelCurrent()) {
+    case CamelliaKernelBitslice:
+    case CamelliaKernelBitsliceSse2:
+    case CamelliaKernelBitsliceAvx2:
+        return false;  /* 処理時間がデータとキーに依存しないカーネルで処理する */
+    default:
+        return true;
+    }
+#endif  /* #if defined(SPTABLE) && !SPTABLE */
+}
+
+}  // namespace detail
+
+/* キー長別の暗号/復号キー
+ * 暗号キーの変換テーブルを保持し, 復号は逆変換で処理する
+ * コピーはできず(ムーブのみ), 破棄とムーブ元の変換テーブルは消去する
+ * Bits: キーのビット数(128, 192 or 256)
+ */
+template <unsigned Bits>
+class Camellia {
+    static_assert(Bits == 128 || Bits == 192 || Bits == 256, "Camellia key size must be 128, 192 or 256 bits");
+
+public:
+    static constexpr std::size_t keySize = Bits / 8;      /* キーのバイト数 */
+    static constexpr std::size_t blockSize = 16;          /* ブロックのバイト数 */
+    static constexpr int rounds = Bits == 128 ? 18 : 24;  /* ラウンド数 */
+    static constexpr int groups = rounds / 6;             /* 6ラウンド単位のグループ数 */
+    static constexpr CamelliaKeytype type =               /* 暗号キー種別 */
+        Bits == 128 ? Camellia128Encrypt : Bits == 192 ? Camellia192Encrypt : Camellia256Encrypt;
+
+    /* RFC 3713 規定のキースケジューリング処理
+     * k[keySize]: RFC 3713 規定の変数K
+     */
+    explicit Camellia(const std::uint8_t *k) noexcept {
+        camelliaKeysche(type, k, &data_);
+    }
+
+#if __cplusplus >= 202002L
+    explicit Camellia(std::span<const std::uint8_t, keySize> k) noexcept
+        : Camellia(k.data()) {}
+#endif  /* #if __cplusplus >= 202002L */
+
+    Camellia(const Camellia &) = delete;
+    Camellia &operator=(const Camellia &) = delete;
+
+    Camellia(Camellia &&other) noexcept
+        : data_(other.data_) {
+        other.wipe();
+    }
+
+    Camellia &operator=(Camellia &&other) noexcept {
+        if (this != &other) {
+            data_ = other.data_;
+            other.wipe();
+        }
+        return *this;
+    }
+
+    ~Camellia() {
+        wipe();
+    }
+
+    /* RFC 3713 規定のデータランダム化処理
+     * m[16]: RFC 3713 規定の変数M
+     * c[16]: RFC 3713 規定の変数C (m と同一領域も可)
+     */
+    void encrypt(const std::uint8_t *m, std::uint8_t *c) const noexcept {
+        if (detail::unrolled())
+            walk<false>(m, c, std::make_index_sequence<groups>());
+        else
+            camelliaDatarand(m, &data_, c);
+    }
+
+    /* RFC 3713 規定のデータランダム化処理の逆変換
+     * c[16]: RFC 3713 規定の変数C
+     * m[16]: RFC 3713 規定の変数M (c と同一領域も可)
+     */
+    void decrypt(const std::uint8_t *c, std::uint8_t *m) const noexcept {
+        if (detail::unrolled())
+            walk<true>(c, m, std::make_index_sequence<groups>());
+        else
+            camelliaDatarandInv(c, &data_, m);
+    }
+
+    /* RFC 3713 規定のデータランダム化処理(複数ブロック一括)
+     * m[16*n]: RFC 3713 規定の変数M の並び
+     * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+     * n: ブロック数
+     * 戻り値: 0以上=正常終了, 0未満=異常終了
+     */
+    int encrypt(const std::uint8_t *m, std::uint8_t *c, std::size_t n) const noexcept {
+        return camelliaDatarandBulk(m, &data_, c, n);
+    }
+
+    /* RFC 3713 規定のデータランダム化処理の逆変換(複数ブロック一括)
+     * c[16*n]: RFC 3713 規定の変数C の並び
+     * m[16*n]: RFC 3713 規定の変数M の並び (c と同一領域も可)
+     * n: ブロック数
+     * 戻り値: 0以上=正常終了, 0未満=異常終了
+     */
+    int decrypt(const std::uint8_t *c, std::uint8_t *m, std::size_t n) const noexcept {
+        return camelliaDatarandInvBulk(c, &data_, m, n);
+    }
+
+#if __cplusplus >= 202002L
+    /* RFC 3713 規定のデータランダム化処理(複数ブロック一括)
+     * m: RFC 3713 規定の変数M の並び
+     * c: RFC 3713 規定の変数C の並び (m と同一領域も可)
+     * 戻り値: 0以上=正常終了, 0未満=異常終了(m と c のバイト数が異なる, または16の倍数でない)
+     */
+    int encrypt(std::span<const std::uint8_t> m, std::span<std::uint8_t> c) const noexcept {
+        if (m.size() != c.size() || m.size() % blockSize)
+            return -1;
+        return encrypt(m.data(), c.data(), m.size() / blockSize);
+    }
+
+    /* RFC 3713 規定のデータランダム化処理の逆変換(複数ブロック一括)
+     * c: RFC 3713 規定の変数C の並び
+     * m: RFC 3713 規定の変数M の並び (c と同一領域も可)
+     * 戻り値: 0以上=正常終了, 0未満=異常終了(c と m のバイト数が異なる, または16の倍数でない)
+     */
+    int decrypt(std::span<const std::uint8_t> c, std::span<std::uint8_t> m) const noexcept {
+        if (c.size() != m.size() || c.size() % blockSize)
+            return -1;
+        return decrypt(c.data(), m.data(), c.size() / blockSize);
+    }
+#endif  /* #if __cplusplus >= 202002L */
+
+    /* 変換テーブル(C の API に渡す場合に使う) */
+    const CamelliaData &data() const noexcept {
+        return data_;
+    }
+
+private:
+    CamelliaData data_;  /* 変換テーブル(暗号キー) */
+
+    /* データランダム化処理で i 番目に使うサブキーの sk[] の添字 (camellia_kernel.h の SKI と同じ) */
+    template <bool Inv>
+    static constexpr int ski(int i) {
+        return !Inv ? (i < groups * 8 ? i : i - groups * 8 + 32) :
+               i < 2 ? i + 32 :
+               i < groups * 8 ? groups * 8 + 1 - i : i - groups * 8;
+    }
+
+    /* 6ラウンド単位のグループ(2番目以降は FL, FLINV 関数を先に処理する) */
+    template <bool Inv, std::size_t G>
+    void group(std::uint64_t &d1, std::uint64_t &d2) const noexcept {
+        constexpr int i = 2 + (int)G * 8;
+        const std::uint64_t *sk = data_.sk;
+
+        if constexpr (G > 0) {
+            d1 = detail::fl(d1, sk[ski<Inv>(i - 2)]);
+            d2 = detail::flinv(d2, sk[ski<Inv>(i - 1)]);
+        }
+        d2 ^= detail::f(d1, sk[ski<Inv>(i + 0)]);
+        d1 ^= detail::f(d2, sk[ski<Inv>(i + 1)]);
+        d2 ^= detail::f(d1, sk[ski<Inv>(i + 2)]);
+        d1 ^= detail::f(d2, sk[ski<Inv>(i + 3)]);
+        d2 ^= detail::f(d1, sk[ski<Inv>(i + 4)]);
+        d1 ^= detail::f(d2, sk[ski<Inv>(i + 5)]);
+    }
+
+    /* RFC 3713 規定のデータランダム化処理(全グループを展開) */
+    template <bool Inv, std::size_t... G>
+    void walk(const std::uint8_t *in, std::uint8_t *out,
+              std::index_sequence<G...> ) const noexcept {
+        const std::uint64_t *sk = data_.sk;
+        std::uint64_t d1, d2;
+
+        d1 = detail::n8u64(in + 0) ^ sk[ski<Inv>(0)];
+        d2 = detail::n8u64(in + 8) ^ sk[ski<Inv>(1)];
+        (group<Inv, G>(d1, d2), ...);
+        d2 ^= sk[ski<Inv>(groups * 8 + 0)];
+        d1 ^= sk[ski<Inv>(groups * 8 + 1)];
+        detail::u8n64_set(d2, out + 0);
+        detail::u8n64_set(d1, out + 8);
+    }
+
+    void wipe() noexcept {
+        detail::wipe(&data_, 0, sizeof(data_));
+    }
+};
+
+using Camellia128 = Camellia<128>;
+using Camellia192 = Camellia<192>;
+using Camellia256 = Camellia<256>;
+
+}  // namespace camellia
+
+#endif  /* #ifndef _INCLUDE_camellia_hpp */
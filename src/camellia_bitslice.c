@@ -0,0 +1,417 @@
+/* camellia_bitslice.c - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - bitsliced constant-time kernels.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camellia.h"
+#include "camellia_kernel.h"
+
+#if defined(__GNUC__)
+#define FORCE_INLINE __inline__ __attribute__((always_inline))
+#else  /* #if defined(__GNUC__) */
+#define FORCE_INLINE /* 定義なし */
+#endif  /* #if defined(__GNUC__) */
+
+#if KERNEL_X86
+#include <immintrin.h>
+#endif  /* #if KERNEL_X86 */
+
+/* RFC 3713 規定の定数 Sigma1 ～ Sigma6 */
+static const uint64_t bitsliceSigma[6] = {
+    0xa09e667f3bcc908b, 0xb67ae8584caa73b2, 0xc6ef372fe94f82be,
+    0x54ff53a5f1d36f1c, 0x10e527fade682d1d, 0xb05688c2b3e6c1fd
+};
+
+/* 64x64ビット行列の転置(逆対角線で折り返す)
+ * x[64]: 転置する行列(x[63-i] の j ビット目と x[63-j] の i ビット目を入れ替える)
+ */
+static void transpose64(uint64_t *x) {
+    uint64_t m = 0x00000000ffffffff, t;
+    int j, k;
+
+    for (j = 32; j != 0; j >>= 1, m ^= m << j)
+        for (k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+            t = (x[k] ^ (x[k | j] >> j)) & m;
+            x[k] ^= t, x[k | j] ^= t << j;
+        }
+}
+
+/* 64ビット整数(64ブロック並行)
+ */
+#define BVEC uint64_t
+#define WORDS 1
+#define TARGET /* 定義なし */
+#define NAME(_name) _name##Bitslice
+#define bload(_p) (*(_p))
+#define bstore(_p, _v) (*(_p) = (_v))
+#define bmask(_m) ((uint64_t)(_m))
+#define bxor(_a, _b) ((_a) ^ (_b))
+#define band(_a, _b) ((_a) & (_b))
+#define bor(_a, _b) ((_a) | (_b))
+#define bnot(_a) (~(_a))
+#include "camellia_bitslice.h"
+#undef BVEC
+#undef WORDS
+#undef TARGET
+#undef NAME
+#undef bload
+#undef bstore
+#undef bmask
+#undef bxor
+#undef band
+#undef bor
+#undef bnot
+
+/* 少数ブロックのビットスライス(F関数の入力の8バイトをレーンにして, 8ブロック並行)
+ * 1ブロックや2ブロックを幅の広いカーネルで処理すると並行数分の処理時間がかかるので,
+ * 各ブロックの8バイトを64ビット整数の1ビットずつに並べて s1 を1回の論理回路で求める
+ */
+#define NARROW_BLOCKS 8  /* 並行するブロック数 */
+#define NARROW_LSB 0x0101010101010101  /* 各バイトの最下位ビット */
+#define NARROW_S2 0x00ff0000ff000000  /* s2 を使うバイト(t2, t5) */
+#define NARROW_S3 0x0000ff0000ff0000  /* s3 を使うバイト(t3, t6) */
+#define NARROW_S4 0x000000ff0000ff00  /* s4 を使うバイト(t4, t7) */
+
+/* 64ビット整数の各バイトの左回転と右回転(1ビット)
+ */
+#define rotlNarrow(_x) \
+    (((_x) << 1 & 0xfefefefefefefefe) | ((_x) >> 7 & NARROW_LSB))
+#define rotrNarrow(_x) \
+    (((_x) >> 1 & 0x7f7f7f7f7f7f7f7f) | ((_x) << 7 & 0x8080808080808080))
+
+/* 32ビット整数の左回転 */
+#define rotl32Narrow(_x, _n) \
+    ((uint32_t)((_x) << (_n) | (_x) >> (32 - (_n))))
+
+/* RFC 3713 規定のF関数(少数ブロックのビットスライス)
+ * x[n]: F関数の入力
+ * k: サブキー(全ブロック共通)
+ * y[n]: F関数の出力を排他的論理和する変数
+ * n: ブロック数(1 ～ NARROW_BLOCKS)
+ */
+static void fNarrow(const uint64_t *x, uint64_t k, uint64_t *y, size_t n) {
+    uint64_t w[8], v[8];
+    uint64_t t;
+    uint32_t d, u;
+    size_t i;
+    int j;
+
+    for (j = 0; j < 8; ++j)
+        w[j] = 0;
+    for (i = 0; i < n; ++i) {
+        t = x[i] ^ k;
+        t = (t & ~NARROW_S4) | (rotlNarrow(t) & NARROW_S4);  /* s4(x) = s1(x <<< 1) */
+        for (j = 0; j < 8; ++j)
+            w[j] |= (t >> j & NARROW_LSB) << i;
+    }
+    sboxBitslice(w, v);
+    for (i = 0; i < n; ++i) {
+        t = 0;
+        for (j = 0; j < 8; ++j)
+            t |= (v[j] >> i & NARROW_LSB) << j;
+        t = (t & ~(NARROW_S2 | NARROW_S3)) |
+            (rotlNarrow(t) & NARROW_S2) | (rotrNarrow(t) & NARROW_S3);  /* s2(x) = s1(x) <<< 1, s3(x) = s1(x) >>> 1 */
+        /* P関数(左右32ビットの回転と排他的論理和で求める) */
+        d = (uint32_t)(t >> 32) ^ rotl32Narrow((uint32_t)t, 16);
+        u = (uint32_t)t ^ d;
+        d ^= rotl32Narrow(u, 8);
+        u ^= rotl32Narrow(d, 16);
+        y[i] ^= (uint64_t)u << 32 | d;
+    }
+}
+
+/* RFC 3713 規定のFL関数とFLINV関数(少数ブロック)
+ * a[n]: FL関数で変換する変数
+ * b[n]: FLINV関数で変換する変数
+ * ka, kb: サブキー
+ * n: ブロック数
+ */
+static void flNarrow(uint64_t *a, uint64_t *b, uint64_t ka, uint64_t kb, size_t n) {
+    uint32_t x1, x2, y1, y2, t;
+    size_t i;
+
+    for (i = 0; i < n; ++i) {
+        x1 = a[i] >> 32, x2 = a[i];
+        t = x1 & (uint32_t)(ka >> 32), x2 ^= t << 1 | t >> 31, x1 ^= x2 | (uint32_t)ka;
+        a[i] = (uint64_t)x1 << 32 | x2;
+        y1 = b[i] >> 32, y2 = b[i];
+        y1 ^= y2 | (uint32_t)kb, t = y1 & (uint32_t)(kb >> 32), y2 ^= t << 1 | t >> 31;
+        b[i] = (uint64_t)y1 << 32 | y2;
+    }
+}
+
+#if KERNEL_X86
+/* SSE2 (128ビット, 128ブロック並行)
+ */
+#define BVEC __m128i
+#define WORDS 2
+#define TARGET __attribute__((target("sse2")))
+#define NAME(_name) _name##BitsliceSse2
+#define bload(_p) _mm_loadu_si128((const __m128i *)(_p))
+#define bstore(_p, _v) _mm_storeu_si128((__m128i *)(_p), (_v))
+#define bmask(_m) _mm_set1_epi64x((long long)(_m))
+#define bxor _mm_xor_si128
+#define band _mm_and_si128
+#define bor _mm_or_si128
+#define bnot(_a) _mm_xor_si128((_a), _mm_set1_epi32(-1))
+#include "camellia_bitslice.h"
+#undef BVEC
+#undef WORDS
+#undef TARGET
+#undef NAME
+#undef bload
+#undef bstore
+#undef bmask
+#undef bxor
+#undef band
+#undef bor
+#undef bnot
+
+/* AVX2 (256ビット, 256ブロック並行)
+ */
+#define BVEC __m256i
+#define WORDS 4
+#define TARGET __attribute__((target("avx2")))
+#define NAME(_name) _name##BitsliceAvx2
+#define bload(_p) _mm256_loadu_si256((const __m256i *)(_p))
+#define bstore(_p, _v) _mm256_storeu_si256((__m256i *)(_p), (_v))
+#define bmask(_m) _mm256_set1_epi64x((long long)(_m))
+#define bxor _mm256_xor_si256
+#define band _mm256_and_si256
+#define bor _mm256_or_si256
+#define bnot(_a) _mm256_xor_si256((_a), _mm256_set1_epi32(-1))
+#include "camellia_bitslice.h"
+#undef BVEC
+#undef WORDS
+#undef TARGET
+#undef NAME
+#undef bload
+#undef bstore
+#undef bmask
+#undef bxor
+#undef band
+#undef bor
+#undef bnot
+#endif  /* #if KERNEL_X86 */
+
+/* RFC 3713 規定のデータランダム化処理(ビットスライス, 64ブロック並行)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数
+ * inv: 0=順変換, 0以外=逆変換
+ */
+void camelliaDatarandBitslice(const uint8_t *m, const CamelliaData *data,
+                              uint8_t *c, size_t n, int inv ) {
+    datarandBitslice(m, data, c, n, inv);
+}
+
+/* 独立したブロック列のデータランダム化処理(ビットスライス, 64列並行, 列ごとに異なる変換テーブル)
+ * m[64][16*n]: RFC 3713 規定の変数M の並び
+ * data[64]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[64][16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[64][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+void camelliaDatarandMultiBitslice(const uint8_t *const *m,
+                                   const CamelliaData *const *data,
+                                   uint8_t *const *c, uint8_t *const *iv,
+                                   size_t n, int groups ) {
+    multiBitslice(m, data, c, iv, n, groups);
+}
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(ビットスライス, 64キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数(64の倍数でなくてもよい)
+ */
+void camelliaKeygenBitslice(const uint8_t *kl, const uint8_t *kr,
+                            uint8_t *ka, uint8_t *kb, size_t n ) {
+    keygenBitslice(kl, kr, ka, kb, n);
+}
+
+/* RFC 3713 規定のデータランダム化処理(ビットスライス, 8ブロック並行)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数
+ * inv: 0=順変換, 0以外=逆変換
+ */
+void camelliaDatarandBitsliceNarrow(const uint8_t *m, const CamelliaData *data,
+                                    uint8_t *c, size_t n, int inv ) {
+    uint64_t d1[NARROW_BLOCKS], d2[NARROW_BLOCKS];
+    const uint64_t *sk = data->sk;
+    size_t nb, b;
+    int groups;
+    int g, i, j;
+
+    groups = GROUPS(data);
+    for (; n > 0; n -= nb, m += 16 * nb, c += 16 * nb) {
+        nb = n < NARROW_BLOCKS ? n : NARROW_BLOCKS;
+        for (b = 0; b < nb; ++b) {
+            d1[b] = n8u64(m + 16 * b + 0) ^ sk[SKI(0, groups, inv)];
+            d2[b] = n8u64(m + 16 * b + 8) ^ sk[SKI(1, groups, inv)];
+        }
+        for (i = 2, g = 0; g < groups; ++g) {
+            if (g > 0) {
+                flNarrow(d1, d2, sk[SKI(i, groups, inv)], sk[SKI(i + 1, groups, inv)], nb);
+                i += 2;
+            }
+            for (j = 0; j < 6; j += 2, i += 2) {
+                fNarrow(d1, sk[SKI(i + 0, groups, inv)], d2, nb);
+                fNarrow(d2, sk[SKI(i + 1, groups, inv)], d1, nb);
+            }
+        }
+        for (b = 0; b < nb; ++b) {
+            u8n64_set(d2[b] ^ sk[SKI(i + 0, groups, inv)], c + 16 * b + 0);
+            u8n64_set(d1[b] ^ sk[SKI(i + 1, groups, inv)], c + 16 * b + 8);
+        }
+    }
+}
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(ビットスライス, 8キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数
+ */
+void camelliaKeygenBitsliceNarrow(const uint8_t *kl, const uint8_t *kr,
+                                  uint8_t *ka, uint8_t *kb, size_t n ) {
+    uint64_t l1[NARROW_BLOCKS], l2[NARROW_BLOCKS];
+    uint64_t r1[NARROW_BLOCKS], r2[NARROW_BLOCKS];
+    uint64_t d1[NARROW_BLOCKS], d2[NARROW_BLOCKS];
+    size_t nb, b;
+
+    for (; n > 0; n -= nb, kl += 16 * nb, kr += 16 * nb, ka += 16 * nb) {
+        nb = n < NARROW_BLOCKS ? n : NARROW_BLOCKS;
+        for (b = 0; b < nb; ++b) {
+            l1[b] = n8u64(kl + 16 * b + 0), l2[b] = n8u64(kl + 16 * b + 8);
+            r1[b] = n8u64(kr + 16 * b + 0), r2[b] = n8u64(kr + 16 * b + 8);
+            d1[b] = l1[b] ^ r1[b], d2[b] = l2[b] ^ r2[b];
+        }
+        fNarrow(d1, bitsliceSigma[0], d2, nb);
+        fNarrow(d2, bitsliceSigma[1], d1, nb);
+        for (b = 0; b < nb; ++b)
+            d1[b] ^= l1[b], d2[b] ^= l2[b];
+        fNarrow(d1, bitsliceSigma[2], d2, nb);
+        fNarrow(d2, bitsliceSigma[3], d1, nb);
+        for (b = 0; b < nb; ++b) {
+            u8n64_set(d1[b], ka + 16 * b + 0);
+            u8n64_set(d2[b], ka + 16 * b + 8);
+        }
+        if (kb != NULL) {
+            for (b = 0; b < nb; ++b)
+                d1[b] ^= r1[b], d2[b] ^= r2[b];
+            fNarrow(d1, bitsliceSigma[4], d2, nb);
+            fNarrow(d2, bitsliceSigma[5], d1, nb);
+            for (b = 0; b < nb; ++b) {
+                u8n64_set(d1[b], kb + 16 * b + 0);
+                u8n64_set(d2[b], kb + 16 * b + 8);
+            }
+            kb += 16 * nb;
+        }
+    }
+}
+
+#if KERNEL_X86
+/* RFC 3713 規定のデータランダム化処理(ビットスライス, SSE2 で128ブロック並行)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数
+ * inv: 0=順変換, 0以外=逆変換
+ */
+void camelliaDatarandBitsliceSse2(const uint8_t *m, const CamelliaData *data,
+                                  uint8_t *c, size_t n, int inv ) {
+    datarandBitsliceSse2(m, data, c, n, inv);
+}
+
+/* 独立したブロック列のデータランダム化処理(ビットスライス, SSE2 で128列並行, 列ごとに異なる変換テーブル)
+ * m[128][16*n]: RFC 3713 規定の変数M の並び
+ * data[128]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[128][16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[128][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+void camelliaDatarandMultiBitsliceSse2(const uint8_t *const *m,
+                                       const CamelliaData *const *data,
+                                       uint8_t *const *c, uint8_t *const *iv,
+                                       size_t n, int groups ) {
+    multiBitsliceSse2(m, data, c, iv, n, groups);
+}
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(ビットスライス, SSE2 で128キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数(128の倍数でなくてもよい)
+ */
+void camelliaKeygenBitsliceSse2(const uint8_t *kl, const uint8_t *kr,
+                                uint8_t *ka, uint8_t *kb, size_t n ) {
+    keygenBitsliceSse2(kl, kr, ka, kb, n);
+}
+
+/* RFC 3713 規定のデータランダム化処理(ビットスライス, AVX2 で256ブロック並行)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数
+ * inv: 0=順変換, 0以外=逆変換
+ */
+void camelliaDatarandBitsliceAvx2(const uint8_t *m, const CamelliaData *data,
+                                  uint8_t *c, size_t n, int inv ) {
+    datarandBitsliceAvx2(m, data, c, n, inv);
+}
+
+/* 独立したブロック列のデータランダム化処理(ビットスライス, AVX2 で256列並行, 列ごとに異なる変換テーブル)
+ * m[256][16*n]: RFC 3713 規定の変数M の並び
+ * data[256]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[256][16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[256][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+void camelliaDatarandMultiBitsliceAvx2(const uint8_t *const *m,
+                                       const CamelliaData *const *data,
+                                       uint8_t *const *c, uint8_t *const *iv,
+                                       size_t n, int groups ) {
+    multiBitsliceAvx2(m, data, c, iv, n, groups);
+}
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(ビットスライス, AVX2 で256キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数(256の倍数でなくてもよい)
+ */
+void camelliaKeygenBitsliceAvx2(const uint8_t *kl, const uint8_t *kr,
+                                uint8_t *ka, uint8_t *kb, size_t n ) {
+    keygenBitsliceAvx2(kl, kr, ka, kb, n);
+}
+#endif  /* #if KERNEL_X86 */
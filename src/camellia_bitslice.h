@@ -0,0 +1,446 @@
+/* camellia_bitslice.h - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - bitsliced constant-time kernel template.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* camellia_bitslice.c から以下のマクロを定義してベクトル幅ごとに取り込む
+ * BVEC: ビットスライスの型(各ビットが1ブロック)
+ * WORDS: BVEC に含まれる64ビット値の数(並行処理するブロック数は 64*WORDS)
+ * TARGET: 関数の target 属性
+ * NAME(_name): 関数名(ベクトル幅ごとに一意にする)
+ * bload(_p), bstore(_p, _v): 64ビット値 WORDS 個のロード/ストア
+ * bmask(_m): 64ビット値(0 または全ビット1)を全要素に複製
+ * bxor, band, bor, bnot: ビット演算
+ *
+ * S-box はテーブルを使わずに論理回路で求めるので, 処理時間がデータとキーに依存しない
+ * s1(x) = Lout(Inv(Lin(x))) (Lin, Lout はアフィン変換, Inv は GF((2^4)^2) の逆元)
+ * GF(2^4) は x^4+x+1, GF((2^4)^2) は y^2+y+x^3 で構成し,
+ * Lin, Lout は RFC 3713 の s1 との一致から求めた変換を XOR の並びにしたもの
+ */
+
+/* GF(2^4) の乗算(ビットスライス)
+ * a[4], b[4]: 乗数(x^0 の係数から)
+ * r[4]: 積
+ */
+static FORCE_INLINE TARGET void NAME(mul4)(const BVEC *a, const BVEC *b,
+                                           BVEC *r ) {
+    BVEC c0, c1, c2, c3, c4, c5, c6;
+
+    c0 = band(a[0], b[0]);
+    c1 = bxor(band(a[1], b[0]), band(a[0], b[1]));
+    c2 = bxor(bxor(band(a[2], b[0]), band(a[1], b[1])), band(a[0], b[2]));
+    c3 = bxor(bxor(band(a[3], b[0]), band(a[2], b[1])), bxor(band(a[1], b[2]), band(a[0], b[3])));
+    c4 = bxor(bxor(band(a[3], b[1]), band(a[2], b[2])), band(a[1], b[3]));
+    c5 = bxor(band(a[3], b[2]), band(a[2], b[3]));
+    c6 = band(a[3], b[3]);
+    r[0] = bxor(c0, c4);
+    r[1] = bxor(bxor(c1, c4), c5);
+    r[2] = bxor(bxor(c2, c5), c6);
+    r[3] = bxor(c3, c6);
+}
+
+/* GF(2^4) の逆元(ビットスライス, 0 の逆元は 0)
+ * 各ビットの代数標準形を共通項でまとめたもの
+ * a[4]: 値(x^0 の係数から)
+ * r[4]: a^-1
+ */
+static FORCE_INLINE TARGET void NAME(inv4)(const BVEC *a, BVEC *r) {
+    BVEC x01, p01, p02, p12, q;
+
+    x01 = bxor(a[0], a[1]);
+    p01 = band(a[0], a[1]), p02 = band(a[0], a[2]), p12 = band(a[1], a[2]);
+    q = band(a[2], x01);
+    r[0] = bxor(bxor(bxor(x01, a[2]), bxor(a[3], q)), band(p12, bxor(a[0], a[3])));
+    r[1] = bxor(bxor(bxor(a[3], q), p01), band(a[3], bxor(a[1], p01)));
+    r[2] = bxor(bxor(bxor(a[2], a[3]), bxor(p01, p02)), band(a[3], bxor(a[0], p02)));
+    r[3] = bxor(bxor(bxor(a[1], a[2]), a[3]), band(a[3], bxor(bxor(x01, a[2]), p12)));
+}
+
+/* GF((2^4)^2) の逆元(ビットスライス, 0 の逆元は 0)
+ * a[8]: 値(下位4ビット=y^0 の係数, 上位4ビット=y^1 の係数)
+ * r[8]: a^-1
+ */
+static FORCE_INLINE TARGET void NAME(inv8)(const BVEC *a, BVEC *r) {
+    const BVEC *a0 = a + 0, *a1 = a + 4;
+    BVEC d[4], e[4], t[4];
+    int i;
+
+    /* d = a1^2*x^3 + a1*a0 + a0^2 */
+    NAME(mul4)(a1, a0, d);
+    d[0] = bxor(bxor(d[0], bxor(a0[0], a0[2])), a1[2]);
+    d[1] = bxor(bxor(d[1], a0[2]), bxor(bxor(a1[1], a1[2]), a1[3]));
+    d[2] = bxor(bxor(d[2], bxor(a0[1], a0[3])), a1[1]);
+    d[3] = bxor(bxor(d[3], a0[3]), bxor(bxor(a1[0], a1[2]), a1[3]));
+    NAME(inv4)(d, e);
+    /* r = (a0 + a1)*e + a1*e*y */
+    for (i = 0; i < 4; ++i)
+        t[i] = bxor(a0[i], a1[i]);
+    NAME(mul4)(t, e, r + 0);
+    NAME(mul4)(a1, e, r + 4);
+}
+
+/* RFC 3713 規定の s1(ビットスライス)
+ * x[8]: 入力(最下位ビットから)
+ * y[8]: 出力(最下位ビットから)
+ */
+static FORCE_INLINE TARGET void NAME(sbox)(const BVEC *x, BVEC *y) {
+    BVEC t0, t1, t2, t3, t4;
+    BVEC u[8], z[8];
+
+    /* Lin */
+    t0 = bxor(x[3], x[4]);
+    t1 = bxor(x[1], x[5]);
+    t2 = bxor(x[2], t0);
+    t3 = bxor(x[6], x[7]);
+    t4 = bxor(t0, t1);
+    u[0] = bxor(bxor(x[0], x[1]), t2);
+    u[1] = x[4];
+    u[2] = bnot(t2);
+    u[3] = bnot(bxor(bxor(x[2], x[3]), x[5]));
+    u[4] = t4;
+    u[5] = bxor(t1, t3);
+    u[6] = bnot(bxor(x[6], t4));
+    u[7] = bxor(x[5], t3);
+    NAME(inv8)(u, z);
+    /* Lout */
+    t0 = bxor(z[3], z[5]);
+    t1 = bxor(z[0], z[7]);
+    t2 = bxor(z[2], t0);
+    t3 = bxor(z[4], z[6]);
+    t4 = bxor(z[1], t1);
+    y[0] = bxor(bxor(t1, t2), t3);
+    y[1] = bnot(t2);
+    y[2] = bnot(bxor(bxor(z[1], z[2]), t3));
+    y[3] = bnot(bxor(bxor(bxor(z[1], z[4]), z[7]), t0));
+    y[4] = bxor(t2, t4);
+    y[5] = bnot(bxor(z[5], t1));
+    y[6] = bnot(bxor(bxor(z[3], z[6]), t4));
+    y[7] = bxor(bxor(z[0], t0), t3);
+}
+
+/* RFC 3713 規定の s1 ～ s4 (ビットスライス, キーの排他的論理和を含む)
+ * s2(x) = s1(x) <<< 1, s3(x) = s1(x) >>> 1, s4(x) = s1(x <<< 1) はビットの並べ替えで求める
+ * x[8]: 入力(最下位ビットから)
+ * k[8]: サブキーの該当バイトのマスク
+ * t[8]: 出力(最下位ビットから)
+ * rin: 入力の左回転ビット数(s4 は1)
+ * rout: 出力の左回転ビット数(s2 は1, s3 は7)
+ */
+static FORCE_INLINE TARGET void NAME(sboxes)(const BVEC *x, const BVEC *k,
+                                             BVEC *t, int rin, int rout ) {
+    BVEC u[8], v[8];
+    int j;
+
+    for (j = 0; j < 8; ++j)
+        u[(j + rin) & 7] = bxor(x[j], k[j]);
+    NAME(sbox)(u, v);
+    for (j = 0; j < 8; ++j)
+        t[(j + rout) & 7] = v[j];
+}
+
+/* RFC 3713 規定のF関数によるラウンド処理(ビットスライス)
+ * x[64]: F関数の入力(最下位ビットから)
+ * y[64]: F関数の出力を排他的論理和する変数
+ * k[64]: サブキーのマスク
+ */
+static TARGET void NAME(feistel)(const BVEC *x, BVEC *y, const BVEC *k) {
+    BVEC t[8][8];
+    BVEC y1, y2, y3, y4, y5, y6, y7, y8;
+    int j;
+
+    NAME(sboxes)(x + 56, k + 56, t[0], 0, 0);  /* t1 = s1 */
+    NAME(sboxes)(x + 48, k + 48, t[1], 0, 1);  /* t2 = s2 */
+    NAME(sboxes)(x + 40, k + 40, t[2], 0, 7);  /* t3 = s3 */
+    NAME(sboxes)(x + 32, k + 32, t[3], 1, 0);  /* t4 = s4 */
+    NAME(sboxes)(x + 24, k + 24, t[4], 0, 1);  /* t5 = s2 */
+    NAME(sboxes)(x + 16, k + 16, t[5], 0, 7);  /* t6 = s3 */
+    NAME(sboxes)(x +  8, k +  8, t[6], 1, 0);  /* t7 = s4 */
+    NAME(sboxes)(x +  0, k +  0, t[7], 0, 0);  /* t8 = s1 */
+    for (j = 0; j < 8; ++j) {  /* P関数 */
+        y8 = bxor(bxor(bxor(t[0][j], t[3][j]), bxor(t[4][j], t[5][j])), t[6][j]);
+        y4 = bxor(bxor(y8, t[0][j]), bxor(t[1][j], t[2][j]));
+        y7 = bxor(bxor(y4, t[1][j]), bxor(t[6][j], t[7][j]));
+        y3 = bxor(bxor(y7, t[0][j]), bxor(t[1][j], t[3][j]));
+        y6 = bxor(bxor(y3, t[0][j]), bxor(t[5][j], t[6][j]));
+        y2 = bxor(bxor(y6, t[0][j]), bxor(t[2][j], t[3][j]));
+        y5 = bxor(bxor(y2, t[3][j]), bxor(t[4][j], t[5][j]));
+        y1 = bxor(bxor(y5, t[1][j]), bxor(t[2][j], t[3][j]));
+        y[56 + j] = bxor(y[56 + j], y1), y[48 + j] = bxor(y[48 + j], y2);
+        y[40 + j] = bxor(y[40 + j], y3), y[32 + j] = bxor(y[32 + j], y4);
+        y[24 + j] = bxor(y[24 + j], y5), y[16 + j] = bxor(y[16 + j], y6);
+        y[ 8 + j] = bxor(y[ 8 + j], y7), y[ 0 + j] = bxor(y[ 0 + j], y8);
+    }
+}
+
+/* RFC 3713 規定のFL関数とFLINV関数(ビットスライス)
+ * a[64]: FL関数で変換する変数
+ * b[64]: FLINV関数で変換する変数
+ * ka[64], kb[64]: サブキーのマスク
+ */
+static FORCE_INLINE TARGET void NAME(fl)(BVEC *a, BVEC *b,
+                                         const BVEC *ka, const BVEC *kb ) {
+    int j, r;
+
+    for (j = 0; j < 32; ++j) {  /* x2 ^= (x1 & k1) <<< 1 */
+        r = (j + 31) & 31;
+        a[j] = bxor(a[j], band(a[32 + r], ka[32 + r]));
+    }
+    for (j = 0; j < 32; ++j)  /* x1 ^= x2 | k2 */
+        a[32 + j] = bxor(a[32 + j], bor(a[j], ka[j]));
+    for (j = 0; j < 32; ++j)  /* y1 ^= y2 | k2 */
+        b[32 + j] = bxor(b[32 + j], bor(b[j], kb[j]));
+    for (j = 0; j < 32; ++j) {  /* y2 ^= (y1 & k1) <<< 1 */
+        r = (j + 31) & 31;
+        b[j] = bxor(b[j], band(b[32 + r], kb[32 + r]));
+    }
+}
+
+/* 64ビット値の並びとビットスライスの相互変換
+ * w[WORDS*64][2]: ブロックごとの変数(上位64ビット, 下位64ビット)
+ * s[128][WORDS]: ビットスライス(上位64ビットの最下位ビットから)
+ * load: 0以外=w から s へ, 0=s から w へ
+ */
+static FORCE_INLINE TARGET void NAME(slice)(uint64_t (*w)[2], uint64_t (*s)[WORDS],
+                                            int load ) {
+    uint64_t x[64];
+    int h, n, j;
+
+    for (h = 0; h < 2; ++h)
+        for (n = 0; n < WORDS; ++n) {
+            if (load) {
+                for (j = 0; j < 64; ++j)
+                    x[63 - j] = w[n * 64 + j][h];
+                transpose64(x);
+                for (j = 0; j < 64; ++j)
+                    s[h * 64 + j][n] = x[63 - j];
+            }
+            else {
+                for (j = 0; j < 64; ++j)
+                    x[63 - j] = s[h * 64 + j][n];
+                transpose64(x);
+                for (j = 0; j < 64; ++j)
+                    w[n * 64 + j][h] = x[63 - j];
+            }
+        }
+}
+
+/* 128ビット値の並びをビットスライスに変換(端数は0で埋める)
+ * p[16*n]: 128ビット値(ビッグエンディアン)の並び
+ * n: 値の数(64*WORDS 以下)
+ * x[128]: ビットスライス
+ */
+static FORCE_INLINE TARGET void NAME(load)(const uint8_t *p, size_t n, BVEC *x) {
+    uint64_t w[WORDS * 64][2];
+    uint64_t s[128][WORDS];
+    int j;
+
+    for (j = 0; j < WORDS * 64; ++j)
+        if ((size_t)j < n)
+            w[j][0] = n8u64(p + 16 * j + 0), w[j][1] = n8u64(p + 16 * j + 8);
+        else
+            w[j][0] = 0, w[j][1] = 0;
+    NAME(slice)(w, s, 1);
+    for (j = 0; j < 128; ++j)
+        x[j] = bload(s[j]);
+}
+
+/* ビットスライスを128ビット値の並びに変換
+ * x[128]: ビットスライス
+ * p[16*n]: 128ビット値(ビッグエンディアン)の並び
+ * n: 値の数(64*WORDS 以下)
+ */
+static FORCE_INLINE TARGET void NAME(store)(const BVEC *x, uint8_t *p, size_t n) {
+    uint64_t w[WORDS * 64][2];
+    uint64_t s[128][WORDS];
+    int j;
+
+    for (j = 0; j < 128; ++j)
+        bstore(s[j], x[j]);
+    NAME(slice)(w, s, 0);
+    for (j = 0; (size_t)j < n; ++j) {
+        u8n64_set(w[j][0], p + 16 * j + 0);
+        u8n64_set(w[j][1], p + 16 * j + 8);
+    }
+}
+
+/* RFC 3713 規定のデータランダム化処理の本体(ビットスライス)
+ * x[128]: M (処理後は C)
+ * km[34][64]: 使用順のサブキーのマスク
+ * groups: 6ラウンド単位のグループ数
+ */
+static FORCE_INLINE TARGET void NAME(walk)(BVEC *x, BVEC (*km)[64], int groups) {
+    BVEC *a = x + 0, *b = x + 64;
+    BVEC t;
+    int g, i, j;
+
+    for (j = 0; j < 64; ++j)
+        a[j] = bxor(a[j], km[0][j]), b[j] = bxor(b[j], km[1][j]);
+    for (g = 0, i = 2; g < groups; ++g) {
+        if (g > 0) {
+            NAME(fl)(a, b, km[i + 0], km[i + 1]);
+            i += 2;
+        }
+        for (j = 0; j < 6; j += 2, i += 2) {
+            NAME(feistel)(a, b, km[i + 0]);
+            NAME(feistel)(b, a, km[i + 1]);
+        }
+    }
+    for (j = 0; j < 64; ++j) {  /* C = (d2 ^ kw3, d1 ^ kw4) */
+        t = bxor(b[j], km[i + 0][j]);
+        b[j] = bxor(a[j], km[i + 1][j]);
+        a[j] = t;
+    }
+}
+
+/* RFC 3713 規定のデータランダム化処理(64*WORDS ブロック並行, 端数は0で埋めて処理する)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数
+ * inv: 0=順変換, 0以外=逆変換
+ */
+static TARGET void NAME(datarand)(const uint8_t *m, const CamelliaData *data,
+                                  uint8_t *c, size_t n, int inv ) {
+    BVEC km[34][64];  /* 使用順のサブキーのマスク(全ブロック共通) */
+    BVEC x[128];
+    size_t nb;
+    int groups;
+    int i, j;
+
+    groups = GROUPS(data);
+    for (i = 0; i < groups * 8 + 2; ++i)
+        for (j = 0; j < 64; ++j)
+            km[i][j] = bmask(-(data->sk[SKI(i, groups, inv)] >> j & 1));
+    for (; n > 0; n -= nb, m += 16 * nb, c += 16 * nb) {
+        nb = n < WORDS * 64 ? n : WORDS * 64;
+        NAME(load)(m, nb, x);
+        NAME(walk)(x, km, groups);
+        NAME(store)(x, c, nb);
+    }
+}
+
+/* 独立したブロック列のデータランダム化処理(64*WORDS 列並行, 列ごとに異なる変換テーブル)
+ * 列ごとのサブキーもビットスライスにして, 全ての列を同じ論理演算の並びで処理する
+ * m[64*WORDS][16*n]: RFC 3713 規定の変数M の並び
+ * data[64*WORDS]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[64*WORDS][16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[64*WORDS][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+static TARGET void NAME(multi)(const uint8_t *const *m,
+                               const CamelliaData *const *data,
+                               uint8_t *const *c, uint8_t *const *iv,
+                               size_t n, int groups ) {
+    uint64_t w[WORDS * 64][2];
+    uint64_t s[128][WORDS];
+    BVEC km[34][64];  /* 使用順のサブキーのマスク(列ごと) */
+    BVEC x[128], v[128];
+    size_t o;
+    int i, j;
+
+    for (i = 0; i < groups * 8 + 2; i += 2) {
+        for (j = 0; j < WORDS * 64; ++j)
+            w[j][0] = data[j]->sk[SKI(i + 0, groups, 0)], w[j][1] = data[j]->sk[SKI(i + 1, groups, 0)];
+        NAME(slice)(w, s, 1);
+        for (j = 0; j < 64; ++j)
+            km[i + 0][j] = bload(s[j]), km[i + 1][j] = bload(s[64 + j]);
+    }
+    if (iv != NULL) {  /* CBC モードの連鎖はビットスライスのまま排他的論理和する */
+        for (j = 0; j < WORDS * 64; ++j)
+            w[j][0] = n8u64(iv[j] + 0), w[j][1] = n8u64(iv[j] + 8);
+        NAME(slice)(w, s, 1);
+        for (j = 0; j < 128; ++j)
+            v[j] = bload(s[j]);
+    }
+    for (o = 0; o < 16 * n; o += 16) {
+        for (j = 0; j < WORDS * 64; ++j)
+            w[j][0] = n8u64(m[j] + o + 0), w[j][1] = n8u64(m[j] + o + 8);
+        NAME(slice)(w, s, 1);
+        for (j = 0; j < 128; ++j)
+            x[j] = iv != NULL ? bxor(bload(s[j]), v[j]) : bload(s[j]);
+        NAME(walk)(x, km, groups);
+        for (j = 0; j < 128; ++j)
+            bstore(s[j], x[j]);
+        NAME(slice)(w, s, 0);
+        for (j = 0; j < WORDS * 64; ++j) {
+            u8n64_set(w[j][0], c[j] + o + 0);
+            u8n64_set(w[j][1], c[j] + o + 8);
+        }
+        if (iv != NULL)
+            for (j = 0; j < 128; ++j)
+                v[j] = x[j];
+    }
+    if (iv != NULL) {
+        for (j = 0; j < 128; ++j)
+            bstore(s[j], v[j]);
+        NAME(slice)(w, s, 0);
+        for (j = 0; j < WORDS * 64; ++j) {
+            u8n64_set(w[j][0], iv[j] + 0);
+            u8n64_set(w[j][1], iv[j] + 8);
+        }
+    }
+}
+
+/* RFC 3713 規定の変数KA, KB の生成(64*WORDS キー並行, 端数は0で埋めて処理する)
+ * 定数 Sigma1 ～ Sigma6 をサブキーのマスクとしてF関数に渡す
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数
+ */
+static TARGET void NAME(keygen)(const uint8_t *kl, const uint8_t *kr,
+                                uint8_t *ka, uint8_t *kb, size_t n ) {
+    BVEC sigma[6][64];
+    BVEC l[128], r[128], x[128];
+    BVEC *a = x + 0, *b = x + 64;
+    size_t nb;
+    int i, j;
+
+    for (i = 0; i < 6; ++i)
+        for (j = 0; j < 64; ++j)
+            sigma[i][j] = bmask(-(bitsliceSigma[i] >> j & 1));
+    for (; n > 0; n -= nb, kl += 16 * nb, kr += 16 * nb, ka += 16 * nb) {
+        nb = n < WORDS * 64 ? n : WORDS * 64;
+        NAME(load)(kl, nb, l);
+        NAME(load)(kr, nb, r);
+        for (j = 0; j < 128; ++j)
+            x[j] = bxor(l[j], r[j]);
+        NAME(feistel)(a, b, sigma[0]);
+        NAME(feistel)(b, a, sigma[1]);
+        for (j = 0; j < 128; ++j)
+            x[j] = bxor(x[j], l[j]);
+        NAME(feistel)(a, b, sigma[2]);
+        NAME(feistel)(b, a, sigma[3]);
+        NAME(store)(x, ka, nb);
+        if (kb != NULL) {
+            for (j = 0; j < 128; ++j)
+                x[j] = bxor(x[j], r[j]);
+            NAME(feistel)(a, b, sigma[4]);
+            NAME(feistel)(b, a, sigma[5]);
+            NAME(store)(x, kb, nb);
+            kb += 16 * nb;
+        }
+    }
+}
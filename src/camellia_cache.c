@@ -0,0 +1,243 @@
+/* camellia_cache.c - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - key schedule cache.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "camellia.h"
+#include "camellia_cache.h"
+
+/* 変換テーブル領域のアライメント(キャッシュライン) */
+#define ALIGN 64
+
+/* キャッシュの要素
+ */
+typedef struct Entry Entry;
+struct Entry {  /* キャッシュの要素 */
+    CamelliaData data;      /* 変換テーブル (camelliaCacheRelease() で要素を求めるため先頭に置く) */
+    uint8_t k[32];          /* RFC 3713 規定の変数K */
+    uint64_t hash;          /* キー種別とキーのハッシュ値 */
+    Entry *next;            /* 同じハッシュバケットの次の要素, または次の空き要素 */
+    Entry *newer, *older;   /* LRU リストの前後の要素 */
+    unsigned refs;          /* 取得中の数 */
+};
+
+/* 変換テーブルのキャッシュ
+ */
+struct CamelliaCache {
+    pthread_mutex_t mutex;    /* 排他 */
+    Entry *slab;              /* 要素の領域 */
+    Entry **bucket;           /* ハッシュバケット */
+    size_t mask;              /* ハッシュバケット数-1 */
+    Entry *free;              /* 空き要素 */
+    Entry *newest, *oldest;   /* LRU リストの先頭(最近使用), 末尾 */
+    uint64_t seed;            /* ハッシュの種 */
+    CamelliaCacheStats stats; /* 統計 */
+};
+
+/* 最適化で省かれない0クリア */
+static void *(*const volatile wipe)(void *s, int c, size_t n) = memset;
+
+/* キーのバイト数
+ * 戻り値: 0以上=キーのバイト数, 0未満=未サポートな type を指定した
+ */
+static int keylen(CamelliaKeytype type) {
+    switch (type) {
+    case Camellia128Encrypt:
+    case Camellia128Decrypt:
+        return 16;
+    case Camellia192Encrypt:
+    case Camellia192Decrypt:
+        return 24;
+    case Camellia256Encrypt:
+    case Camellia256Decrypt:
+        return 32;
+    default:
+        return -1;
+    }
+}
+
+/* キー種別とキーのハッシュ値 */
+static uint64_t hash(uint64_t seed, CamelliaKeytype type, const uint8_t *k, int len) {
+    uint64_t h, w;
+    int n;
+
+    h = seed ^ (uint64_t)type * 0x9e3779b97f4a7c15;
+    for (n = 0; n < len; n += 8) {
+        memcpy(&w, k + n, sizeof(w));
+        h = (h ^ w) * 0xff51afd7ed558ccd;
+        h ^= h >> 29;
+    }
+    h *= 0xc4ceb9fe1a85ec53;
+    return h ^ h >> 32;
+}
+
+/* LRU リストから外す */
+static void detach(CamelliaCache *cache, Entry *e) {
+    *(e->newer != NULL ? &e->newer->older : &cache->newest) = e->older;
+    *(e->older != NULL ? &e->older->newer : &cache->oldest) = e->newer;
+}
+
+/* LRU リストの先頭に入れる */
+static void touch(CamelliaCache *cache, Entry *e) {
+    e->newer = NULL, e->older = cache->newest;
+    *(cache->newest != NULL ? &cache->newest->newer : &cache->oldest) = e;
+    cache->newest = e;
+}
+
+/* キャッシュの生成
+ * capacity: 保持できる変換テーブル数(1以上)
+ * 戻り値: キャッシュ (NULL=異常終了)
+ */
+CamelliaCache *camelliaCacheCreate(size_t capacity) {
+    CamelliaCache *cache = NULL;
+    struct timespec ts;
+    size_t n;
+
+    if (capacity == 0 || capacity > SIZE_MAX / sizeof(Entry) / 2)
+        goto error;
+    cache = calloc(1, sizeof(*cache));
+    if (cache == NULL)
+        goto error;
+    for (n = 1; n < capacity; n *= 2);
+    cache->mask = n - 1;
+    cache->bucket = calloc(n, sizeof(*cache->bucket));
+    if (cache->bucket == NULL || posix_memalign((void **)&cache->slab, ALIGN, capacity * sizeof(Entry))) {
+        free(cache->bucket);
+        free(cache), cache = NULL;
+        goto error;
+    }
+    memset(cache->slab, 0, capacity * sizeof(Entry));
+    for (n = capacity; n > 0; --n)
+        cache->slab[n - 1].next = cache->free, cache->free = &cache->slab[n - 1];
+    clock_gettime(CLOCK_REALTIME, &ts);
+    cache->seed = hash((uintptr_t)cache, ts.tv_sec, (const uint8_t *)&ts, sizeof(ts) / 8 * 8);
+    cache->stats.capacity = capacity;
+    pthread_mutex_init(&cache->mutex, NULL);
+error:
+    return cache;
+}
+
+/* キャッシュの破棄(保持している全てのキーと変換テーブルを消去する)
+ * cache: キャッシュ (NULL の場合は何もしない)
+ */
+void camelliaCacheDestroy(CamelliaCache *cache) {
+    if (cache == NULL)
+        return;
+    wipe(cache->slab, 0, cache->stats.capacity * sizeof(Entry));
+    pthread_mutex_destroy(&cache->mutex);
+    free(cache->slab);
+    free(cache->bucket);
+    free(cache);
+}
+
+/* 変換テーブルの取得
+ * 取得した変換テーブルは camelliaCacheRelease() するまで消去されない
+ * cache: キャッシュ
+ * type: 暗号/復号キー種別 (Camellia128Encrypt ～ Camellia256Decrypt)
+ * k[n]: RFC 3713 規定の変数K (n は camelliaKeysche() と同じ)
+ * 戻り値: 変換テーブル (NULL=異常終了(未サポートな type を指定した, 全ての変換テーブルが取得中))
+ */
+const CamelliaData *camelliaCacheGet(CamelliaCache *cache,
+                                     CamelliaKeytype type,
+                                     const uint8_t *k ) {
+    const CamelliaData *data = NULL;
+    Entry *e, **p;
+    uint64_t h;
+    int len;
+
+    if ((len = keylen(type)) < 0)
+        return NULL;
+    pthread_mutex_lock(&cache->mutex);
+    h = hash(cache->seed, type, k, len);
+    for (e = cache->bucket[h & cache->mask]; e != NULL; e = e->next)
+        if (e->hash == h && e->data.type == type && !memcmp(e->k, k, len))
+            break;
+    if (e != NULL) {  /* キャッシュにあった */
+        ++cache->stats.hits;
+        detach(cache, e);
+    }
+    else {  /* キャッシュになかった: 空き要素または最も長く使われていない要素を使う */
+        ++cache->stats.misses;
+        if ((e = cache->free) != NULL)
+            cache->free = e->next, ++cache->stats.entries;
+        else {
+            for (e = cache->oldest; e != NULL && e->refs > 0; e = e->newer);
+            if (e == NULL)
+                goto error;
+            for (p = &cache->bucket[e->hash & cache->mask]; *p != e; p = &(*p)->next);
+            *p = e->next;
+            detach(cache, e);
+            wipe(e, 0, sizeof(*e));
+            ++cache->stats.evictions;
+        }
+        switch (type) {
+        case Camellia128Decrypt:
+        case Camellia192Decrypt:
+        case Camellia256Decrypt:
+            camelliaKeysche((CamelliaKeytype)(type - 1), k, &e->data);  /* 対応する暗号キー種別 */
+            camelliaKeyswap(&e->data);
+            break;
+        default:
+            camelliaKeysche(type, k, &e->data);
+            break;
+        }
+        memcpy(e->k, k, len);
+        e->hash = h;
+        e->next = cache->bucket[h & cache->mask], cache->bucket[h & cache->mask] = e;
+    }
+    touch(cache, e);
+    ++e->refs;
+    data = &e->data;
+error:
+    pthread_mutex_unlock(&cache->mutex);
+    return data;
+}
+
+/* 変換テーブルの返却
+ * cache: キャッシュ
+ * data: camelliaCacheGet() で取得した変換テーブル
+ */
+void camelliaCacheRelease(CamelliaCache *cache, const CamelliaData *data) {
+    Entry *e = (Entry *)data;
+
+    pthread_mutex_lock(&cache->mutex);
+    --e->refs;
+    pthread_mutex_unlock(&cache->mutex);
+}
+
+/* キャッシュの統計を取得
+ * cache: キャッシュ
+ * stats: キャッシュの統計
+ */
+void camelliaCacheStats(CamelliaCache *cache, CamelliaCacheStats *stats) {
+    pthread_mutex_lock(&cache->mutex);
+    *stats = cache->stats;
+    pthread_mutex_unlock(&cache->mutex);
+}
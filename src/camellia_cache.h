@@ -0,0 +1,95 @@
+/* camellia_cache.h - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - key schedule cache.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _INCLUDE_camellia_cache_h
+#define _INCLUDE_camellia_cache_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camellia.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* #ifdef __cplusplus */
+
+/* 変換テーブルのキャッシュ
+ * キー種別とキーの組ごとにキースケジューリング処理(復号キーは変換も)した変換テーブルを保持し,
+ * 同じキーの2回目以降はキースケジューリング処理を省く
+ * 変換テーブルは生成時に確保した領域から割り当て, 一杯の場合は最も長く使われていないものを
+ * 消去(キーと変換テーブルの領域を0で上書き)して再利用する
+ * 複数のスレッドから同時に呼び出してよい
+ */
+typedef struct CamelliaCache CamelliaCache;  /* 変換テーブルのキャッシュ */
+
+/* キャッシュの統計
+ */
+typedef struct {  /* キャッシュの統計 */
+    uint64_t hits;       /* キャッシュにあった回数 */
+    uint64_t misses;     /* キャッシュになかった回数(キースケジューリング処理した回数) */
+    uint64_t evictions;  /* 変換テーブルを消去して再利用した回数 */
+    size_t entries;      /* 保持している変換テーブル数 */
+    size_t capacity;     /* 保持できる変換テーブル数 */
+} CamelliaCacheStats;
+
+/* キャッシュの生成
+ * capacity: 保持できる変換テーブル数(1以上)
+ * 戻り値: キャッシュ (NULL=異常終了)
+ */
+extern CamelliaCache *camelliaCacheCreate(size_t capacity);
+
+/* キャッシュの破棄(保持している全てのキーと変換テーブルを消去する)
+ * cache: キャッシュ (NULL の場合は何もしない)
+ */
+extern void camelliaCacheDestroy(CamelliaCache *cache);
+
+/* 変換テーブルの取得
+ * 取得した変換テーブルは camelliaCacheRelease() するまで消去されない
+ * cache: キャッシュ
+ * type: 暗号/復号キー種別 (Camellia128Encrypt ～ Camellia256Decrypt)
+ * k[n]: RFC 3713 規定の変数K (n は camelliaKeysche() と同じ)
+ * 戻り値: 変換テーブル (NULL=異常終了(未サポートな type を指定した, 全ての変換テーブルが取得中))
+ */
+extern const CamelliaData *camelliaCacheGet(CamelliaCache *cache,
+                                            CamelliaKeytype type,
+                                            const uint8_t *k );
+
+/* 変換テーブルの返却
+ * cache: キャッシュ
+ * data: camelliaCacheGet() で取得した変換テーブル
+ */
+extern void camelliaCacheRelease(CamelliaCache *cache, const CamelliaData *data);
+
+/* キャッシュの統計を取得
+ * cache: キャッシュ
+ * stats: キャッシュの統計
+ */
+extern void camelliaCacheStats(CamelliaCache *cache, CamelliaCacheStats *stats);
+
+#ifdef __cplusplus
+}
+#endif  /* #ifdef __cplusplus */
+
+#endif  /* #ifndef _INCLUDE_camellia_cache_h */
@@ -0,0 +1,168 @@
+/* camellia_cbc.c - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - CBC mode.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "camellia.h"
+#include "camellia_kernel.h"
+#include "camellia_cbc.h"
+
+/* 複数ストリーム処理で同時に扱うストリーム数(カーネルの最大の並行数) */
+#define STREAMS 256
+
+/* 変換テーブルのキー種別を確認
+ * data: 変換テーブル
+ * dec: 0=暗号キーのみ受け付ける, 0以外=復号キーも受け付ける
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+static int check(const CamelliaData *data, int dec) {
+    int status = -1;
+
+    switch (data->type) {
+    case Camellia128Encrypt:
+    case Camellia192Encrypt:
+    case Camellia256Encrypt:
+        break;
+    case Camellia128Decrypt:
+    case Camellia192Decrypt:
+    case Camellia256Decrypt:
+        if (!dec)
+            goto error;
+        break;
+    default:
+        goto error;
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* CBC モードの暗号化
+ * パディングは行わないので呼び出し側で16バイトの倍数にすること
+ * data: 変換テーブル(暗号キー)
+ * iv[16]: 初期化ベクタ(処理後は最後の暗号文ブロックに更新するので続きを処理できる)
+ * in[16*n]: 平文
+ * out[16*n]: 暗号文 (in と同一領域も可)
+ * n: ブロック数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaCbcEncrypt(const CamelliaData *data, uint8_t *iv,
+                       const uint8_t *in, uint8_t *out, size_t n ) {
+    int status = -1;
+
+    if (check(data, 0) < 0)
+        goto error;
+    while (n > 0) {
+        camelliaXor(out, in, iv, 16);
+        camelliaDatarand(out, data, out);
+        memcpy(iv, out, 16);
+        in += 16, out += 16, --n;
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* CBC モードの復号
+ * ブロック間に依存がないので複数ブロック一括処理のカーネルで並行処理する
+ * data: 変換テーブル(暗号キーまたは復号キー, 暗号キーの場合は逆変換で復号する)
+ * iv[16]: 初期化ベクタ(処理後は最後の暗号文ブロックに更新するので続きを処理できる)
+ * in[16*n]: 暗号文
+ * out[16*n]: 平文 (in と同一領域も可)
+ * n: ブロック数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaCbcDecrypt(const CamelliaData *data, uint8_t *iv,
+                       const uint8_t *in, uint8_t *out, size_t n ) {
+    int status = -1;
+    uint8_t buf[16 * BATCH_BLOCKS];
+    uint8_t last[16];
+    size_t nb, i;
+
+    if (check(data, 1) < 0)
+        goto error;
+    while (n > 0) {
+        nb = n < BATCH_BLOCKS ? n : BATCH_BLOCKS;
+        memcpy(last, in + 16 * (nb - 1), 16);
+        camelliaDecryptBulk(in, data, buf, nb);
+        if (out != in)
+            camelliaXor(out + 16, buf + 16, in, 16 * (nb - 1));
+        else  /* 直前の暗号文ブロックを上書きしないよう後ろから処理 */
+            for (i = nb - 1; i > 0; --i)
+                camelliaXor(out + 16 * i, buf + 16 * i, in + 16 * (i - 1), 16);
+        camelliaXor(out, buf, iv, 16);
+        memcpy(iv, last, 16);
+        in += 16 * nb, out += 16 * nb, n -= nb;
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* 複数の独立した CBC ストリームの暗号化
+ * 各ストリームを列として選択中のカーネルで並行処理し, 連鎖はカーネル内で行う
+ * (各列のサブキーの並べ替えは, 残りブロック数が最小のストリームが終わるまで使い回す)
+ * (ストリームごとにキー, 初期化ベクタ, ブロック数が異なってもよい)
+ * stream[n]: CBC モード ストリーム
+ * n: ストリーム数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaCbcEncryptStreams(CamelliaCbcStream *stream, size_t n) {
+    int status = -1;
+    const uint8_t *m[STREAMS];
+    const CamelliaData *data[STREAMS];
+    uint8_t *c[STREAMS];
+    uint8_t *iv[STREAMS];
+    CamelliaCbcStream *s;
+    size_t ns, na, nb, i, j;
+
+    for (j = 0; j < n; ++j)
+        if (check(stream[j].data, 0) < 0)
+            goto error;
+    while (n > 0) {
+        ns = n < STREAMS ? n : STREAMS;
+        for (i = 0; ; i += nb) {  /* i: 処理済みのブロック数 */
+            nb = 0;
+            for (j = 0, na = 0; j < ns; ++j) {
+                s = &stream[j];
+                if (i >= s->n)
+                    continue;
+                m[na] = s->in + 16 * i, data[na] = s->data, c[na] = s->out + 16 * i, iv[na] = s->iv;
+                if (na == 0 || s->n - i < nb)
+                    nb = s->n - i;
+                ++na;
+            }
+            if (na == 0)
+                break;
+            camelliaDatarandMulti(m, data, c, iv, na, nb);
+        }
+        stream += ns, n -= ns;
+    }
+    status = 0;
+error:
+    return status;
+}
@@ -0,0 +1,85 @@
+/* camellia_cbc.h - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - CBC mode.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _INCLUDE_camellia_cbc_h
+#define _INCLUDE_camellia_cbc_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camellia.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* #ifdef __cplusplus */
+
+/* CBC モード 複数ストリーム処理の単位
+ */
+typedef struct {  /* CBC モード ストリーム */
+    const CamelliaData *data;  /* 変換テーブル(暗号キー) */
+    uint8_t iv[16];            /* 初期化ベクタ(処理後は最後の暗号文ブロックに更新) */
+    const uint8_t *in;         /* 平文 in[16*n] */
+    uint8_t *out;              /* 暗号文 out[16*n] (in と同一領域も可) */
+    size_t n;                  /* ブロック数 */
+} CamelliaCbcStream;
+
+/* CBC モードの暗号化
+ * パディングは行わないので呼び出し側で16バイトの倍数にすること
+ * data: 変換テーブル(暗号キー)
+ * iv[16]: 初期化ベクタ(処理後は最後の暗号文ブロックに更新するので続きを処理できる)
+ * in[16*n]: 平文
+ * out[16*n]: 暗号文 (in と同一領域も可)
+ * n: ブロック数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaCbcEncrypt(const CamelliaData *data, uint8_t *iv,
+                              const uint8_t *in, uint8_t *out, size_t n );
+
+/* CBC モードの復号
+ * ブロック間に依存がないので複数ブロック一括処理のカーネルで並行処理する
+ * data: 変換テーブル(暗号キーまたは復号キー, 暗号キーの場合は逆変換で復号する)
+ * iv[16]: 初期化ベクタ(処理後は最後の暗号文ブロックに更新するので続きを処理できる)
+ * in[16*n]: 暗号文
+ * out[16*n]: 平文 (in と同一領域も可)
+ * n: ブロック数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaCbcDecrypt(const CamelliaData *data, uint8_t *iv,
+                              const uint8_t *in, uint8_t *out, size_t n );
+
+/* 複数の独立した CBC ストリームの暗号化
+ * 各ストリームのブロックを交互に並行処理してブロック間の依存を隠す
+ * (ストリームごとにキー, 初期化ベクタ, ブロック数が異なってもよい)
+ * stream[n]: CBC モード ストリーム
+ * n: ストリーム数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaCbcEncryptStreams(CamelliaCbcStream *stream, size_t n);
+
+#ifdef __cplusplus
+}
+#endif  /* #ifdef __cplusplus */
+
+#endif  /* #ifndef _INCLUDE_camellia_cbc_h */
@@ -0,0 +1,400 @@
+/* camellia_ccm.c - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - CCM mode (RFC 5528).
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "camellia.h"
+#include "camellia_kernel.h"
+#include "camellia_ccm.h"
+
+/* CBC-MAC にデータを追加
+ * 16バイトたまったブロックは次の入力まで処理を遅らせ, 汎用カーネルで CTR と組にできるようにする
+ * ccm: CCM モード 状態
+ * in[len]: データ
+ * len: in のバイト数
+ */
+static void macAdd(CamelliaCcm *ccm, const uint8_t *in, size_t len) {
+    size_t n;
+
+    while (len > 0) {
+        if (ccm->nbuf == 16) {
+            camelliaXor(ccm->x, ccm->x, ccm->buf, 16);
+            camelliaDatarand(ccm->x, ccm->data, ccm->x);
+            ccm->nbuf = 0;
+        }
+        if (ccm->nbuf == 0)  /* ブロック単位のデータはバッファを経由しない */
+            for (; len > 16; in += 16, len -= 16) {
+                camelliaXor(ccm->x, ccm->x, in, 16);
+                camelliaDatarand(ccm->x, ccm->data, ccm->x);
+            }
+        n = 16 - ccm->nbuf;
+        if (n > len)
+            n = len;
+        memcpy(ccm->buf + ccm->nbuf, in, n);
+        ccm->nbuf += n, in += n, len -= n;
+    }
+}
+
+/* CBC-MAC の未処理データを0でパディングしてブロック境界に揃える
+ * ccm: CCM モード 状態
+ */
+static void macPad(CamelliaCcm *ccm) {
+    if (ccm->nbuf > 0 && ccm->nbuf < 16) {
+        memset(ccm->buf + ccm->nbuf, 0, 16 - ccm->nbuf);
+        ccm->nbuf = 16;
+    }
+}
+
+/* CCM モードの開始
+ * AAD と平文のバイト数は開始時に確定している必要がある
+ * ccm: CCM モード 状態
+ * data: 変換テーブル(暗号キー, 処理中は参照し続けるので解放しないこと)
+ *  (type=Camellia128Encrypt, Camellia192Encrypt or Camellia256Encrypt, 復号も暗号キーで行う)
+ * nonce[noncelen]: ナンス
+ * noncelen: nonce のバイト数(7-13)
+ * alen: AAD のバイト数
+ * plen: 平文のバイト数(2^(8*(15-noncelen)) 未満)
+ * taglen: 認証タグのバイト数(4, 6, 8, 10, 12, 14 or 16)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type, noncelen, plen または taglen を指定した)
+ */
+int camelliaCcmInit(CamelliaCcm *ccm, const CamelliaData *data,
+                    const uint8_t *nonce, size_t noncelen,
+                    uint64_t alen, uint64_t plen, size_t taglen ) {
+    int status = -1;
+    uint8_t b0[16];
+    uint8_t a[10];
+    unsigned width, n;
+
+    switch (data->type) {
+    case Camellia128Encrypt:
+    case Camellia192Encrypt:
+    case Camellia256Encrypt:
+        break;
+    default:
+        goto error;
+    }
+    if (noncelen < 7 || noncelen > 13)
+        goto error;
+    if (taglen < 4 || taglen > 16 || taglen % 2 != 0)
+        goto error;
+    width = 15 - noncelen;
+    if (width < 8 && plen >> width * 8 != 0)
+        goto error;
+    b0[0] = (alen > 0 ? 0x40 : 0x00) | (taglen - 2) / 2 << 3 | (width - 1);  /* B_0 = Flags | Nonce | l(m) */
+    memcpy(b0 + 1, nonce, noncelen);
+    for (n = 0; n < width; ++n)
+        b0[15 - n] = plen >> n * 8;
+    ccm->ctr[0] = width - 1;  /* A_i = Flags | Nonce | i */
+    memcpy(ccm->ctr + 1, nonce, noncelen);
+    memset(ccm->ctr + 1 + noncelen, 0, width);
+    camelliaCounter(ccm->ctr, width, ccm->s0, 1);
+    if (camelliaDatarand(b0, data, ccm->x) < 0)
+        goto error;
+    camelliaDatarand(ccm->s0, data, ccm->s0);
+    ccm->data = data;
+    ccm->nbuf = 0;
+    ccm->used = 16;
+    ccm->width = width;
+    ccm->taglen = taglen;
+    ccm->alen = alen, ccm->plen = plen;
+    ccm->phase = 0;
+    if (alen > 0) {  /* AAD のバイト数の符号化 */
+        if (alen < 0xff00)
+            a[0] = alen >> 8, a[1] = alen, n = 2;
+        else if (alen >> 32 == 0) {
+            a[0] = 0xff, a[1] = 0xfe, n = 6;
+            a[2] = alen >> 24, a[3] = alen >> 16, a[4] = alen >> 8, a[5] = alen;
+        }
+        else {
+            a[0] = 0xff, a[1] = 0xff, n = 10;
+            u8n64_set(alen, a + 2);
+        }
+        macAdd(ccm, a, n);
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* CCM モードの追加認証データ(AAD)入力
+ * 暗号化/復号の開始前に何回かに分けて入力できる
+ * ccm: CCM モード 状態
+ * aad[len]: 追加認証データ
+ * len: aad のバイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(暗号化/復号の開始後に呼び出した, または開始時のバイト数を超えた)
+ */
+int camelliaCcmAad(CamelliaCcm *ccm, const uint8_t *aad, size_t len) {
+    int status = -1;
+
+    if (ccm->phase != 0 || len > ccm->alen)
+        goto error;
+    ccm->alen -= len;
+    macAdd(ccm, aad, len);
+    status = 0;
+error:
+    return status;
+}
+
+/* AAD の入力を終えて暗号化/復号を開始
+ * ccm: CCM モード 状態
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(AAD が不足, または終了後に呼び出した)
+ */
+static int ccmStart(CamelliaCcm *ccm) {
+    int status = -1;
+
+    if (ccm->phase == 0) {
+        if (ccm->alen > 0)
+            goto error;
+        macPad(ccm);
+        ccm->phase = 1;
+    }
+    if (ccm->phase != 1)
+        goto error;
+    status = 0;
+error:
+    return status;
+}
+
+/* CCM モードの暗号化/復号
+ * 汎用カーネルでは CTR の鍵ストリームのブロックと CBC-MAC の直前のブロックを組にして2ブロック並行で処理し,
+ * CBC-MAC の連鎖の待ち時間を CTR の処理で埋める
+ * その他のカーネルでは CTR の鍵ストリームを複数ブロック一括で生成してから CBC-MAC を処理する
+ * ccm: CCM モード 状態
+ * in[len]: 入力
+ * out[len]: 出力 (in と同一領域も可)
+ * len: バイト数
+ * dec: 0=暗号化, 0以外=復号
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(AAD が不足, 終了後に呼び出した, または開始時のバイト数を超えた)
+ */
+static int ccmCrypt(CamelliaCcm *ccm, const uint8_t *in, uint8_t *out,
+                    size_t len, int dec ) {
+    int status = -1;
+    uint8_t ks[16 * BATCH_BLOCKS];
+    uint8_t p[16];
+    size_t n;
+
+    if (ccmStart(ccm) < 0)
+        goto error;
+    if (len > ccm->plen)
+        goto error;
+    ccm->plen -= len;
+    for (; len > 0 && ccm->used < 16; ++in, ++out, --len) {  /* 鍵ストリームの残り */
+        p[0] = dec ? *in ^ ccm->ks[ccm->used] : *in;
+        *out = *in ^ ccm->ks[ccm->used++];
+        macAdd(ccm, p, 1);
+    }
+    if (camelliaKernelCurrent() == CamelliaKernelGeneric)
+        for (; len >= 16; in += 16, out += 16, len -= 16) {
+            camelliaCounter(ccm->ctr, ccm->width, ks, 1);
+            if (ccm->nbuf == 16) {
+                camelliaXor(ccm->x, ccm->x, ccm->buf, 16);
+                camelliaDatarandPair(ccm->x, ks, ccm->data, ccm->x, ks);
+            }
+            else
+                camelliaDatarand(ks, ccm->data, ks);
+            if (dec) {
+                camelliaXor(out, in, ks, 16);
+                memcpy(ccm->buf, out, 16);
+            }
+            else {
+                memcpy(ccm->buf, in, 16);
+                camelliaXor(out, in, ks, 16);
+            }
+            ccm->nbuf = 16;
+        }
+    else
+        while (len >= 16) {
+            n = len / 16 < BATCH_BLOCKS ? len / 16 : BATCH_BLOCKS;
+            camelliaCounter(ccm->ctr, ccm->width, ks, n);
+            camelliaDatarandBulk(ks, ccm->data, ks, n);
+            if (!dec)
+                macAdd(ccm, in, 16 * n);
+            camelliaXor(out, in, ks, 16 * n);
+            if (dec)
+                macAdd(ccm, out, 16 * n);
+            in += 16 * n, out += 16 * n, len -= 16 * n;
+        }
+    if (len > 0) {  /* 端数バイト */
+        camelliaCounter(ccm->ctr, ccm->width, ccm->ks, 1);
+        camelliaDatarand(ccm->ks, ccm->data, ccm->ks);
+        ccm->used = 0;
+        for (; len > 0; ++in, ++out, --len) {
+            p[0] = dec ? *in ^ ccm->ks[ccm->used] : *in;
+            *out = *in ^ ccm->ks[ccm->used++];
+            macAdd(ccm, p, 1);
+        }
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* CCM モードの暗号化
+ * 何回かに分けて入力できる
+ * ccm: CCM モード 状態
+ * in[len]: 平文
+ * out[len]: 暗号文 (in と同一領域も可)
+ * len: バイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(AAD が不足, 終了後に呼び出した, または開始時のバイト数を超えた)
+ */
+int camelliaCcmEncrypt(CamelliaCcm *ccm, const uint8_t *in,
+                       uint8_t *out, size_t len ) {
+    return ccmCrypt(ccm, in, out, len, 0);
+}
+
+/* CCM モードの復号
+ * 何回かに分けて入力できる
+ * 認証タグを camelliaCcmVerify で確認するまで出力を信用しないこと
+ * ccm: CCM モード 状態
+ * in[len]: 暗号文
+ * out[len]: 平文 (in と同一領域も可)
+ * len: バイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(AAD が不足, 終了後に呼び出した, または開始時のバイト数を超えた)
+ */
+int camelliaCcmDecrypt(CamelliaCcm *ccm, const uint8_t *in,
+                       uint8_t *out, size_t len ) {
+    return ccmCrypt(ccm, in, out, len, 1);
+}
+
+/* CCM モードの終了と認証タグの生成
+ * ccm: CCM モード 状態
+ * tag[taglen]: 認証タグ(taglen は開始時に指定したバイト数)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(終了後に呼び出した, または入力が開始時のバイト数に足りない)
+ */
+int camelliaCcmFinal(CamelliaCcm *ccm, uint8_t *tag) {
+    int status = -1;
+
+    if (ccmStart(ccm) < 0)
+        goto error;
+    if (ccm->plen > 0)
+        goto error;
+    macPad(ccm);
+    if (ccm->nbuf == 16) {
+        camelliaXor(ccm->x, ccm->x, ccm->buf, 16);
+        camelliaDatarand(ccm->x, ccm->data, ccm->x);
+        ccm->nbuf = 0;
+    }
+    camelliaXor(tag, ccm->x, ccm->s0, ccm->taglen);
+    ccm->phase = 2;
+    status = 0;
+error:
+    return status;
+}
+
+/* CCM モードの終了と認証タグの検証
+ * ccm: CCM モード 状態
+ * tag[taglen]: 受信した認証タグ(taglen は開始時に指定したバイト数)
+ * 戻り値: 0以上=認証成功, 0未満=認証失敗または異常終了
+ */
+int camelliaCcmVerify(CamelliaCcm *ccm, const uint8_t *tag) {
+    int status = -1;
+    uint8_t t[16];
+    uint8_t d;
+    size_t n;
+
+    if (camelliaCcmFinal(ccm, t) < 0)
+        goto error;
+    d = 0;
+    for (n = 0; n < ccm->taglen; ++n)
+        d |= t[n] ^ tag[n];
+    if (d != 0)
+        goto error;
+    status = 0;
+error:
+    return status;
+}
+
+/* CCM モードの暗号化と認証タグの生成(一括)
+ * data: 変換テーブル(暗号キー)
+ * nonce[noncelen]: ナンス
+ * noncelen: nonce のバイト数(7-13)
+ * aad[alen]: 追加認証データ
+ * alen: aad のバイト数
+ * in[len]: 平文
+ * out[len]: 暗号文 (in と同一領域も可)
+ * len: バイト数
+ * tag[taglen]: 認証タグ
+ * taglen: 認証タグのバイト数(4, 6, 8, 10, 12, 14 or 16)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type, noncelen, len または taglen を指定した)
+ */
+int camelliaCcmSeal(const CamelliaData *data,
+                    const uint8_t *nonce, size_t noncelen,
+                    const uint8_t *aad, size_t alen,
+                    const uint8_t *in, uint8_t *out, size_t len,
+                    uint8_t *tag, size_t taglen ) {
+    int status = -1;
+    CamelliaCcm ccm;
+
+    if (camelliaCcmInit(&ccm, data, nonce, noncelen, alen, len, taglen) < 0)
+        goto error;
+    if (camelliaCcmAad(&ccm, aad, alen) < 0)
+        goto error;
+    if (camelliaCcmEncrypt(&ccm, in, out, len) < 0)
+        goto error;
+    if (camelliaCcmFinal(&ccm, tag) < 0)
+        goto error;
+    status = 0;
+error:
+    return status;
+}
+
+/* CCM モードの復号と認証タグの検証(一括)
+ * 認証に失敗した場合は out を0で消去する
+ * data: 変換テーブル(暗号キー)
+ * nonce[noncelen]: ナンス
+ * noncelen: nonce のバイト数(7-13)
+ * aad[alen]: 追加認証データ
+ * alen: aad のバイト数
+ * in[len]: 暗号文
+ * out[len]: 平文 (in と同一領域も可)
+ * len: バイト数
+ * tag[taglen]: 受信した認証タグ
+ * taglen: 認証タグのバイト数(4, 6, 8, 10, 12, 14 or 16)
+ * 戻り値: 0以上=認証成功, 0未満=認証失敗または異常終了
+ */
+int camelliaCcmOpen(const CamelliaData *data,
+                    const uint8_t *nonce, size_t noncelen,
+                    const uint8_t *aad, size_t alen,
+                    const uint8_t *in, uint8_t *out, size_t len,
+                    const uint8_t *tag, size_t taglen ) {
+    int status = -1;
+    CamelliaCcm ccm;
+
+    if (camelliaCcmInit(&ccm, data, nonce, noncelen, alen, len, taglen) < 0)
+        goto error;
+    if (camelliaCcmAad(&ccm, aad, alen) < 0)
+        goto error;
+    if (camelliaCcmDecrypt(&ccm, in, out, len) < 0)
+        goto error;
+    if (camelliaCcmVerify(&ccm, tag) < 0) {
+        memset(out, 0, len);
+        goto error;
+    }
+    status = 0;
+error:
+    return status;
+}
@@ -0,0 +1,160 @@
+/* camellia_ccm.h - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - CCM mode (RFC 5528).
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _INCLUDE_camellia_ccm_h
+#define _INCLUDE_camellia_ccm_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camellia.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* #ifdef __cplusplus */
+
+/* CCM モード 状態
+ */
+typedef struct {  /* CCM モード 状態 */
+    const CamelliaData *data;  /* 変換テーブル(暗号キー) */
+    uint8_t x[16];             /* CBC-MAC 途中結果 */
+    uint8_t buf[16];           /* CBC-MAC 未処理データ(16バイトの場合は次の入力時に処理) */
+    uint8_t ctr[16];           /* 次に使うカウンタブロック */
+    uint8_t s0[16];            /* 認証タグを暗号化する鍵ストリーム */
+    uint8_t ks[16];            /* 鍵ストリームの残り */
+    unsigned nbuf;             /* buf のバイト数 */
+    unsigned used;             /* ks の使用済みバイト数 */
+    unsigned width;            /* カウンタのバイト数(RFC 3610 規定の L) */
+    unsigned taglen;           /* 認証タグのバイト数(RFC 3610 規定の M) */
+    uint64_t alen, plen;       /* AAD, 平文の残りのバイト数 */
+    int phase;                 /* 0=AAD 入力中, 1=暗号化/復号中, 2=終了 */
+} CamelliaCcm;
+
+/* CCM モードの開始
+ * AAD と平文のバイト数は開始時に確定している必要がある
+ * ccm: CCM モード 状態
+ * data: 変換テーブル(暗号キー, 処理中は参照し続けるので解放しないこと)
+ *  (type=Camellia128Encrypt, Camellia192Encrypt or Camellia256Encrypt, 復号も暗号キーで行う)
+ * nonce[noncelen]: ナンス
+ * noncelen: nonce のバイト数(7-13)
+ * alen: AAD のバイト数
+ * plen: 平文のバイト数(2^(8*(15-noncelen)) 未満)
+ * taglen: 認証タグのバイト数(4, 6, 8, 10, 12, 14 or 16)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type, noncelen, plen または taglen を指定した)
+ */
+extern int camelliaCcmInit(CamelliaCcm *ccm, const CamelliaData *data,
+                           const uint8_t *nonce, size_t noncelen,
+                           uint64_t alen, uint64_t plen, size_t taglen );
+
+/* CCM モードの追加認証データ(AAD)入力
+ * 暗号化/復号の開始前に何回かに分けて入力できる
+ * ccm: CCM モード 状態
+ * aad[len]: 追加認証データ
+ * len: aad のバイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(暗号化/復号の開始後に呼び出した, または開始時のバイト数を超えた)
+ */
+extern int camelliaCcmAad(CamelliaCcm *ccm, const uint8_t *aad, size_t len);
+
+/* CCM モードの暗号化
+ * 何回かに分けて入力できる
+ * ccm: CCM モード 状態
+ * in[len]: 平文
+ * out[len]: 暗号文 (in と同一領域も可)
+ * len: バイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(AAD が不足, 終了後に呼び出した, または開始時のバイト数を超えた)
+ */
+extern int camelliaCcmEncrypt(CamelliaCcm *ccm, const uint8_t *in,
+                              uint8_t *out, size_t len );
+
+/* CCM モードの復号
+ * 何回かに分けて入力できる
+ * 認証タグを camelliaCcmVerify で確認するまで出力を信用しないこと
+ * ccm: CCM モード 状態
+ * in[len]: 暗号文
+ * out[len]: 平文 (in と同一領域も可)
+ * len: バイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(AAD が不足, 終了後に呼び出した, または開始時のバイト数を超えた)
+ */
+extern int camelliaCcmDecrypt(CamelliaCcm *ccm, const uint8_t *in,
+                              uint8_t *out, size_t len );
+
+/* CCM モードの終了と認証タグの生成
+ * ccm: CCM モード 状態
+ * tag[taglen]: 認証タグ(taglen は開始時に指定したバイト数)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(終了後に呼び出した, または入力が開始時のバイト数に足りない)
+ */
+extern int camelliaCcmFinal(CamelliaCcm *ccm, uint8_t *tag);
+
+/* CCM モードの終了と認証タグの検証
+ * ccm: CCM モード 状態
+ * tag[taglen]: 受信した認証タグ(taglen は開始時に指定したバイト数)
+ * 戻り値: 0以上=認証成功, 0未満=認証失敗または異常終了
+ */
+extern int camelliaCcmVerify(CamelliaCcm *ccm, const uint8_t *tag);
+
+/* CCM モードの暗号化と認証タグの生成(一括)
+ * data: 変換テーブル(暗号キー)
+ * nonce[noncelen]: ナンス
+ * noncelen: nonce のバイト数(7-13)
+ * aad[alen]: 追加認証データ
+ * alen: aad のバイト数
+ * in[len]: 平文
+ * out[len]: 暗号文 (in と同一領域も可)
+ * len: バイト数
+ * tag[taglen]: 認証タグ
+ * taglen: 認証タグのバイト数(4, 6, 8, 10, 12, 14 or 16)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type, noncelen, len または taglen を指定した)
+ */
+extern int camelliaCcmSeal(const CamelliaData *data,
+                           const uint8_t *nonce, size_t noncelen,
+                           const uint8_t *aad, size_t alen,
+                           const uint8_t *in, uint8_t *out, size_t len,
+                           uint8_t *tag, size_t taglen );
+
+/* CCM モードの復号と認証タグの検証(一括)
+ * 認証に失敗した場合は out を0で消去する
+ * data: 変換テーブル(暗号キー)
+ * nonce[noncelen]: ナンス
+ * noncelen: nonce のバイト数(7-13)
+ * aad[alen]: 追加認証データ
+ * alen: aad のバイト数
+ * in[len]: 暗号文
+ * out[len]: 平文 (in と同一領域も可)
+ * len: バイト数
+ * tag[taglen]: 受信した認証タグ
+ * taglen: 認証タグのバイト数(4, 6, 8, 10, 12, 14 or 16)
+ * 戻り値: 0以上=認証成功, 0未満=認証失敗または異常終了
+ */
+extern int camelliaCcmOpen(const CamelliaData *data,
+                           const uint8_t *nonce, size_t noncelen,
+                           const uint8_t *aad, size_t alen,
+                           const uint8_t *in, uint8_t *out, size_t len,
+                           const uint8_t *tag, size_t taglen );
+
+#ifdef __cplusplus
+}
+#endif  /* #ifdef __cplusplus */
+
+#endif  /* #ifndef _INCLUDE_camellia_ccm_h */
@@ -0,0 +1,287 @@
+/* camellia_cmac.c - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - CMAC (RFC 4493).
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "camellia.h"
+#include "camellia_kernel.h"
+#include "camellia_cmac.h"
+
+/* GF(2^128) の値を2倍(RFC 4493 規定のサブキー導出)
+ * x[16]: 2倍する値(ビッグエンディアン)
+ * y[16]: 結果 (x と同一領域も可)
+ */
+static void dbl(const uint8_t *x, uint8_t *y) {
+    uint64_t hi, lo;
+    uint64_t carry;
+
+    hi = n8u64(x + 0), lo = n8u64(x + 8);
+    carry = -(hi >> 63);  /* 最上位ビットが1なら全ビット1 */
+    hi = hi << 1 | lo >> 63;
+    lo = lo << 1 ^ (carry & 0x87);
+    u8n64_set(hi, y + 0);
+    u8n64_set(lo, y + 8);
+}
+
+/* 最後のブロックを CBC-MAC 途中結果に排他的論理和
+ * 16バイトのブロックは K1, 端数(0バイトを含む)はパディングして K2 と排他的論理和する
+ * key: CMAC 鍵
+ * in[len]: 最後のブロック
+ * len: in のバイト数(0-16)
+ * x[16]: CBC-MAC 途中結果
+ */
+static void last(const CamelliaCmacKey *key, const uint8_t *in, size_t len,
+                 uint8_t *x ) {
+    uint8_t b[16];
+
+    if (len == 16)
+        camelliaXor(b, in, key->k1, 16);
+    else {
+        memcpy(b, in, len);
+        b[len] = 0x80;
+        memset(b + len + 1, 0, 16 - len - 1);
+        camelliaXor(b, b, key->k2, 16);
+    }
+    camelliaXor(x, x, b, 16);
+}
+
+/* CMAC 鍵の生成(サブキー K1, K2 の導出)
+ * key: CMAC 鍵
+ * data: 変換テーブル(暗号キー, 処理中は参照し続けるので解放しないこと)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaCmacKeyInit(CamelliaCmacKey *key, const CamelliaData *data) {
+    int status = -1;
+    uint8_t l[16];
+
+    switch (data->type) {
+    case Camellia128Encrypt:
+    case Camellia192Encrypt:
+    case Camellia256Encrypt:
+        break;
+    default:
+        goto error;
+    }
+    memset(l, 0, sizeof(l));
+    if (camelliaDatarand(l, data, l) < 0)
+        goto error;
+    key->data = data;
+    dbl(l, key->k1);
+    dbl(key->k1, key->k2);
+    status = 0;
+error:
+    return status;
+}
+
+/* CMAC の開始
+ * cmac: CMAC 状態
+ * key: CMAC 鍵(処理中は参照し続けるので解放しないこと)
+ */
+void camelliaCmacInit(CamelliaCmac *cmac, const CamelliaCmacKey *key) {
+    cmac->key = key;
+    memset(cmac->x, 0, sizeof(cmac->x));
+    cmac->nbuf = 0;
+}
+
+/* CMAC のメッセージ入力
+ * 何回かに分けて入力できる
+ * cmac: CMAC 状態
+ * in[len]: メッセージ
+ * len: in のバイト数
+ */
+void camelliaCmacUpdate(CamelliaCmac *cmac, const uint8_t *in, size_t len) {
+    size_t n;
+
+    while (len > 0) {
+        if (cmac->nbuf == 16) {  /* 続きがあるので保持していたブロックを処理 */
+            camelliaXor(cmac->x, cmac->x, cmac->buf, 16);
+            camelliaDatarand(cmac->x, cmac->key->data, cmac->x);
+            cmac->nbuf = 0;
+        }
+        if (cmac->nbuf == 0)  /* 最後のブロックになり得ないブロックはバッファを経由しない */
+            for (; len > 16; in += 16, len -= 16) {
+                camelliaXor(cmac->x, cmac->x, in, 16);
+                camelliaDatarand(cmac->x, cmac->key->data, cmac->x);
+            }
+        n = 16 - cmac->nbuf;
+        if (n > len)
+            n = len;
+        memcpy(cmac->buf + cmac->nbuf, in, n);
+        cmac->nbuf += n, in += n, len -= n;
+    }
+}
+
+/* CMAC の終了と認証タグの生成
+ * cmac: CMAC 状態
+ * tag[taglen]: 認証タグ
+ * taglen: 認証タグのバイト数(1-16)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(taglen が不正)
+ */
+int camelliaCmacFinal(CamelliaCmac *cmac, uint8_t *tag, size_t taglen) {
+    int status = -1;
+
+    if (taglen < 1 || taglen > 16)
+        goto error;
+    last(cmac->key, cmac->buf, cmac->nbuf, cmac->x);
+    camelliaDatarand(cmac->x, cmac->key->data, cmac->x);
+    memcpy(tag, cmac->x, taglen);
+    status = 0;
+error:
+    return status;
+}
+
+/* 認証タグの比較(処理時間が一致したバイト数に依存しない)
+ * a[len], b[len]: 比較する認証タグ
+ * len: バイト数
+ * 戻り値: 0以上=一致, 0未満=不一致
+ */
+static int compare(const uint8_t *a, const uint8_t *b, size_t len) {
+    uint8_t d;
+    size_t n;
+
+    d = 0;
+    for (n = 0; n < len; ++n)
+        d |= a[n] ^ b[n];
+    return d != 0 ? -1 : 0;
+}
+
+/* CMAC の終了と認証タグの検証
+ * cmac: CMAC 状態
+ * tag[taglen]: 受信した認証タグ
+ * taglen: 認証タグのバイト数(1-16)
+ * 戻り値: 0以上=認証成功, 0未満=認証失敗または異常終了
+ */
+int camelliaCmacVerify(CamelliaCmac *cmac, const uint8_t *tag, size_t taglen) {
+    int status = -1;
+    uint8_t t[16];
+
+    if (camelliaCmacFinal(cmac, t, taglen) < 0)
+        goto error;
+    if (compare(t, tag, taglen) < 0)
+        goto error;
+    status = 0;
+error:
+    return status;
+}
+
+/* CMAC の認証タグの生成(一括)
+ * key: CMAC 鍵
+ * in[len]: メッセージ
+ * len: in のバイト数
+ * tag[taglen]: 認証タグ
+ * taglen: 認証タグのバイト数(1-16)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(taglen が不正)
+ */
+int camelliaCmac(const CamelliaCmacKey *key, const uint8_t *in, size_t len,
+                 uint8_t *tag, size_t taglen ) {
+    CamelliaCmac cmac;
+
+    camelliaCmacInit(&cmac, key);
+    camelliaCmacUpdate(&cmac, in, len);
+    return camelliaCmacFinal(&cmac, tag, taglen);
+}
+
+/* 複数メッセージ一括検証で並行させるジョブ数(camelliaDatarandMulti() が1回で処理する列数) */
+#define JOB_LANES MULTI_LANES
+
+/* 複数の独立したメッセージの CMAC の認証タグの検証
+ * ジョブごとにレーンを割り当て, 各メッセージの CBC-MAC のブロックを交互に並行処理してブロック間の依存を隠す
+ * (全レーンの変換テーブルが同じ場合は複数ブロック一括処理, 異なる場合は列ごとに異なる変換テーブルで処理する)
+ * job[n]: CMAC 検証ジョブ(検証結果は job[].status に設定する)
+ * n: ジョブ数
+ * 戻り値: 0以上=全て認証成功, 0未満=認証失敗を含む
+ */
+int camelliaCmacVerifyJobs(CamelliaCmacJob *job, size_t n) {
+    int status = -1;
+    uint8_t x[JOB_LANES][16];          /* レーンの CBC-MAC 途中結果 */
+    const uint8_t *m[JOB_LANES];
+    const CamelliaData *data[JOB_LANES];
+    uint8_t *c[JOB_LANES];
+    CamelliaCmacJob *lane[JOB_LANES];  /* レーンに割り当てたジョブ */
+    size_t off[JOB_LANES];             /* レーンのジョブの処理済みバイト数 */
+    int fin[JOB_LANES];                /* 0以外=最後のブロックを処理した */
+    size_t nl, len, i, l;
+    int same;
+    int failed = 0;
+
+    i = 0, nl = 0;
+    for (;;) {
+        for (; i < n && nl < JOB_LANES; ++i) {  /* 空いたレーンに次のジョブを割り当てる */
+            job[i].status = -1;
+            if (job[i].taglen < 1 || job[i].taglen > 16) {
+                failed = 1;
+                continue;
+            }
+            switch (job[i].key->data->type) {
+            case Camellia128Encrypt:
+            case Camellia192Encrypt:
+            case Camellia256Encrypt:
+                break;
+            default:
+                failed = 1;
+                continue;
+            }
+            lane[nl] = &job[i], off[nl] = 0, memset(x[nl], 0, sizeof(x[nl])), ++nl;
+        }
+        if (nl == 0)
+            break;
+        for (l = 0, same = 1; l < nl; ++l) {
+            len = lane[l]->len - off[l];
+            if (len > 16) {
+                camelliaXor(x[l], x[l], lane[l]->in + off[l], 16);
+                off[l] += 16, fin[l] = 0;
+            }
+            else {
+                last(lane[l]->key, lane[l]->in + off[l], len, x[l]);
+                off[l] += len, fin[l] = 1;
+            }
+            m[l] = x[l], data[l] = lane[l]->key->data, c[l] = x[l];
+            if (data[l] != data[0])
+                same = 0;
+        }
+        if (same)
+            camelliaDatarandBulk(x[0], data[0], x[0], nl);
+        else
+            camelliaDatarandMulti(m, data, c, NULL, nl, 1);
+        for (l = 0; l < nl; )  /* 終わったジョブの認証タグを検証してレーンを詰める */
+            if (fin[l]) {
+                lane[l]->status = compare(x[l], lane[l]->tag, lane[l]->taglen);
+                if (lane[l]->status < 0)
+                    failed = 1;
+                --nl;
+                lane[l] = lane[nl], off[l] = off[nl], fin[l] = fin[nl];
+                memcpy(x[l], x[nl], sizeof(x[l]));
+            }
+            else
+                ++l;
+    }
+    if (failed)
+        goto error;
+    status = 0;
+error:
+    return status;
+}
@@ -0,0 +1,129 @@
+/* camellia_cmac.h - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - CMAC (RFC 4493).
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _INCLUDE_camellia_cmac_h
+#define _INCLUDE_camellia_cmac_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camellia.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* #ifdef __cplusplus */
+
+/* CMAC 鍵
+ * サブキー K1, K2 を導出済みで保持するので, 同じキーのメッセージごとに導出し直さない
+ */
+typedef struct {  /* CMAC 鍵 */
+    const CamelliaData *data;  /* 変換テーブル(暗号キー) */
+    uint8_t k1[16], k2[16];    /* RFC 4493 規定のサブキー K1, K2 */
+} CamelliaCmacKey;
+
+/* CMAC 状態
+ */
+typedef struct {  /* CMAC 状態 */
+    const CamelliaCmacKey *key;  /* CMAC 鍵 */
+    uint8_t x[16];               /* CBC-MAC 途中結果 */
+    uint8_t buf[16];             /* 未処理データ(最後のブロックは終了まで保持) */
+    unsigned nbuf;               /* buf のバイト数 */
+} CamelliaCmac;
+
+/* CMAC 複数メッセージ一括検証の単位
+ */
+typedef struct {  /* CMAC 検証ジョブ */
+    const CamelliaCmacKey *key;  /* CMAC 鍵 */
+    const uint8_t *in;           /* メッセージ in[len] */
+    size_t len;                  /* メッセージのバイト数 */
+    const uint8_t *tag;          /* 受信した認証タグ tag[taglen] */
+    size_t taglen;               /* 認証タグのバイト数(1-16) */
+    int status;                  /* 検証結果(0以上=認証成功, 0未満=認証失敗) */
+} CamelliaCmacJob;
+
+/* CMAC 鍵の生成(サブキー K1, K2 の導出)
+ * key: CMAC 鍵
+ * data: 変換テーブル(暗号キー, 処理中は参照し続けるので解放しないこと)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaCmacKeyInit(CamelliaCmacKey *key, const CamelliaData *data);
+
+/* CMAC の開始
+ * cmac: CMAC 状態
+ * key: CMAC 鍵(処理中は参照し続けるので解放しないこと)
+ */
+extern void camelliaCmacInit(CamelliaCmac *cmac, const CamelliaCmacKey *key);
+
+/* CMAC のメッセージ入力
+ * 何回かに分けて入力できる
+ * cmac: CMAC 状態
+ * in[len]: メッセージ
+ * len: in のバイト数
+ */
+extern void camelliaCmacUpdate(CamelliaCmac *cmac, const uint8_t *in,
+                               size_t len );
+
+/* CMAC の終了と認証タグの生成
+ * cmac: CMAC 状態
+ * tag[taglen]: 認証タグ
+ * taglen: 認証タグのバイト数(1-16)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(taglen が不正)
+ */
+extern int camelliaCmacFinal(CamelliaCmac *cmac, uint8_t *tag, size_t taglen);
+
+/* CMAC の終了と認証タグの検証
+ * cmac: CMAC 状態
+ * tag[taglen]: 受信した認証タグ
+ * taglen: 認証タグのバイト数(1-16)
+ * 戻り値: 0以上=認証成功, 0未満=認証失敗または異常終了
+ */
+extern int camelliaCmacVerify(CamelliaCmac *cmac, const uint8_t *tag,
+                              size_t taglen );
+
+/* CMAC の認証タグの生成(一括)
+ * key: CMAC 鍵
+ * in[len]: メッセージ
+ * len: in のバイト数
+ * tag[taglen]: 認証タグ
+ * taglen: 認証タグのバイト数(1-16)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(taglen が不正)
+ */
+extern int camelliaCmac(const CamelliaCmacKey *key, const uint8_t *in,
+                        size_t len, uint8_t *tag, size_t taglen );
+
+/* 複数の独立したメッセージの CMAC の認証タグの検証
+ * ジョブごとにレーンを割り当て, 各メッセージの CBC-MAC のブロックを交互に並行処理してブロック間の依存を隠す
+ * (ジョブごとにキー, バイト数, 認証タグのバイト数が異なってもよい)
+ * job[n]: CMAC 検証ジョブ(検証結果は job[].status に設定する)
+ * n: ジョブ数
+ * 戻り値: 0以上=全て認証成功, 0未満=認証失敗を含む
+ */
+extern int camelliaCmacVerifyJobs(CamelliaCmacJob *job, size_t n);
+
+#ifdef __cplusplus
+}
+#endif  /* #ifdef __cplusplus */
+
+#endif  /* #ifndef _INCLUDE_camellia_cmac_h */
@@ -0,0 +1,210 @@
+/* camellia_ctr.c - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - CTR mode.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "camellia.h"
+#include "camellia_kernel.h"
+#include "camellia_ctr.h"
+
+/* カウンタブロック列の生成
+ * ctr[16]: カウンタブロック(生成後は続きの値に更新)
+ * width: カウンタとして加算する下位バイト数(1-8, または16)
+ * blocks[16*n]: 生成したカウンタブロックの並び
+ * n: ブロック数
+ */
+void camelliaCounter(uint8_t *ctr, unsigned width,
+                     uint8_t *blocks, size_t n ) {
+    uint64_t hi, lo;
+    uint64_t mask;
+
+    hi = n8u64(ctr + 0), lo = n8u64(ctr + 8);
+    mask = width < 8 ? ((uint64_t)1 << width * 8) - 1 : ~(uint64_t)0;
+    while (n > 0) {
+        u8n64_set(hi, blocks + 0);
+        u8n64_set(lo, blocks + 8);
+        lo = (lo & ~mask) | ((lo + 1) & mask);
+        if (width > 8 && lo == 0)
+            ++hi;
+        blocks += 16, --n;
+    }
+    u8n64_set(hi, ctr + 0);
+    u8n64_set(lo, ctr + 8);
+}
+
+/* カウンタブロックに加算
+ * ctr[16]: カウンタブロック(128ビットのビッグエンディアン整数)
+ * n: 加算する値
+ */
+void camelliaCounterAdd(uint8_t *ctr, uint64_t n) {
+    uint64_t hi, lo;
+
+    hi = n8u64(ctr + 0), lo = n8u64(ctr + 8);
+    lo += n;
+    if (lo < n)
+        ++hi;
+    u8n64_set(hi, ctr + 0);
+    u8n64_set(lo, ctr + 8);
+}
+
+/* CTR モードの開始
+ * ctr: CTR モード 状態
+ * data: 変換テーブル(暗号キー, 処理中は参照し続けるので解放しないこと)
+ *  (type=Camellia128Encrypt, Camellia192Encrypt or Camellia256Encrypt, 復号も暗号キーで行う)
+ * iv[16]: カウンタブロックの初期値(128ビットのビッグエンディアン整数として加算する)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaCtrInit(CamelliaCtr *ctr, const CamelliaData *data,
+                    const uint8_t *iv ) {
+    int status = -1;
+
+    switch (data->type) {
+    case Camellia128Encrypt:
+    case Camellia192Encrypt:
+    case Camellia256Encrypt:
+        break;
+    default:
+        goto error;
+    }
+    ctr->data = data;
+    memcpy(ctr->ctr, iv, sizeof(ctr->ctr));
+    ctr->used = sizeof(ctr->ks);
+    status = 0;
+error:
+    return status;
+}
+
+/* CTR モードの暗号化/復号
+ * 前回の呼び出しの続きのカウンタ(端数バイト含む)から処理する
+ * ctr: CTR モード 状態
+ * in[len]: 入力データ
+ * out[len]: 出力データ (in と同一領域も可)
+ * len: データのバイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaCtrUpdate(CamelliaCtr *ctr, const uint8_t *in,
+                      uint8_t *out, size_t len ) {
+    int status = -1;
+    uint8_t ks[16 * BATCH_BLOCKS];
+    size_t n;
+
+    while (len > 0 && ctr->used < sizeof(ctr->ks))
+        *out++ = *in++ ^ ctr->ks[ctr->used++], --len;
+    while (len >= 16) {
+        n = len / 16;
+        if (n > BATCH_BLOCKS)
+            n = BATCH_BLOCKS;
+        camelliaCounter(ctr->ctr, 16, ks, n);
+        if (camelliaDatarandBulk(ks, ctr->data, ks, n) < 0)
+            goto error;
+        camelliaXor(out, in, ks, n * 16);
+        in += n * 16, out += n * 16, len -= n * 16;
+    }
+    if (len > 0) {
+        camelliaCounter(ctr->ctr, 16, ks, 1);
+        if (camelliaDatarand(ks, ctr->data, ctr->ks) < 0)
+            goto error;
+        ctr->used = 0;
+        while (len > 0)
+            *out++ = *in++ ^ ctr->ks[ctr->used++], --len;
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* 複数メッセージ一括処理で並行させるジョブ数(camelliaDatarandMulti() が1回で処理する列数) */
+#define JOB_LANES MULTI_LANES
+
+/* 複数メッセージ一括処理で1ジョブあたりまとめて処理するブロック数 */
+#define JOB_BLOCKS 16
+
+/* 複数の独立したメッセージの CTR モードの暗号化/復号
+ * ジョブごとにレーンを割り当て, キーの異なるメッセージを並行処理する
+ * (ラウンド数が同じジョブをまとめ, 各レーンの残りブロック数の最小値(最大 JOB_BLOCKS)ずつ進める)
+ * (ジョブごとにキー, 初期化ベクタ, バイト数が異なってもよい)
+ * 端数バイトの鍵ストリームは捨てるので, 続きは次のブロックから処理される
+ * job[n]: CTR モード ジョブ
+ * n: ジョブ数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaCtrJobs(CamelliaCtrJob *job, size_t n) {
+    int status = -1;
+    uint8_t ks[JOB_LANES][16 * JOB_BLOCKS];
+    const uint8_t *m[JOB_LANES];
+    const CamelliaData *data[JOB_LANES];
+    uint8_t *c[JOB_LANES];
+    CamelliaCtrJob *lane[JOB_LANES];  /* レーンに割り当てたジョブ */
+    size_t off[JOB_LANES];            /* レーンのジョブの処理済みバイト数 */
+    size_t nl, nb, nk, len, i, l;
+    int groups;
+
+    for (i = 0; i < n; ++i)
+        switch (job[i].data->type) {
+        case Camellia128Encrypt:
+        case Camellia192Encrypt:
+        case Camellia256Encrypt:
+            break;
+        default:
+            goto error;
+        }
+    for (groups = 3; groups <= 4; ++groups) {  /* ラウンド数が同じジョブを並行させる */
+        i = 0, nl = 0;
+        for (;;) {
+            for (; i < n && nl < JOB_LANES; ++i)  /* 空いたレーンに次のジョブを割り当てる */
+                if (job[i].len > 0 && GROUPS(job[i].data) == groups)
+                    lane[nl] = &job[i], off[nl] = 0, ++nl;
+            if (nl == 0)
+                break;
+            for (l = 0, nb = JOB_BLOCKS; l < nl; ++l) {  /* 全レーンで揃えるブロック数 */
+                nk = (lane[l]->len - off[l] + 15) / 16;
+                if (nk < nb)
+                    nb = nk;
+            }
+            for (l = 0; l < nl; ++l) {
+                camelliaCounter(lane[l]->iv, 16, ks[l], nb);
+                m[l] = ks[l], data[l] = lane[l]->data, c[l] = ks[l];
+            }
+            camelliaDatarandMulti(m, data, c, NULL, nl, nb);
+            for (l = 0; l < nl; ++l) {
+                len = lane[l]->len - off[l];
+                if (len > 16 * nb)
+                    len = 16 * nb;
+                camelliaXor(lane[l]->out + off[l], lane[l]->in + off[l], ks[l], len);
+                off[l] += len;
+            }
+            for (l = 0; l < nl; )  /* 終わったジョブのレーンを詰める */
+                if (off[l] >= lane[l]->len)
+                    --nl, lane[l] = lane[nl], off[l] = off[nl];
+                else
+                    ++l;
+        }
+    }
+    status = 0;
+error:
+    return status;
+}
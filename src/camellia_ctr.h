@@ -0,0 +1,93 @@
+/* camellia_ctr.h - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - CTR mode.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _INCLUDE_camellia_ctr_h
+#define _INCLUDE_camellia_ctr_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camellia.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* #ifdef __cplusplus */
+
+/* CTR モード 状態
+ */
+typedef struct {  /* CTR モード 状態 */
+    const CamelliaData *data;  /* 変換テーブル(暗号キー) */
+    uint8_t ctr[16];           /* 次に使うカウンタブロック */
+    uint8_t ks[16];            /* 鍵ストリームの残り */
+    unsigned used;             /* ks の使用済みバイト数 (16=残りなし) */
+} CamelliaCtr;
+
+/* CTR モード 複数メッセージ一括処理の単位
+ */
+typedef struct {  /* CTR モード ジョブ */
+    const CamelliaData *data;  /* 変換テーブル(暗号キー) */
+    uint8_t iv[16];            /* カウンタブロックの初期値(処理後は続きの値に更新) */
+    const uint8_t *in;         /* 入力データ in[len] */
+    uint8_t *out;              /* 出力データ out[len] (in と同一領域も可) */
+    size_t len;                /* データのバイト数 */
+} CamelliaCtrJob;
+
+/* CTR モードの開始
+ * ctr: CTR モード 状態
+ * data: 変換テーブル(暗号キー, 処理中は参照し続けるので解放しないこと)
+ *  (type=Camellia128Encrypt, Camellia192Encrypt or Camellia256Encrypt, 復号も暗号キーで行う)
+ * iv[16]: カウンタブロックの初期値(128ビットのビッグエンディアン整数として加算する)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaCtrInit(CamelliaCtr *ctr, const CamelliaData *data,
+                           const uint8_t *iv );
+
+/* CTR モードの暗号化/復号
+ * 前回の呼び出しの続きのカウンタ(端数バイト含む)から処理する
+ * ctr: CTR モード 状態
+ * in[len]: 入力データ
+ * out[len]: 出力データ (in と同一領域も可)
+ * len: データのバイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaCtrUpdate(CamelliaCtr *ctr, const uint8_t *in,
+                             uint8_t *out, size_t len );
+
+/* 複数の独立したメッセージの CTR モードの暗号化/復号
+ * ジョブごとにレーンを割り当て, キーの異なるメッセージを並行処理する
+ * (ラウンド数が同じジョブをまとめ, 各レーンの残りブロック数の最小値(最大16ブロック)ずつ進める)
+ * (ジョブごとにキー, 初期化ベクタ, バイト数が異なってもよい)
+ * 端数バイトの鍵ストリームは捨てるので, 続きは次のブロックから処理される
+ * job[n]: CTR モード ジョブ
+ * n: ジョブ数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaCtrJobs(CamelliaCtrJob *job, size_t n);
+
+#ifdef __cplusplus
+}
+#endif  /* #ifdef __cplusplus */
+
+#endif  /* #ifndef _INCLUDE_camellia_ctr_h */
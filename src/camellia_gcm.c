@@ -0,0 +1,378 @@
+/* camellia_gcm.c - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - GCM mode (RFC 6367 cipher suites).
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "camellia.h"
+#include "camellia_kernel.h"
+#include "camellia_gcm.h"
+
+/* 暗号文の最大バイト数 (2^39-256 ビット) */
+#define CLEN_MAX (((uint64_t)1 << 36) - 32)
+
+/* 排他的論理和と GHASH を交互に処理するブロック数(集約リダクションの4ブロックの倍数) */
+#define GHASH_BLOCKS 8
+
+/* ファイル内共有定数
+ */
+static const struct {
+    uint16_t last4[16];  /* 4ビット右シフトで溢れた値のリダクション値 */
+} ghashConst = {
+    .last4 = {
+        0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+        0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+    }
+};
+
+/* GHASH 乗算テーブルの生成
+ * gcm: GCM モード 状態
+ * h[16]: ハッシュキー H
+ */
+static void gtable(CamelliaGcm *gcm, const uint8_t *h) {
+    uint64_t vh, vl;
+    uint32_t t;
+    int i, j;
+
+    vh = n8u64(h + 0), vl = n8u64(h + 8);
+    gcm->hh[0] = 0, gcm->hl[0] = 0;
+    gcm->hh[8] = vh, gcm->hl[8] = vl;
+    for (i = 4; i > 0; i >>= 1) {
+        t = (uint32_t)(vl & 1) * 0xe1000000;
+        vl = vh << 63 | vl >> 1;
+        vh = vh >> 1 ^ (uint64_t)t << 32;
+        gcm->hh[i] = vh, gcm->hl[i] = vl;
+    }
+    for (i = 2; i <= 8; i <<= 1)
+        for (j = 1; j < i; ++j) {
+            gcm->hh[i + j] = gcm->hh[i] ^ gcm->hh[j];
+            gcm->hl[i + j] = gcm->hl[i] ^ gcm->hl[j];
+        }
+}
+
+/* GF(2^128) 上の H との乗算(4ビット単位のテーブル参照)
+ * gcm: GCM モード 状態
+ * x[16]: 乗算する値(積に更新)
+ */
+static void gmult(const CamelliaGcm *gcm, uint8_t *x) {
+    uint64_t zh, zl;
+    uint8_t lo, hi, rem;
+    int i;
+
+    zh = 0, zl = 0;
+    for (i = 15; i >= 0; --i) {
+        lo = x[i] & 0x0f, hi = x[i] >> 4;
+        if (i < 15) {
+            rem = zl & 0x0f;
+            zl = zh << 60 | zl >> 4, zh >>= 4;
+            zh ^= (uint64_t)ghashConst.last4[rem] << 48;
+        }
+        zh ^= gcm->hh[lo], zl ^= gcm->hl[lo];
+        rem = zl & 0x0f;
+        zl = zh << 60 | zl >> 4, zh >>= 4;
+        zh ^= (uint64_t)ghashConst.last4[rem] << 48;
+        zh ^= gcm->hh[hi], zl ^= gcm->hl[hi];
+    }
+    u8n64_set(zh, x + 0);
+    u8n64_set(zl, x + 8);
+}
+
+/* GHASH 処理
+ * gcm: GCM モード 状態
+ * p[16*n]: 入力ブロックの並び
+ * n: ブロック数
+ */
+static void ghash(CamelliaGcm *gcm, const uint8_t *p, size_t n) {
+#if KERNEL_X86
+    if (gcm->clmul) {
+        camelliaGhashClmul(gcm->x, gcm->hp, p, n);
+        n = 0;
+    }
+#endif  /* #if KERNEL_X86 */
+    while (n > 0) {
+        camelliaXor(gcm->x, gcm->x, p, 16);
+        gmult(gcm, gcm->x);
+        p += 16, --n;
+    }
+}
+
+/* GHASH 未処理データ(ブロック未満の端数)を0で埋めて処理
+ * gcm: GCM モード 状態
+ */
+static void gflush(CamelliaGcm *gcm) {
+    if (gcm->nbuf > 0) {
+        memset(gcm->buf + gcm->nbuf, 0, sizeof(gcm->buf) - gcm->nbuf);
+        ghash(gcm, gcm->buf, 1);
+        gcm->nbuf = 0;
+    }
+}
+
+/* GCM モードの開始
+ * gcm: GCM モード 状態
+ * data: 変換テーブル(暗号キー, 処理中は参照し続けるので解放しないこと)
+ *  (type=Camellia128Encrypt, Camellia192Encrypt or Camellia256Encrypt, 復号も暗号キーで行う)
+ * iv[ivlen]: 初期化ベクタ
+ * ivlen: iv のバイト数(1以上, 12を推奨)
+ * GHASH は CPU が対応していれば PCLMULQDQ, 対応していない場合と汎用カーネルを選択中の場合はテーブル参照で処理する
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type または ivlen を指定した)
+ */
+int camelliaGcmInit(CamelliaGcm *gcm, const CamelliaData *data,
+                    const uint8_t *iv, size_t ivlen ) {
+    int status = -1;
+    uint8_t h[16];
+    uint8_t b[16];
+    int i;
+
+    switch (data->type) {
+    case Camellia128Encrypt:
+    case Camellia192Encrypt:
+    case Camellia256Encrypt:
+        break;
+    default:
+        goto error;
+    }
+    if (ivlen < 1)
+        goto error;
+    gcm->clmul = 0;
+#if KERNEL_X86
+    if (camelliaKernelCurrent() != CamelliaKernelGeneric && camelliaCpu() & CPU_CLMUL)  /* 汎用カーネルではテーブル参照 */
+        gcm->clmul = 1;
+#endif  /* #if KERNEL_X86 */
+    memset(h, 0, sizeof(h));
+    if (camelliaDatarand(h, data, h) < 0)
+        goto error;
+    gcm->data = data;
+    gtable(gcm, h);
+    memcpy(gcm->hp[0], h, sizeof(gcm->hp[0]));
+    for (i = 1; i < 4; ++i) {
+        memcpy(gcm->hp[i], gcm->hp[i - 1], sizeof(gcm->hp[i]));
+        gmult(gcm, gcm->hp[i]);
+    }
+    memset(gcm->x, 0, sizeof(gcm->x));
+    gcm->nbuf = 0;
+    if (ivlen == 12) {
+        memcpy(gcm->j0, iv, 12);
+        gcm->j0[12] = 0, gcm->j0[13] = 0, gcm->j0[14] = 0, gcm->j0[15] = 1;
+    }
+    else {
+        ghash(gcm, iv, ivlen / 16);
+        memcpy(gcm->buf, iv + ivlen / 16 * 16, ivlen % 16), gcm->nbuf = ivlen % 16;
+        gflush(gcm);
+        u8n64_set(0, b + 0);
+        u8n64_set((uint64_t)ivlen * 8, b + 8);
+        ghash(gcm, b, 1);
+        memcpy(gcm->j0, gcm->x, sizeof(gcm->j0));
+        memset(gcm->x, 0, sizeof(gcm->x));
+    }
+    memcpy(gcm->ctr, gcm->j0, sizeof(gcm->ctr));
+    camelliaCounter(gcm->ctr, 4, b, 1);
+    gcm->alen = 0, gcm->clen = 0;
+    gcm->phase = 0;
+    status = 0;
+error:
+    return status;
+}
+
+/* GCM モードの追加認証データ(AAD)入力
+ * 暗号化/復号の開始前に何回かに分けて入力できる
+ * gcm: GCM モード 状態
+ * aad[len]: 追加認証データ
+ * len: aad のバイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(暗号化/復号の開始後に呼び出した)
+ */
+int camelliaGcmAad(CamelliaGcm *gcm, const uint8_t *aad, size_t len) {
+    int status = -1;
+    size_t n;
+
+    if (gcm->phase != 0)
+        goto error;
+    gcm->alen += len;
+    if (gcm->nbuf > 0) {
+        n = sizeof(gcm->buf) - gcm->nbuf;
+        if (n > len)
+            n = len;
+        memcpy(gcm->buf + gcm->nbuf, aad, n), gcm->nbuf += n;
+        aad += n, len -= n;
+        if (gcm->nbuf == sizeof(gcm->buf)) {
+            ghash(gcm, gcm->buf, 1);
+            gcm->nbuf = 0;
+        }
+    }
+    if (len >= 16) {
+        ghash(gcm, aad, len / 16);
+        aad += len / 16 * 16, len %= 16;
+    }
+    if (len > 0)
+        memcpy(gcm->buf, aad, len), gcm->nbuf = len;
+    status = 0;
+error:
+    return status;
+}
+
+/* GCM モードの暗号化/復号
+ * 鍵ストリームは BATCH_BLOCKS ブロック単位で一括生成し(どのカーネルでも並行数の倍数になる),
+ * 排他的論理和と GHASH(集約リダクション)は L1 キャッシュにあるうちに GHASH_BLOCKS ブロック単位で交互に処理する
+ * gcm: GCM モード 状態
+ * in[len]: 入力データ
+ * out[len]: 出力データ (in と同一領域も可)
+ * len: バイト数
+ * dec: 0=暗号化, 0以外=復号
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(終了後に呼び出した, または長さの上限を超えた)
+ */
+static int gcmCrypt(CamelliaGcm *gcm, const uint8_t *in, uint8_t *out,
+                 size_t len, int dec ) {
+    int status = -1;
+    uint8_t ks[16 * BATCH_BLOCKS];
+    uint8_t c;
+    size_t n, nh, i;
+
+    if (gcm->phase > 1)
+        goto error;
+    if (len > CLEN_MAX - gcm->clen)
+        goto error;
+    if (gcm->phase == 0) {
+        gflush(gcm);
+        gcm->phase = 1;
+    }
+    gcm->clen += len;
+    while (len > 0 && gcm->nbuf > 0) {
+        c = *in ^ gcm->ks[gcm->nbuf];
+        gcm->buf[gcm->nbuf++] = dec ? *in : c;
+        *out++ = c, ++in, --len;
+        if (gcm->nbuf == sizeof(gcm->buf)) {
+            ghash(gcm, gcm->buf, 1);
+            gcm->nbuf = 0;
+        }
+    }
+    while (len >= 16) {
+        n = len / 16;
+        if (n > BATCH_BLOCKS)
+            n = BATCH_BLOCKS;
+        camelliaCounter(gcm->ctr, 4, ks, n);
+        if (camelliaDatarandBulk(ks, gcm->data, ks, n) < 0)
+            goto error;
+        for (i = 0; i < n; i += nh) {
+            nh = n - i < GHASH_BLOCKS ? n - i : GHASH_BLOCKS;
+            if (dec)
+                ghash(gcm, in, nh);
+            camelliaXor(out, in, ks + 16 * i, nh * 16);
+            if (!dec)
+                ghash(gcm, out, nh);
+            in += nh * 16, out += nh * 16;
+        }
+        len -= n * 16;
+    }
+    if (len > 0) {
+        camelliaCounter(gcm->ctr, 4, ks, 1);
+        if (camelliaDatarand(ks, gcm->data, gcm->ks) < 0)
+            goto error;
+        while (len > 0) {
+            c = *in ^ gcm->ks[gcm->nbuf];
+            gcm->buf[gcm->nbuf++] = dec ? *in : c;
+            *out++ = c, ++in, --len;
+        }
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* GCM モードの暗号化
+ * 何回かに分けて入力できる
+ * gcm: GCM モード 状態
+ * in[len]: 平文
+ * out[len]: 暗号文 (in と同一領域も可)
+ * len: バイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(終了後に呼び出した, または長さの上限を超えた)
+ */
+int camelliaGcmEncrypt(CamelliaGcm *gcm, const uint8_t *in,
+                       uint8_t *out, size_t len ) {
+    return gcmCrypt(gcm, in, out, len, 0);
+}
+
+/* GCM モードの復号
+ * 何回かに分けて入力できる
+ * 認証タグを camelliaGcmVerify で確認するまで出力を信用しないこと
+ * gcm: GCM モード 状態
+ * in[len]: 暗号文
+ * out[len]: 平文 (in と同一領域も可)
+ * len: バイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(終了後に呼び出した, または長さの上限を超えた)
+ */
+int camelliaGcmDecrypt(CamelliaGcm *gcm, const uint8_t *in,
+                       uint8_t *out, size_t len ) {
+    return gcmCrypt(gcm, in, out, len, 1);
+}
+
+/* GCM モードの終了と認証タグの生成
+ * gcm: GCM モード 状態
+ * tag[taglen]: 認証タグ
+ * taglen: 認証タグのバイト数(1-16)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(終了後に呼び出した, または taglen が不正)
+ */
+int camelliaGcmFinal(CamelliaGcm *gcm, uint8_t *tag, size_t taglen) {
+    int status = -1;
+    uint8_t b[16];
+
+    if (gcm->phase > 1 || taglen < 1 || taglen > 16)
+        goto error;
+    gflush(gcm);
+    u8n64_set(gcm->alen * 8, b + 0);
+    u8n64_set(gcm->clen * 8, b + 8);
+    ghash(gcm, b, 1);
+    if (camelliaDatarand(gcm->j0, gcm->data, b) < 0)
+        goto error;
+    camelliaXor(b, b, gcm->x, sizeof(b));
+    memcpy(tag, b, taglen);
+    gcm->phase = 2;
+    status = 0;
+error:
+    return status;
+}
+
+/* GCM モードの終了と認証タグの検証
+ * gcm: GCM モード 状態
+ * tag[taglen]: 受信した認証タグ
+ * taglen: 認証タグのバイト数(1-16)
+ * 戻り値: 0以上=認証成功, 0未満=認証失敗または異常終了
+ */
+int camelliaGcmVerify(CamelliaGcm *gcm, const uint8_t *tag, size_t taglen) {
+    int status = -1;
+    uint8_t t[16];
+    uint8_t d;
+    size_t n;
+
+    if (camelliaGcmFinal(gcm, t, taglen) < 0)
+        goto error;
+    d = 0;
+    for (n = 0; n < taglen; ++n)
+        d |= t[n] ^ tag[n];
+    if (d != 0)
+        goto error;
+    status = 0;
+error:
+    return status;
+}
@@ -0,0 +1,120 @@
+/* camellia_gcm.h - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - GCM mode (RFC 6367 cipher suites).
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _INCLUDE_camellia_gcm_h
+#define _INCLUDE_camellia_gcm_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camellia.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* #ifdef __cplusplus */
+
+/* GCM モード 状態
+ */
+typedef struct {  /* GCM モード 状態 */
+    const CamelliaData *data;  /* 変換テーブル(暗号キー) */
+    uint64_t hl[16], hh[16];   /* GHASH 乗算テーブル(4ビット単位, 下位/上位64ビット) */
+    uint8_t hp[4][16];         /* H, H^2, H^3, H^4 (集約リダクション用) */
+    uint8_t j0[16];            /* 初期カウンタブロック */
+    uint8_t ctr[16];           /* 次に使うカウンタブロック */
+    uint8_t x[16];             /* GHASH 途中結果 */
+    uint8_t buf[16];           /* GHASH 未処理データ(ブロック未満の端数) */
+    uint8_t ks[16];            /* 鍵ストリームの残り */
+    unsigned nbuf;             /* buf のバイト数 */
+    uint64_t alen, clen;       /* AAD, 暗号文のバイト数 */
+    int phase;                 /* 0=AAD 入力中, 1=暗号化/復号中, 2=終了 */
+    int clmul;                 /* 0=GHASH をテーブル参照で処理, 1=PCLMULQDQ で処理 */
+} CamelliaGcm;
+
+/* GCM モードの開始
+ * gcm: GCM モード 状態
+ * data: 変換テーブル(暗号キー, 処理中は参照し続けるので解放しないこと)
+ *  (type=Camellia128Encrypt, Camellia192Encrypt or Camellia256Encrypt, 復号も暗号キーで行う)
+ * iv[ivlen]: 初期化ベクタ
+ * ivlen: iv のバイト数(1以上, 12を推奨)
+ * GHASH は CPU が対応していれば PCLMULQDQ, 対応していない場合と汎用カーネルを選択中の場合はテーブル参照で処理する
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type または ivlen を指定した)
+ */
+extern int camelliaGcmInit(CamelliaGcm *gcm, const CamelliaData *data,
+                           const uint8_t *iv, size_t ivlen );
+
+/* GCM モードの追加認証データ(AAD)入力
+ * 暗号化/復号の開始前に何回かに分けて入力できる
+ * gcm: GCM モード 状態
+ * aad[len]: 追加認証データ
+ * len: aad のバイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(暗号化/復号の開始後に呼び出した)
+ */
+extern int camelliaGcmAad(CamelliaGcm *gcm, const uint8_t *aad, size_t len);
+
+/* GCM モードの暗号化
+ * 何回かに分けて入力できる
+ * gcm: GCM モード 状態
+ * in[len]: 平文
+ * out[len]: 暗号文 (in と同一領域も可)
+ * len: バイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(終了後に呼び出した, または長さの上限を超えた)
+ */
+extern int camelliaGcmEncrypt(CamelliaGcm *gcm, const uint8_t *in,
+                              uint8_t *out, size_t len );
+
+/* GCM モードの復号
+ * 何回かに分けて入力できる
+ * 認証タグを camelliaGcmVerify で確認するまで出力を信用しないこと
+ * gcm: GCM モード 状態
+ * in[len]: 暗号文
+ * out[len]: 平文 (in と同一領域も可)
+ * len: バイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(終了後に呼び出した, または長さの上限を超えた)
+ */
+extern int camelliaGcmDecrypt(CamelliaGcm *gcm, const uint8_t *in,
+                              uint8_t *out, size_t len );
+
+/* GCM モードの終了と認証タグの生成
+ * gcm: GCM モード 状態
+ * tag[taglen]: 認証タグ
+ * taglen: 認証タグのバイト数(1-16)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(終了後に呼び出した, または taglen が不正)
+ */
+extern int camelliaGcmFinal(CamelliaGcm *gcm, uint8_t *tag, size_t taglen);
+
+/* GCM モードの終了と認証タグの検証
+ * gcm: GCM モード 状態
+ * tag[taglen]: 受信した認証タグ
+ * taglen: 認証タグのバイト数(1-16)
+ * 戻り値: 0以上=認証成功, 0未満=認証失敗または異常終了
+ */
+extern int camelliaGcmVerify(CamelliaGcm *gcm, const uint8_t *tag,
+                             size_t taglen );
+
+#ifdef __cplusplus
+}
+#endif  /* #ifdef __cplusplus */
+
+#endif  /* #ifndef _INCLUDE_camellia_gcm_h */
@@ -0,0 +1,464 @@
+/* camellia_kernel.h - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - internal kernel interface.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _INCLUDE_camellia_kernel_h
+#define _INCLUDE_camellia_kernel_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camellia.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KERNEL_X86 1
+#else  /* #if defined(__GNUC__) && ... */
+#define KERNEL_X86 0
+#endif  /* #if defined(__GNUC__) && ... */
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+/* 非アライン領域アクセス用の64ビット型 */
+typedef uint64_t u64una __attribute__((aligned(1), may_alias));
+
+/* ビッグエンディアン(ネットワークバイトオーダー)の8バイトデータを変換 */
+#define n8u64(_n64) \
+    __builtin_bswap64(*(const u64una *)(_n64))
+
+/* ビッグエンディアン(ネットワークバイトオーダー)の8バイトデータに変換 */
+#define u8n64_set(_u64, _n64) \
+    do { \
+        *(u64una *)(_n64) = __builtin_bswap64((uint64_t)(_u64)); \
+    } while (0)
+#else  /* #if defined(__GNUC__) && ... */
+/* ビッグエンディアン(ネットワークバイトオーダー)の8バイトデータを変換 */
+#define n8u64(_n64) \
+    ((uint64_t)((uint8_t *)(_n64))[0] << 56 | \
+     (uint64_t)((uint8_t *)(_n64))[1] << 48 | \
+     (uint64_t)((uint8_t *)(_n64))[2] << 40 | \
+     (uint64_t)((uint8_t *)(_n64))[3] << 32 | \
+     (uint64_t)((uint8_t *)(_n64))[4] << 24 | \
+     (uint64_t)((uint8_t *)(_n64))[5] << 16 | \
+     (uint64_t)((uint8_t *)(_n64))[6] <<  8 | \
+     (uint64_t)((uint8_t *)(_n64))[7] <<  0 )
+
+/* ビッグエンディアン(ネットワークバイトオーダー)の8バイトデータに変換 */
+#define u8n64_set(_u64, _n64) \
+    do { \
+        ((uint8_t *)(_n64))[0] = (uint8_t)((uint64_t)(_u64) >> 56); \
+        ((uint8_t *)(_n64))[1] = (uint8_t)((uint64_t)(_u64) >> 48); \
+        ((uint8_t *)(_n64))[2] = (uint8_t)((uint64_t)(_u64) >> 40); \
+        ((uint8_t *)(_n64))[3] = (uint8_t)((uint64_t)(_u64) >> 32); \
+        ((uint8_t *)(_n64))[4] = (uint8_t)((uint64_t)(_u64) >> 24); \
+        ((uint8_t *)(_n64))[5] = (uint8_t)((uint64_t)(_u64) >> 16); \
+        ((uint8_t *)(_n64))[6] = (uint8_t)((uint64_t)(_u64) >>  8); \
+        ((uint8_t *)(_n64))[7] = (uint8_t)((uint64_t)(_u64) >>  0); \
+    } while (0)
+#endif  /* #if defined(__GNUC__) && ... */
+
+/* 変換テーブルの6ラウンド単位のグループ数
+ * 戻り値: 3=18ラウンド(128bit キー), 4=24ラウンド(192bit, 256bit キー)
+ */
+#define GROUPS(_data) \
+    ((_data)->type == Camellia128Encrypt || (_data)->type == Camellia128Decrypt ? 3 : 4)
+
+/* データランダム化処理で i 番目に使うサブキーの sk[] の添字
+ * 逆変換では camelliaKeyswap() した変換テーブルと同じ順にたどる
+ * _i: 使用順の番号(0 ～ 8*_groups+1)
+ * _groups: 6ラウンド単位のグループ数
+ * _inv: 0=順変換, 0以外=逆変換
+ */
+#define SKI(_i, _groups, _inv) \
+    (!(_inv) ? ((_i) < (_groups) * 8 ? (_i) : (_i) - (_groups) * 8 + 32) : \
+     (_i) < 2 ? (_i) + 32 : \
+     (_i) < (_groups) * 8 ? (_groups) * 8 + 1 - (_i) : (_i) - (_groups) * 8 )
+
+/* CPU の対応機能 */
+#define CPU_AESNI  0x0001  /* AES-NI, AVX */
+#define CPU_VAES   0x0002  /* AVX2, VAES */
+#define CPU_CLMUL  0x0004  /* PCLMULQDQ, SSSE3 */
+#define CPU_SSE2   0x0008  /* SSE2 */
+#define CPU_AVX2   0x0010  /* AVX2 */
+#define CPU_AVX512 0x0020  /* AVX-512F, AVX-512BW, GFNI */
+
+/* CPU の対応機能を取得(初回のみ CPUID で調べる)
+ * 戻り値: CPU_* の論理和
+ */
+extern unsigned camelliaCpu(void);
+
+/* RFC 3713 規定のデータランダム化処理(ビットスライス, 64ブロック並行)
+ * S-box をテーブル参照せずに論理回路で求めるので, 処理時間がデータとキーに依存しない
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数(64の倍数でなくてもよい)
+ * inv: 0=順変換, 0以外=逆変換
+ */
+extern void camelliaDatarandBitslice(const uint8_t *m, const CamelliaData *data,
+                                     uint8_t *c, size_t n, int inv );
+
+/* 独立したブロック列のデータランダム化処理(ビットスライス, 64列並行, 列ごとに異なる変換テーブル)
+ * 列ごとのサブキーもビットスライスにするので, 処理時間がデータとキーに依存しない
+ * m[64][16*n]: RFC 3713 規定の変数M の並び
+ * data[64]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[64][16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[64][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+extern void camelliaDatarandMultiBitslice(const uint8_t *const *m,
+                                          const CamelliaData *const *data,
+                                          uint8_t *const *c, uint8_t *const *iv,
+                                          size_t n, int groups );
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(ビットスライス, 64キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数(64の倍数でなくてもよい)
+ */
+extern void camelliaKeygenBitslice(const uint8_t *kl, const uint8_t *kr,
+                                   uint8_t *ka, uint8_t *kb, size_t n );
+
+/* RFC 3713 規定のデータランダム化処理(ビットスライス, 8ブロック並行)
+ * 各ブロックの8バイトをレーンにするので, 幅の広いビットスライスカーネルより少数ブロックの処理が速い
+ * (処理時間はデータとキーに依存しない)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数(8の倍数でなくてもよい)
+ * inv: 0=順変換, 0以外=逆変換
+ */
+extern void camelliaDatarandBitsliceNarrow(const uint8_t *m, const CamelliaData *data,
+                                           uint8_t *c, size_t n, int inv );
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(ビットスライス, 8キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数(8の倍数でなくてもよい)
+ */
+extern void camelliaKeygenBitsliceNarrow(const uint8_t *kl, const uint8_t *kr,
+                                         uint8_t *ka, uint8_t *kb, size_t n );
+
+/* 処理時間がデータとキーに依存しないカーネルで, 8ブロック並行のビットスライスに回すブロック数の上限
+ * (これより多いと幅の広いビットスライスの1回の処理の方が速い)
+ */
+#define NARROW_MAX 16
+
+#if KERNEL_X86
+/* CPU の対応機能を取得
+ * 戻り値: CPU_* の論理和
+ */
+extern unsigned camelliaCpuid(void);
+
+/* RFC 3713 規定のデータランダム化処理(ビットスライス, SSE2 で128ブロック並行)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数(128の倍数でなくてもよい)
+ * inv: 0=順変換, 0以外=逆変換
+ */
+extern void camelliaDatarandBitsliceSse2(const uint8_t *m, const CamelliaData *data,
+                                         uint8_t *c, size_t n, int inv );
+
+/* 独立したブロック列のデータランダム化処理(ビットスライス, SSE2 で128列並行, 列ごとに異なる変換テーブル)
+ * 列ごとのサブキーもビットスライスにするので, 処理時間がデータとキーに依存しない
+ * m[128][16*n]: RFC 3713 規定の変数M の並び
+ * data[128]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[128][16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[128][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+extern void camelliaDatarandMultiBitsliceSse2(const uint8_t *const *m,
+                                              const CamelliaData *const *data,
+                                              uint8_t *const *c, uint8_t *const *iv,
+                                              size_t n, int groups );
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(ビットスライス, SSE2 で128キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数(128の倍数でなくてもよい)
+ */
+extern void camelliaKeygenBitsliceSse2(const uint8_t *kl, const uint8_t *kr,
+                                       uint8_t *ka, uint8_t *kb, size_t n );
+
+/* RFC 3713 規定のデータランダム化処理(ビットスライス, AVX2 で256ブロック並行)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数(256の倍数でなくてもよい)
+ * inv: 0=順変換, 0以外=逆変換
+ */
+extern void camelliaDatarandBitsliceAvx2(const uint8_t *m, const CamelliaData *data,
+                                         uint8_t *c, size_t n, int inv );
+
+/* 独立したブロック列のデータランダム化処理(ビットスライス, AVX2 で256列並行, 列ごとに異なる変換テーブル)
+ * 列ごとのサブキーもビットスライスにするので, 処理時間がデータとキーに依存しない
+ * m[256][16*n]: RFC 3713 規定の変数M の並び
+ * data[256]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[256][16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[256][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+extern void camelliaDatarandMultiBitsliceAvx2(const uint8_t *const *m,
+                                              const CamelliaData *const *data,
+                                              uint8_t *const *c, uint8_t *const *iv,
+                                              size_t n, int groups );
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(ビットスライス, AVX2 で256キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数(256の倍数でなくてもよい)
+ */
+extern void camelliaKeygenBitsliceAvx2(const uint8_t *kl, const uint8_t *kr,
+                                       uint8_t *ka, uint8_t *kb, size_t n );
+
+/* RFC 3713 規定のデータランダム化処理(AES-NI, AVX で16ブロック並行)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数(16の倍数)
+ * inv: 0=順変換, 0以外=逆変換
+ */
+extern void camelliaDatarandAesni(const uint8_t *m, const CamelliaData *data,
+                                  uint8_t *c, size_t n, int inv );
+
+/* RFC 3713 規定のデータランダム化処理(AVX2, VAES で32ブロック並行)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数(32の倍数)
+ * inv: 0=順変換, 0以外=逆変換
+ */
+extern void camelliaDatarandVaes(const uint8_t *m, const CamelliaData *data,
+                                 uint8_t *c, size_t n, int inv );
+
+/* RFC 3713 規定のデータランダム化処理(AVX-512, GFNI で64ブロック並行)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数(64の倍数)
+ * inv: 0=順変換, 0以外=逆変換
+ */
+extern void camelliaDatarandAvx512(const uint8_t *m, const CamelliaData *data,
+                                   uint8_t *c, size_t n, int inv );
+
+/* 独立したブロック列のデータランダム化処理(AES-NI, AVX で16列並行, 列ごとに異なる変換テーブル)
+ * m[16][16*n]: RFC 3713 規定の変数M の並び
+ * data[16]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[16][16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[16][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+extern void camelliaDatarandMultiAesni(const uint8_t *const *m,
+                                       const CamelliaData *const *data,
+                                       uint8_t *const *c, uint8_t *const *iv,
+                                       size_t n, int groups );
+
+/* 独立したブロック列のデータランダム化処理(AVX2, VAES で32列並行, 列ごとに異なる変換テーブル)
+ * m[32][16*n]: RFC 3713 規定の変数M の並び
+ * data[32]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[32][16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[32][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+extern void camelliaDatarandMultiVaes(const uint8_t *const *m,
+                                      const CamelliaData *const *data,
+                                      uint8_t *const *c, uint8_t *const *iv,
+                                      size_t n, int groups );
+
+/* 独立したブロック列のデータランダム化処理(AVX-512, GFNI で64列並行, 列ごとに異なる変換テーブル)
+ * m[64][16*n]: RFC 3713 規定の変数M の並び
+ * data[64]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[64][16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[64][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+extern void camelliaDatarandMultiAvx512(const uint8_t *const *m,
+                                        const CamelliaData *const *data,
+                                        uint8_t *const *c, uint8_t *const *iv,
+                                        size_t n, int groups );
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(AES-NI, AVX で16キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数(16の倍数)
+ */
+extern void camelliaKeygenAesni(const uint8_t *kl, const uint8_t *kr,
+                                uint8_t *ka, uint8_t *kb, size_t n );
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(AVX2, VAES で32キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数(32の倍数)
+ */
+extern void camelliaKeygenVaes(const uint8_t *kl, const uint8_t *kr,
+                               uint8_t *ka, uint8_t *kb, size_t n );
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(AVX-512, GFNI で64キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数(64の倍数)
+ */
+extern void camelliaKeygenAvx512(const uint8_t *kl, const uint8_t *kr,
+                                 uint8_t *ka, uint8_t *kb, size_t n );
+
+/* GHASH 処理(PCLMULQDQ で4ブロック単位の集約リダクション)
+ * x[16]: GHASH 途中結果(処理後の値に更新)
+ * hp[4][16]: H, H^2, H^3, H^4
+ * p[16*n]: 入力ブロックの並び
+ * n: ブロック数
+ */
+extern void camelliaGhashClmul(uint8_t *x, const uint8_t (*hp)[16],
+                               const uint8_t *p, size_t n );
+#endif  /* #if KERNEL_X86 */
+
+#ifndef STATS  // 実行時統計を集計するなら1 (configure --enable-stats), 集計しないなら0
+#define STATS 0
+#endif  /* #ifndef STATS */
+
+#if STATS
+#include "camellia_stats.h"
+
+#if defined(__GNUC__)  // 集計値は所有スレッドだけが書き込み, 取得時に他のスレッドから読み出す
+#define STATS_THREAD __thread
+#define STATS_SET(_var, _value) __atomic_store_n(&(_var), (_value), __ATOMIC_RELAXED)
+#define STATS_LOAD(_var) __atomic_load_n(&(_var), __ATOMIC_RELAXED)
+#else  /* #if defined(__GNUC__) */
+#define STATS_THREAD _Thread_local
+#define STATS_SET(_var, _value) ((_var) = (_value))
+#define STATS_LOAD(_var) (_var)
+#endif  /* #if defined(__GNUC__) */
+
+/* 呼び出し元スレッドの実行時統計(初回は NULL) */
+extern STATS_THREAD CamelliaStats *camelliaStatsThread;
+
+/* 呼び出し元スレッドの実行時統計を登録
+ * 戻り値: 呼び出し元スレッドの実行時統計
+ */
+extern CamelliaStats *camelliaStatsAttach(void);
+
+/* 複数ブロック一括の呼び出しの集計の開始
+ * 呼び出し回数, ブロック数, ブロック数のヒストグラムを集計し, 抜き取る呼び出しならサイクル数の計測を始める
+ * n: ブロック数
+ * 戻り値: 0以外=計測開始時のサイクル数, 0=抜き取らない
+ */
+extern uint64_t camelliaStatsBegin(size_t n);
+
+/* 複数ブロック一括の呼び出しの集計の終了
+ * begin: camelliaStatsBegin() の戻り値(0=何もしない)
+ * n: ブロック数
+ */
+extern void camelliaStatsEnd(uint64_t begin, size_t n);
+
+/* 呼び出し元スレッドの実行時統計に加算 */
+#define STATS_ADD(_field, _n) \
+    do { \
+        CamelliaStats *_stats = camelliaStatsThread; \
+        if (_stats == NULL) \
+            _stats = camelliaStatsAttach(); \
+        STATS_SET(_stats->_field, _stats->_field + (_n)); \
+    } while (0)
+#else  /* #if STATS */
+#define STATS_ADD(_field, _n) do {} while (0)
+#endif  /* #if STATS */
+
+/* 鍵ストリームなどをまとめて処理するブロック数
+ * (最も並行数の多いカーネル(bitslice-avx2 の256ブロック)以上にして, 端数を埋める処理を長いデータで出さない)
+ */
+#define BATCH_BLOCKS 256
+
+/* 独立したブロック列のデータランダム化処理でまとめて処理する列数(最大の lanes 以上)
+ * (複数メッセージ一括処理のレーン数もこれに揃え, 最も並行数の多いカーネルの列を埋める)
+ */
+#define MULTI_LANES 256
+
+/* バイト列の排他的論理和
+ * out[len]: a ^ b (a または b と同一領域も可)
+ * a[len], b[len]: 入力
+ * len: バイト数
+ */
+extern void camelliaXor(uint8_t *out, const uint8_t *a, const uint8_t *b,
+                        size_t len );
+
+/* 復号方向のデータランダム化処理(複数ブロック一括)
+ * c[16*n]: RFC 3713 規定の変数C の並び
+ * data: 変換テーブル(暗号キーの場合は逆変換, 復号キーの場合はそのまま処理する)
+ * m[16*n]: RFC 3713 規定の変数M の並び (c と同一領域も可)
+ * n: ブロック数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaDecryptBulk(const uint8_t *c, const CamelliaData *data,
+                               uint8_t *m, size_t n );
+
+/* RFC 3713 規定のデータランダム化処理(2ブロック並行, 順変換のみ, キー種別の確認なし)
+ * 連鎖するブロックと独立したブロックを組にして, 連鎖の待ち時間にもう一方を処理する
+ * m1[16], m2[16]: RFC 3713 規定の変数M
+ * data: 変換テーブル
+ * c1[16], c2[16]: RFC 3713 規定の変数C (m1, m2 と同一領域も可)
+ */
+extern void camelliaDatarandPair(const uint8_t *m1, const uint8_t *m2,
+                                 const CamelliaData *data,
+                                 uint8_t *c1, uint8_t *c2 );
+
+/* 独立したブロック列のデータランダム化処理(列ごとに異なる変換テーブル)
+ * m[n][16*blocks]: RFC 3713 規定の変数M の並び
+ * data[n]: 変換テーブル(キー種別は確認済みであること)
+ * c[n][16*blocks]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[n][16]: CBC モードの初期化ベクタ(M に排他的論理和してから処理し, 処理後は最後の C に更新)
+ *  (NULL=列のブロックを独立に処理する)
+ * n: 列数
+ * blocks: 列ごとのブロック数
+ */
+extern void camelliaDatarandMulti(const uint8_t *const *m,
+                                  const CamelliaData *const *data,
+                                  uint8_t *const *c, uint8_t *const *iv,
+                                  size_t n, size_t blocks );
+
+/* カウンタブロック列の生成
+ * ctr[16]: カウンタブロック(生成後は続きの値に更新)
+ * width: カウンタとして加算する下位バイト数(1-8, または16)
+ * blocks[16*n]: 生成したカウンタブロックの並び
+ * n: ブロック数
+ */
+extern void camelliaCounter(uint8_t *ctr, unsigned width,
+                            uint8_t *blocks, size_t n );
+
+/* カウンタブロックに加算
+ * ctr[16]: カウンタブロック(128ビットのビッグエンディアン整数)
+ * n: 加算する値
+ */
+extern void camelliaCounterAdd(uint8_t *ctr, uint64_t n);
+
+#endif  /* #ifndef _INCLUDE_camellia_kernel_h */
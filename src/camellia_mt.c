@@ -0,0 +1,408 @@
+/* camellia_mt.c - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - multi-threaded bulk processing.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "camellia.h"
+#include "camellia_kernel.h"
+#include "camellia_ctr.h"
+#include "camellia_xts.h"
+#include "camellia_mt.h"
+
+/* チャンクの既定のバイト数 */
+#define CHUNK_DEFAULT (256 * 1024)
+
+/* 並列処理する仕事
+ */
+typedef struct {  /* 仕事 */
+    int (*run)(const void *arg, size_t index);  /* index 番目のチャンクを処理 (戻り値: 0以上=正常終了, 0未満=異常終了) */
+    const void *arg;                            /* run に渡す引数 */
+    size_t chunks;                              /* チャンク数 */
+} Job;
+
+/* 並列処理エンジン
+ */
+struct CamelliaMt {
+    pthread_mutex_t call;   /* 呼び出しの排他 */
+    pthread_mutex_t mutex;  /* 以下の変数の排他 */
+    pthread_cond_t wake;    /* 仕事の開始, 終了要求の通知 */
+    pthread_cond_t done;    /* 仕事の完了の通知 */
+    Job job;                /* 処理中の仕事 */
+    size_t next;            /* 次に処理するチャンク */
+    size_t finished;        /* 処理を終えたチャンク数 */
+    int status;             /* 処理結果 (0以上=正常終了, 0未満=異常終了) */
+    int quit;               /* 0以外=ワーカースレッドの終了要求 */
+    size_t chunk;           /* 1スレッドが一度に処理するバイト数 */
+    int nthreads;           /* 起動したワーカースレッド数 */
+    pthread_t threads[];    /* ワーカースレッド */
+};
+
+/* 仕事のチャンクを取り出して処理(全て取り出したら戻る)
+ * mt: 並列処理エンジン (mutex をロックした状態で呼び出す)
+ */
+static void work(CamelliaMt *mt) {
+    size_t index;
+    int status;
+
+    while (mt->next < mt->job.chunks) {
+        index = mt->next++;
+        pthread_mutex_unlock(&mt->mutex);
+        status = mt->job.run(mt->job.arg, index);
+        pthread_mutex_lock(&mt->mutex);
+        if (status < 0)
+            mt->status = -1;
+        if (++mt->finished == mt->job.chunks)
+            pthread_cond_broadcast(&mt->done);
+    }
+}
+
+/* ワーカースレッド */
+static void *worker(void *arg) {
+    CamelliaMt *mt = arg;
+
+    pthread_mutex_lock(&mt->mutex);
+    while (!mt->quit) {
+        work(mt);
+        pthread_cond_wait(&mt->wake, &mt->mutex);
+    }
+    pthread_mutex_unlock(&mt->mutex);
+    return NULL;
+}
+
+/* 仕事の並列処理
+ * mt: 並列処理エンジン
+ * run: index 番目のチャンクを処理する関数
+ * arg: run に渡す引数
+ * chunks: チャンク数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(いずれかのチャンクの処理が異常終了した)
+ */
+static int parallel(CamelliaMt *mt, int (*run)(const void *arg, size_t index),
+                    const void *arg, size_t chunks ) {
+    int status = -1;
+    int result;
+    size_t n;
+
+    if (chunks <= 1 || mt->nthreads == 0) {  /* 呼び出し元スレッドだけで処理 */
+        for (n = 0; n < chunks; ++n)
+            if (run(arg, n) < 0)
+                goto error;
+    }
+    else {
+        pthread_mutex_lock(&mt->call);
+        pthread_mutex_lock(&mt->mutex);
+        mt->job.run = run, mt->job.arg = arg, mt->job.chunks = chunks;
+        mt->next = 0, mt->finished = 0, mt->status = 0;
+        pthread_cond_broadcast(&mt->wake);
+        work(mt);
+        while (mt->finished < mt->job.chunks)
+            pthread_cond_wait(&mt->done, &mt->mutex);
+        mt->job.chunks = 0;
+        result = mt->status;
+        pthread_mutex_unlock(&mt->mutex);
+        pthread_mutex_unlock(&mt->call);
+        if (result < 0)
+            goto error;
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* 並列処理エンジンの生成
+ * threads: 処理するスレッド数(呼び出し元スレッドを含む, 0以下=CPU数)
+ * chunk: 1スレッドが一度に処理するバイト数(16の倍数に切り捨てる, 0=既定値 256KB)
+ * 戻り値: 並列処理エンジン (NULL=異常終了)
+ */
+CamelliaMt *camelliaMtCreate(int threads, size_t chunk) {
+    CamelliaMt *mt = NULL;
+    long cpus;
+
+    if (threads <= 0) {
+        cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    chunk &= ~(size_t)15;
+    if (chunk == 0)
+        chunk = CHUNK_DEFAULT;
+    mt = calloc(1, sizeof(*mt) + sizeof(*mt->threads) * (threads - 1));
+    if (mt == NULL)
+        goto error;
+    pthread_mutex_init(&mt->call, NULL);
+    pthread_mutex_init(&mt->mutex, NULL);
+    pthread_cond_init(&mt->wake, NULL);
+    pthread_cond_init(&mt->done, NULL);
+    mt->chunk = chunk;
+    for (mt->nthreads = 0; mt->nthreads < threads - 1; ++mt->nthreads)
+        if (pthread_create(&mt->threads[mt->nthreads], NULL, worker, mt))
+            break;
+    if (mt->nthreads < threads - 1) {
+        camelliaMtDestroy(mt), mt = NULL;
+        goto error;
+    }
+error:
+    return mt;
+}
+
+/* 並列処理エンジンの破棄
+ * mt: 並列処理エンジン (NULL の場合は何もしない)
+ */
+void camelliaMtDestroy(CamelliaMt *mt) {
+    int n;
+
+    if (mt == NULL)
+        return;
+    pthread_mutex_lock(&mt->mutex);
+    mt->quit = 1;
+    pthread_cond_broadcast(&mt->wake);
+    pthread_mutex_unlock(&mt->mutex);
+    for (n = 0; n < mt->nthreads; ++n)
+        pthread_join(mt->threads[n], NULL);
+    pthread_cond_destroy(&mt->done);
+    pthread_cond_destroy(&mt->wake);
+    pthread_mutex_destroy(&mt->mutex);
+    pthread_mutex_destroy(&mt->call);
+    free(mt);
+}
+
+/* 並列処理エンジンのスレッド数を取得
+ * mt: 並列処理エンジン
+ * 戻り値: スレッド数(呼び出し元スレッドを含む)
+ */
+int camelliaMtThreads(const CamelliaMt *mt) {
+    return mt->nthreads + 1;
+}
+
+/* 複数ブロック一括処理の仕事 */
+typedef struct {  /* ECB の引数 */
+    const uint8_t *in;          /* 入力ブロックの並び */
+    const CamelliaData *data;   /* 変換テーブル */
+    uint8_t *out;               /* 出力ブロックの並び */
+    size_t n;                   /* ブロック数 */
+    size_t blocks;              /* 1チャンクのブロック数 */
+    int inv;                    /* 0=順変換, 0以外=逆変換 */
+} Ecb;
+
+/* 複数ブロック一括処理のチャンク処理 */
+static int runEcb(const void *arg, size_t index) {
+    const Ecb *ecb = arg;
+    size_t offset, n;
+
+    offset = index * ecb->blocks;
+    n = ecb->n - offset < ecb->blocks ? ecb->n - offset : ecb->blocks;
+    return (ecb->inv ? camelliaDatarandInvBulk : camelliaDatarandBulk)(
+        ecb->in + 16 * offset, ecb->data, ecb->out + 16 * offset, n );
+}
+
+/* RFC 3713 規定のデータランダム化処理(並列処理)
+ * mt: 並列処理エンジン
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaMtDatarand(CamelliaMt *mt, const uint8_t *m,
+                       const CamelliaData *data, uint8_t *c, size_t n ) {
+    Ecb ecb;
+
+    ecb.in = m, ecb.data = data, ecb.out = c, ecb.n = n;
+    ecb.blocks = mt->chunk / 16, ecb.inv = 0;
+    return parallel(mt, runEcb, &ecb, (n + ecb.blocks - 1) / ecb.blocks);
+}
+
+/* RFC 3713 規定のデータランダム化処理の逆変換(並列処理)
+ * mt: 並列処理エンジン
+ * c[16*n]: RFC 3713 規定の変数C の並び
+ * data: 変換テーブル
+ * m[16*n]: RFC 3713 規定の変数M の並び (c と同一領域も可)
+ * n: ブロック数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaMtDatarandInv(CamelliaMt *mt, const uint8_t *c,
+                          const CamelliaData *data, uint8_t *m, size_t n ) {
+    Ecb ecb;
+
+    ecb.in = c, ecb.data = data, ecb.out = m, ecb.n = n;
+    ecb.blocks = mt->chunk / 16, ecb.inv = 1;
+    return parallel(mt, runEcb, &ecb, (n + ecb.blocks - 1) / ecb.blocks);
+}
+
+/* CTR モードの仕事 */
+typedef struct {  /* CTR の引数 */
+    const CamelliaData *data;  /* 変換テーブル */
+    uint8_t ctr[16];           /* 先頭のカウンタブロック */
+    const uint8_t *in;         /* 入力データ */
+    uint8_t *out;              /* 出力データ */
+    size_t n;                  /* ブロック数 */
+    size_t blocks;             /* 1チャンクのブロック数 */
+} Ctr;
+
+/* CTR モードのチャンク処理 */
+static int runCtr(const void *arg, size_t index) {
+    int status = -1;
+    const Ctr *ctr = arg;
+    CamelliaCtr state;
+    size_t offset, n;
+
+    offset = index * ctr->blocks;
+    n = ctr->n - offset < ctr->blocks ? ctr->n - offset : ctr->blocks;
+    if (camelliaCtrInit(&state, ctr->data, ctr->ctr) < 0)
+        goto error;
+    camelliaCounterAdd(state.ctr, offset);
+    if (camelliaCtrUpdate(&state, ctr->in + 16 * offset, ctr->out + 16 * offset, 16 * n) < 0)
+        goto error;
+    status = 0;
+error:
+    return status;
+}
+
+/* CTR モードの暗号化/復号(並列処理)
+ * camelliaCtrUpdate() と同じく前回の呼び出しの続きのカウンタ(端数バイト含む)から処理する
+ * mt: 並列処理エンジン
+ * ctr: CTR モード 状態
+ * in[len]: 入力データ
+ * out[len]: 出力データ (in と同一領域も可)
+ * len: データのバイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+int camelliaMtCtr(CamelliaMt *mt, CamelliaCtr *ctr,
+                  const uint8_t *in, uint8_t *out, size_t len ) {
+    int status = -1;
+    Ctr job;
+    size_t head;
+
+    head = sizeof(ctr->ks) - ctr->used;  /* 前回の鍵ストリームの残り */
+    if (head > len)
+        head = len;
+    if (camelliaCtrUpdate(ctr, in, out, head) < 0)
+        goto error;
+    in += head, out += head, len -= head;
+    job.data = ctr->data;
+    memcpy(job.ctr, ctr->ctr, sizeof(job.ctr));
+    job.in = in, job.out = out, job.n = len / 16;
+    job.blocks = mt->chunk / 16;
+    if (parallel(mt, runCtr, &job, (job.n + job.blocks - 1) / job.blocks) < 0)
+        goto error;
+    camelliaCounterAdd(ctr->ctr, job.n);
+    in += 16 * job.n, out += 16 * job.n, len -= 16 * job.n;
+    if (camelliaCtrUpdate(ctr, in, out, len) < 0)
+        goto error;
+    status = 0;
+error:
+    return status;
+}
+
+/* XTS モードの仕事 */
+typedef struct {  /* XTS の引数 */
+    const CamelliaData *data1;  /* 変換テーブル(データ用キー) */
+    const CamelliaData *data2;  /* 変換テーブル(調整値用キー) */
+    uint64_t sector;            /* 先頭のセクタ番号 */
+    size_t size;                /* セクタのバイト数 */
+    const uint8_t *in;          /* 入力データ */
+    uint8_t *out;               /* 出力データ */
+    size_t len;                 /* データのバイト数 */
+    size_t sectors;             /* 1チャンクのセクタ数 */
+    int dec;                    /* 0=暗号化, 0以外=復号 */
+} Xts;
+
+/* XTS モードのチャンク処理 */
+static int runXts(const void *arg, size_t index) {
+    int status = -1;
+    const Xts *xts = arg;
+    size_t offset, len;
+
+    offset = index * xts->sectors * xts->size;
+    len = xts->len - offset < xts->sectors * xts->size ? xts->len - offset : xts->sectors * xts->size;
+    if ((xts->dec ? camelliaXtsDecryptSectors : camelliaXtsEncryptSectors)(
+            xts->data1, xts->data2, xts->sector + index * xts->sectors, xts->size,
+            xts->in + offset, xts->out + offset, len ) < 0 )
+        goto error;
+    status = 0;
+error:
+    return status;
+}
+
+/* XTS モードの連続したセクタの処理(並列処理)
+ * dec: 0=暗号化, 0以外=復号
+ * その他の引数と戻り値は camelliaMtXtsEncrypt(), camelliaMtXtsDecrypt() と同じ
+ */
+static int xts(CamelliaMt *mt, const CamelliaData *data1,
+               const CamelliaData *data2, uint64_t sector, size_t size,
+               const uint8_t *in, uint8_t *out, size_t len, int dec ) {
+    int status = -1;
+    Xts job;
+    size_t nsectors;
+
+    if (size < 16)
+        goto error;
+    job.data1 = data1, job.data2 = data2, job.sector = sector, job.size = size;
+    job.in = in, job.out = out, job.len = len, job.dec = dec;
+    job.sectors = mt->chunk / size > 0 ? mt->chunk / size : 1;
+    nsectors = (len + size - 1) / size;
+    if (parallel(mt, runXts, &job, (nsectors + job.sectors - 1) / job.sectors) < 0)
+        goto error;
+    status = 0;
+error:
+    return status;
+}
+
+/* XTS モードの連続したセクタの暗号化(並列処理)
+ * mt: 並列処理エンジン
+ * data1: 変換テーブル(データ用キー, 暗号キー)
+ * data2: 変換テーブル(調整値用キー, 暗号キー)
+ * sector: 先頭のセクタ番号(以降のセクタは1ずつ増やす)
+ * size: セクタのバイト数(16以上)
+ * in[len]: 平文
+ * out[len]: 暗号文 (in と同一領域も可)
+ * len: データのバイト数(最後のセクタは size より短くてもよいが16以上)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, セクタが16バイト未満)
+ */
+int camelliaMtXtsEncrypt(CamelliaMt *mt, const CamelliaData *data1,
+                         const CamelliaData *data2, uint64_t sector, size_t size,
+                         const uint8_t *in, uint8_t *out, size_t len ) {
+    return xts(mt, data1, data2, sector, size, in, out, len, 0);
+}
+
+/* XTS モードの連続したセクタの復号(並列処理)
+ * mt: 並列処理エンジン
+ * data1: 変換テーブル(データ用キー, 暗号キーまたは復号キー, 暗号キーの場合は逆変換で復号する)
+ * data2: 変換テーブル(調整値用キー, 暗号キー)
+ * sector: 先頭のセクタ番号(以降のセクタは1ずつ増やす)
+ * size: セクタのバイト数(16以上)
+ * in[len]: 暗号文
+ * out[len]: 平文 (in と同一領域も可)
+ * len: データのバイト数(最後のセクタは size より短くてもよいが16以上)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, セクタが16バイト未満)
+ */
+int camelliaMtXtsDecrypt(CamelliaMt *mt, const CamelliaData *data1,
+                         const CamelliaData *data2, uint64_t sector, size_t size,
+                         const uint8_t *in, uint8_t *out, size_t len ) {
+    return xts(mt, data1, data2, sector, size, in, out, len, 1);
+}
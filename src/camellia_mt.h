@@ -0,0 +1,132 @@
+/* camellia_mt.h - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - multi-threaded bulk processing.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _INCLUDE_camellia_mt_h
+#define _INCLUDE_camellia_mt_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camellia.h"
+#include "camellia_ctr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* #ifdef __cplusplus */
+
+/* 並列処理エンジン
+ * データをチャンクに分割し, 常駐するワーカースレッドと呼び出し元スレッドで並列処理する
+ * (変換テーブルは全スレッドで読み出し専用として共有する)
+ * 1つのエンジンを複数のスレッドから同時に呼び出した場合は1呼び出しずつ順に処理する
+ */
+typedef struct CamelliaMt CamelliaMt;  /* 並列処理エンジン */
+
+/* 並列処理エンジンの生成
+ * threads: 処理するスレッド数(呼び出し元スレッドを含む, 0以下=CPU数)
+ * chunk: 1スレッドが一度に処理するバイト数(16の倍数に切り捨てる, 0=既定値 256KB)
+ * 戻り値: 並列処理エンジン (NULL=異常終了)
+ */
+extern CamelliaMt *camelliaMtCreate(int threads, size_t chunk);
+
+/* 並列処理エンジンの破棄
+ * mt: 並列処理エンジン (NULL の場合は何もしない)
+ */
+extern void camelliaMtDestroy(CamelliaMt *mt);
+
+/* 並列処理エンジンのスレッド数を取得
+ * mt: 並列処理エンジン
+ * 戻り値: スレッド数(呼び出し元スレッドを含む)
+ */
+extern int camelliaMtThreads(const CamelliaMt *mt);
+
+/* RFC 3713 規定のデータランダム化処理(並列処理)
+ * mt: 並列処理エンジン
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaMtDatarand(CamelliaMt *mt, const uint8_t *m,
+                              const CamelliaData *data, uint8_t *c, size_t n );
+
+/* RFC 3713 規定のデータランダム化処理の逆変換(並列処理)
+ * mt: 並列処理エンジン
+ * c[16*n]: RFC 3713 規定の変数C の並び
+ * data: 変換テーブル
+ * m[16*n]: RFC 3713 規定の変数M の並び (c と同一領域も可)
+ * n: ブロック数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaMtDatarandInv(CamelliaMt *mt, const uint8_t *c,
+                                 const CamelliaData *data, uint8_t *m, size_t n );
+
+/* CTR モードの暗号化/復号(並列処理)
+ * camelliaCtrUpdate() と同じく前回の呼び出しの続きのカウンタ(端数バイト含む)から処理する
+ * mt: 並列処理エンジン
+ * ctr: CTR モード 状態
+ * in[len]: 入力データ
+ * out[len]: 出力データ (in と同一領域も可)
+ * len: データのバイト数
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+extern int camelliaMtCtr(CamelliaMt *mt, CamelliaCtr *ctr,
+                         const uint8_t *in, uint8_t *out, size_t len );
+
+/* XTS モードの連続したセクタの暗号化(並列処理)
+ * mt: 並列処理エンジン
+ * data1: 変換テーブル(データ用キー, 暗号キー)
+ * data2: 変換テーブル(調整値用キー, 暗号キー)
+ * sector: 先頭のセクタ番号(以降のセクタは1ずつ増やす)
+ * size: セクタのバイト数(16以上)
+ * in[len]: 平文
+ * out[len]: 暗号文 (in と同一領域も可)
+ * len: データのバイト数(最後のセクタは size より短くてもよいが16以上)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, セクタが16バイト未満)
+ */
+extern int camelliaMtXtsEncrypt(CamelliaMt *mt, const CamelliaData *data1,
+                                const CamelliaData *data2, uint64_t sector, size_t size,
+                                const uint8_t *in, uint8_t *out, size_t len );
+
+/* XTS モードの連続したセクタの復号(並列処理)
+ * mt: 並列処理エンジン
+ * data1: 変換テーブル(データ用キー, 暗号キーまたは復号キー, 暗号キーの場合は逆変換で復号する)
+ * data2: 変換テーブル(調整値用キー, 暗号キー)
+ * sector: 先頭のセクタ番号(以降のセクタは1ずつ増やす)
+ * size: セクタのバイト数(16以上)
+ * in[len]: 暗号文
+ * out[len]: 平文 (in と同一領域も可)
+ * len: データのバイト数(最後のセクタは size より短くてもよいが16以上)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, セクタが16バイト未満)
+ */
+extern int camelliaMtXtsDecrypt(CamelliaMt *mt, const CamelliaData *data1,
+                                const CamelliaData *data2, uint64_t sector, size_t size,
+                                const uint8_t *in, uint8_t *out, size_t len );
+
+#ifdef __cplusplus
+}
+#endif  /* #ifdef __cplusplus */
+
+#endif  /* #ifndef _INCLUDE_camellia_mt_h */
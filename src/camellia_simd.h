@@ -0,0 +1,383 @@
+/* camellia_simd.h - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - byte-sliced SIMD kernel template.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* camellia_x86.c から以下のマクロを定義してベクトル幅ごとに取り込む
+ * VEC: ベクトル型
+ * LANES: 並行処理するブロック数(ベクトルのバイト数)
+ * TARGET: 関数の target 属性
+ * NAME(_name): 関数名(ベクトル幅ごとに一意にする)
+ * vload(_p, _j), vstore(_p, _j, _v): _j 番目のブロック列のロード/ストア
+ * vloadp(_pp, _j, _o), vstorep(_pp, _j, _o, _v): ポインタの並び _pp の指す位置から _o バイト目のブロック列のロード/ストア
+ * vtab(_p): 16バイトテーブルを全レーンにロード
+ * vset8(_b): 1バイト値を全バイトに複製
+ * vxor, vand, vor, vadd8, vsrl16, vshuf, vaesl, vzero, vunlo8, vunhi8: ベクトル演算
+ * vset64(_q): 8バイト値を全レーンに複製 (vaffine を定義する場合のみ)
+ * vaffine(_x, _a, _b), vaffinv(_x, _a, _b): GFNI のアフィン変換, 逆元とアフィン変換の合成
+ *  (定義すると S-box を GFNI で求める, _b は即値)
+ */
+
+/* 定数ベクトル */
+typedef struct {
+    VEC m0f, one, zero;            /* マスク定数 */
+#if defined(vaffine)
+    VEC pre1, pre4;                /* sbox1, sbox2, sbox3 と sbox4 の前処理のアフィン変換行列 */
+    VEC post1, post2, post3;       /* sbox1, sbox4 と sbox2 と sbox3 の後処理のアフィン変換行列 */
+#else  /* #if defined(vaffine) */
+    VEC isr;                       /* AESENCLAST の ShiftRows を打ち消すシャッフル */
+    VEC prelo1, prehi1;            /* sbox1, sbox2, sbox3 の前処理テーブル */
+    VEC prelo4, prehi4;            /* sbox4 の前処理テーブル */
+    VEC postlo1, posthi1;          /* sbox1, sbox4 の後処理テーブル */
+    VEC postlo2, posthi2;          /* sbox2 の後処理テーブル */
+    VEC postlo3, posthi3;          /* sbox3 の後処理テーブル */
+#endif  /* #if defined(vaffine) */
+} NAME(Const);
+
+/* 定数ベクトルの設定
+ */
+static FORCE_INLINE TARGET void NAME(init)(NAME(Const) *cs) {
+    cs->m0f = vset8(0x0f), cs->one = vset8(0x01), cs->zero = vzero();
+#if defined(vaffine)
+    cs->pre1 = vset64(camelliaX86.gfpre1), cs->pre4 = vset64(camelliaX86.gfpre4);
+    cs->post1 = vset64(camelliaX86.gfpost1);
+    cs->post2 = vset64(camelliaX86.gfpost2);
+    cs->post3 = vset64(camelliaX86.gfpost3);
+#else  /* #if defined(vaffine) */
+    cs->isr = vtab(camelliaX86.isr);
+    cs->prelo1 = vtab(camelliaX86.prelo1), cs->prehi1 = vtab(camelliaX86.prehi1);
+    cs->prelo4 = vtab(camelliaX86.prelo4), cs->prehi4 = vtab(camelliaX86.prehi4);
+    cs->postlo1 = vtab(camelliaX86.postlo1), cs->posthi1 = vtab(camelliaX86.posthi1);
+    cs->postlo2 = vtab(camelliaX86.postlo2), cs->posthi2 = vtab(camelliaX86.posthi2);
+    cs->postlo3 = vtab(camelliaX86.postlo3), cs->posthi3 = vtab(camelliaX86.posthi3);
+#endif  /* #if defined(vaffine) */
+}
+
+#if defined(vaffine)
+/* S-box 変換(GFNI のアフィン変換と GF(2^8) の逆元の合成)
+ * 前処理の定数項は全 S-box 共通, 後処理の定数項は S-box ごと(即値)
+ */
+#define SBOXG(_x, _pre, _post, _b) \
+    vaffinv(vaffine((_x), cs->_pre, GFNI_PRE), cs->_post, (_b))
+#define SBOX1(_x) SBOXG((_x), pre1, post1, GFNI_POST1)
+#define SBOX2(_x) SBOXG((_x), pre1, post2, GFNI_POST2)
+#define SBOX3(_x) SBOXG((_x), pre1, post3, GFNI_POST3)
+#define SBOX4(_x) SBOXG((_x), pre4, post1, GFNI_POST1)
+#else  /* #if defined(vaffine) */
+
+/* 4ビット単位のテーブル参照によるアフィン変換
+ */
+static FORCE_INLINE TARGET VEC NAME(filter)(VEC x, VEC lo, VEC hi,
+                                            const NAME(Const) *cs ) {
+    VEC xlo, xhi;
+
+    xlo = vand(x, cs->m0f);
+    xhi = vand(vsrl16(x, 4), cs->m0f);
+    return vxor(vshuf(lo, xlo), vshuf(hi, xhi));
+}
+
+/* S-box 変換(AES の S-box とアフィン変換の合成)
+ */
+static FORCE_INLINE TARGET VEC NAME(sbox)(VEC x, VEC prelo, VEC prehi,
+                                          VEC postlo, VEC posthi,
+                                          const NAME(Const) *cs ) {
+    x = NAME(filter)(x, prelo, prehi, cs);
+    x = vshuf(x, cs->isr);
+    x = vaesl(x, cs->zero);
+    x = NAME(filter)(x, postlo, posthi, cs);
+    return x;
+}
+#define SBOX1(_x) NAME(sbox)((_x), cs->prelo1, cs->prehi1, cs->postlo1, cs->posthi1, cs)
+#define SBOX2(_x) NAME(sbox)((_x), cs->prelo1, cs->prehi1, cs->postlo2, cs->posthi2, cs)
+#define SBOX3(_x) NAME(sbox)((_x), cs->prelo1, cs->prehi1, cs->postlo3, cs->posthi3, cs)
+#define SBOX4(_x) NAME(sbox)((_x), cs->prelo4, cs->prehi4, cs->postlo1, cs->posthi1, cs)
+#endif  /* #if defined(vaffine) */
+
+/* 16x16バイト行列の転置
+ * x[16]: 転置する行列(レーンごと)
+ */
+static FORCE_INLINE TARGET void NAME(transpose)(VEC *x) {
+    VEC t[16];
+    int n, i;
+
+    for (n = 0; n < 4; ++n) {
+        for (i = 0; i < 8; ++i) {
+            t[i * 2 + 0] = vunlo8(x[i], x[i + 8]);
+            t[i * 2 + 1] = vunhi8(x[i], x[i + 8]);
+        }
+        for (i = 0; i < 16; ++i)
+            x[i] = t[i];
+    }
+}
+
+/* RFC 3713 規定のF関数によるラウンド処理(バイトスライス)
+ * x[8]: F関数の入力
+ * y[8]: F関数の出力を排他的論理和する変数
+ * k[8]: サブキー(バイトごとに複製済み)
+ */
+static FORCE_INLINE TARGET void NAME(feistel)(const VEC *x, VEC *y,
+                                              const VEC *k,
+                                              const NAME(Const) *cs ) {
+    VEC t1, t2, t3, t4, t5, t6, t7, t8;
+    VEC y1, y2, y3, y4, y5, y6, y7, y8;
+
+    t1 = SBOX1(vxor(x[0], k[0]));
+    t2 = SBOX2(vxor(x[1], k[1]));
+    t3 = SBOX3(vxor(x[2], k[2]));
+    t4 = SBOX4(vxor(x[3], k[3]));
+    t5 = SBOX2(vxor(x[4], k[4]));
+    t6 = SBOX3(vxor(x[5], k[5]));
+    t7 = SBOX4(vxor(x[6], k[6]));
+    t8 = SBOX1(vxor(x[7], k[7]));
+    y8 = vxor(vxor(vxor(t1, t4), vxor(t5, t6)), t7);
+    y4 = vxor(vxor(y8, t1), vxor(t2, t3));
+    y7 = vxor(vxor(y4, t2), vxor(t7, t8));
+    y3 = vxor(vxor(y7, t1), vxor(t2, t4));
+    y6 = vxor(vxor(y3, t1), vxor(t6, t7));
+    y2 = vxor(vxor(y6, t1), vxor(t3, t4));
+    y5 = vxor(vxor(y2, t4), vxor(t5, t6));
+    y1 = vxor(vxor(y5, t2), vxor(t3, t4));
+    y[0] = vxor(y[0], y1), y[1] = vxor(y[1], y2);
+    y[2] = vxor(y[2], y3), y[3] = vxor(y[3], y4);
+    y[4] = vxor(y[4], y5), y[5] = vxor(y[5], y6);
+    y[6] = vxor(y[6], y7), y[7] = vxor(y[7], y8);
+}
+#undef SBOX1
+#undef SBOX2
+#undef SBOX3
+#undef SBOX4
+#if defined(vaffine)
+#undef SBOXG
+#endif  /* #if defined(vaffine) */
+
+/* 32ビット値の各バイトの論理積を1ビット左回転(バイトスライス)
+ * x[4]: 32ビット値(上位バイトから)
+ * k[4]: サブキー(バイトごとに複製済み)
+ * r[4]: 結果
+ */
+static FORCE_INLINE TARGET void NAME(androt)(const VEC *x, const VEC *k,
+                                             VEC *r, const NAME(Const) *cs ) {
+    VEC t[4];
+    int i;
+
+    for (i = 0; i < 4; ++i)
+        t[i] = vand(x[i], k[i]);
+    for (i = 0; i < 4; ++i)
+        r[i] = vor(vadd8(t[i], t[i]), vand(vsrl16(t[(i + 1) & 3], 7), cs->one));
+}
+
+/* RFC 3713 規定のFL関数とFLINV関数(バイトスライス)
+ * a[8]: FL関数で変換する変数
+ * b[8]: FLINV関数で変換する変数
+ * ka[8], kb[8]: サブキー(バイトごとに複製済み)
+ */
+static FORCE_INLINE TARGET void NAME(fl)(VEC *a, VEC *b,
+                                         const VEC *ka, const VEC *kb,
+                                         const NAME(Const) *cs ) {
+    VEC r[4];
+    int i;
+
+    NAME(androt)(a, ka, r, cs);
+    for (i = 0; i < 4; ++i)
+        a[i + 4] = vxor(a[i + 4], r[i]);
+    for (i = 0; i < 4; ++i)
+        a[i] = vxor(a[i], vor(a[i + 4], ka[i + 4]));
+    for (i = 0; i < 4; ++i)
+        b[i] = vxor(b[i], vor(b[i + 4], kb[i + 4]));
+    NAME(androt)(b, kb, r, cs);
+    for (i = 0; i < 4; ++i)
+        b[i + 4] = vxor(b[i + 4], r[i]);
+}
+
+/* RFC 3713 規定のデータランダム化処理のラウンド処理(バイトスライス)
+ * x[16]: 転置済みの変数M(処理後は転置前の変数C)
+ * kx[34][8]: 使用順のサブキー(バイトスライス)
+ * groups: 6ラウンド単位のグループ数
+ */
+static FORCE_INLINE TARGET void NAME(rounds)(VEC *x, const VEC (*kx)[8],
+                                             int groups,
+                                             const NAME(Const) *cs ) {
+    VEC y[16];
+    VEC *a = x + 0, *b = x + 8;
+    const VEC *k;
+    int i, j;
+
+    for (j = 0; j < 8; ++j)
+        a[j] = vxor(a[j], kx[0][j]), b[j] = vxor(b[j], kx[1][j]);
+    k = kx[2];
+    for (i = 0; i < groups; ++i) {
+        if (i > 0) {
+            NAME(fl)(a, b, k + 0, k + 8, cs);
+            k += 16;
+        }
+        NAME(feistel)(a, b, k +  0, cs);
+        NAME(feistel)(b, a, k +  8, cs);
+        NAME(feistel)(a, b, k + 16, cs);
+        NAME(feistel)(b, a, k + 24, cs);
+        NAME(feistel)(a, b, k + 32, cs);
+        NAME(feistel)(b, a, k + 40, cs);
+        k += 48;
+    }
+    for (j = 0; j < 8; ++j)
+        y[j + 0] = vxor(b[j], k[j + 0]), y[j + 8] = vxor(a[j], k[j + 8]);
+    for (j = 0; j < 16; ++j)
+        x[j] = y[j];
+}
+
+/* RFC 3713 規定のデータランダム化処理(LANES ブロック並行)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数(LANES の倍数)
+ * inv: 0=順変換, 0以外=逆変換
+ */
+static TARGET void NAME(datarand)(const uint8_t *m, const CamelliaData *data,
+                                  uint8_t *c, size_t n, int inv ) {
+    NAME(Const) cs;
+    uint64_t sk;
+    VEC kx[34][8];
+    VEC x[16];
+    int groups;
+    int i, j;
+
+    NAME(init)(&cs);
+    groups = GROUPS(data);
+    for (i = 0; i < groups * 8 + 2; ++i) {
+        sk = data->sk[SKI(i, groups, inv)];
+        for (j = 0; j < 8; ++j)
+            kx[i][j] = vset8((uint8_t)(sk >> (56 - j * 8)));
+    }
+    for (; n > 0; n -= LANES, m += 16 * LANES, c += 16 * LANES) {
+        for (j = 0; j < 16; ++j)
+            x[j] = vload(m, j);
+        NAME(transpose)(x);
+        NAME(rounds)(x, (const VEC (*)[8])kx, groups, &cs);
+        NAME(transpose)(x);
+        for (j = 0; j < 16; ++j)
+            vstore(c, j, x[j]);
+    }
+}
+
+/* 独立したブロック列のデータランダム化処理(LANES 列並行, 列ごとに異なる変換テーブル)
+ * 各列のサブキーを2個ずつ転置してバイトスライスにし, 列のブロック数分使い回す
+ * m[LANES][16*n]: RFC 3713 規定の変数M の並び
+ * data[LANES]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[LANES][16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[LANES][16]: CBC モードの初期化ベクタ(M に排他的論理和してから処理し, 処理後は最後の C に更新)
+ *  (NULL=列のブロックを独立に処理する)
+ * n: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+static TARGET void NAME(datarandMulti)(const uint8_t *const *m,
+                                       const CamelliaData *const *data,
+                                       uint8_t *const *c, uint8_t *const *iv,
+                                       size_t n, int groups ) {
+    NAME(Const) cs;
+    const uint8_t *sk[LANES];
+    VEC kx[34][8];
+    VEC x[16], v[16];
+    size_t o;
+    int i, j, l;
+
+    NAME(init)(&cs);
+    for (i = 0; i < groups * 8 + 2; i += 2) {  /* 順変換の使用順は sk[] の2個単位の並びと一致 */
+        for (l = 0; l < LANES; ++l)
+            sk[l] = (const uint8_t *)&data[l]->sk[SKI(i, groups, 0)];
+        for (j = 0; j < 16; ++j)
+            x[j] = vloadp(sk, j, 0);
+        NAME(transpose)(x);
+        for (j = 0; j < 8; ++j)  /* sk[] はホストのバイト順(リトルエンディアン) */
+            kx[i + 0][j] = x[7 - j], kx[i + 1][j] = x[15 - j];
+    }
+    if (iv != NULL)
+        for (j = 0; j < 16; ++j)
+            v[j] = vloadp(iv, j, 0);
+    for (o = 0; o < 16 * n; o += 16) {
+        for (j = 0; j < 16; ++j)
+            x[j] = vloadp(m, j, o);
+        if (iv != NULL)
+            for (j = 0; j < 16; ++j)
+                x[j] = vxor(x[j], v[j]);
+        NAME(transpose)(x);
+        NAME(rounds)(x, (const VEC (*)[8])kx, groups, &cs);
+        NAME(transpose)(x);
+        for (j = 0; j < 16; ++j)
+            vstorep(c, j, o, x[j]);
+        if (iv != NULL)
+            for (j = 0; j < 16; ++j)
+                v[j] = x[j];
+    }
+    if (iv != NULL)
+        for (j = 0; j < 16; ++j)
+            vstorep(iv, j, 0, v[j]);
+}
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(LANES キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数(LANES の倍数)
+ */
+static TARGET void NAME(keygen)(const uint8_t *kl, const uint8_t *kr,
+                                uint8_t *ka, uint8_t *kb, size_t n ) {
+    NAME(Const) cs;
+    VEC sigma[6][8];
+    VEC l[16], r[16], x[16], y[16];
+    VEC *a = x + 0, *b = x + 8;
+    int i, j;
+
+    NAME(init)(&cs);
+    for (i = 0; i < 6; ++i)
+        for (j = 0; j < 8; ++j)
+            sigma[i][j] = vset8((uint8_t)(camelliaX86.sigma[i] >> (56 - j * 8)));
+    for (; n > 0; n -= LANES, kl += 16 * LANES, kr += 16 * LANES, ka += 16 * LANES) {
+        for (j = 0; j < 16; ++j)
+            l[j] = vload(kl, j), r[j] = vload(kr, j);
+        NAME(transpose)(l);
+        NAME(transpose)(r);
+        for (j = 0; j < 16; ++j)
+            x[j] = vxor(l[j], r[j]);
+        NAME(feistel)(a, b, sigma[0], &cs);
+        NAME(feistel)(b, a, sigma[1], &cs);
+        for (j = 0; j < 16; ++j)
+            x[j] = vxor(x[j], l[j]);
+        NAME(feistel)(a, b, sigma[2], &cs);
+        NAME(feistel)(b, a, sigma[3], &cs);
+        for (j = 0; j < 16; ++j)
+            y[j] = x[j];
+        NAME(transpose)(y);
+        for (j = 0; j < 16; ++j)
+            vstore(ka, j, y[j]);
+        if (kb != NULL) {
+            for (j = 0; j < 16; ++j)
+                x[j] = vxor(x[j], r[j]);
+            NAME(feistel)(a, b, sigma[4], &cs);
+            NAME(feistel)(b, a, sigma[5], &cs);
+            NAME(transpose)(x);
+            for (j = 0; j < 16; ++j)
+                vstore(kb, j, x[j]);
+            kb += 16 * LANES;
+        }
+    }
+}
@@ -0,0 +1,221 @@
+/* camellia_stats.c - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - runtime statistics.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "camellia.h"
+#include "camellia_kernel.h"
+#include "camellia_stats.h"
+
+#if STATS
+#if KERNEL_X86
+#include <x86intrin.h>
+#define tsc() __rdtsc()
+#else  /* #if KERNEL_X86 */
+/* サイクルカウンタがない環境ではナノ秒で代用する */
+static uint64_t tsc(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+#endif  /* #if KERNEL_X86 */
+
+/* サイクル数を計測する複数ブロック一括の呼び出しの間隔(2のべき乗) */
+#define SAMPLE_INTERVAL 64
+
+/* 実行時統計の項目数(全て uint64_t) */
+#define FIELDS (sizeof(CamelliaStats) / sizeof(uint64_t))
+
+/* スレッドごとの実行時統計
+ */
+typedef struct Local Local;
+struct Local {  /* スレッドごとの実行時統計 */
+    CamelliaStats stats;  /* 集計値 (camelliaStatsThread から求めるため先頭に置く) */
+    unsigned tick;        /* 複数ブロック一括の呼び出しの抜き取り用カウンタ */
+    Local *next, *prev;   /* 登録中のスレッドの前後の要素 */
+};
+
+/* ファイル内共有変数 */
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;  /* 以下の変数の排他 */
+static pthread_once_t once = PTHREAD_ONCE_INIT;            /* key の初期化 */
+static pthread_key_t key;                                  /* スレッド終了の通知 */
+static Local *locals = NULL;                               /* 登録中のスレッド */
+static CamelliaStats retired;                              /* 終了したスレッドの集計値 */
+static CamelliaStats base;                                 /* camelliaStatsReset() した時点の集計値 */
+
+STATS_THREAD CamelliaStats *camelliaStatsThread = NULL;
+
+/* 実行時統計 a に b を加算
+ */
+static void add(CamelliaStats *a, const CamelliaStats *b) {
+    uint64_t *x = (uint64_t *)a;
+    const uint64_t *y = (const uint64_t *)b;
+    size_t n;
+
+    for (n = 0; n < FIELDS; ++n)
+        x[n] += STATS_LOAD(y[n]);
+}
+
+/* 全スレッドの集計値(mutex を取得して呼び出すこと)
+ */
+static void collect(CamelliaStats *stats) {
+    Local *local;
+
+    *stats = retired;
+    for (local = locals; local != NULL; local = local->next)
+        add(stats, &local->stats);
+}
+
+/* スレッド終了時に集計値を retired に移して登録を解除
+ */
+static void detach(void *arg) {
+    Local *local = arg;
+
+    pthread_mutex_lock(&mutex);
+    add(&retired, &local->stats);
+    if (local->prev != NULL)
+        local->prev->next = local->next;
+    else
+        locals = local->next;
+    if (local->next != NULL)
+        local->next->prev = local->prev;
+    pthread_mutex_unlock(&mutex);
+    camelliaStatsThread = NULL;
+    free(local);
+}
+
+static void init(void) {
+    pthread_key_create(&key, detach);
+}
+
+/* ヒストグラムの区間
+ */
+static unsigned bucket(uint64_t n) {
+    unsigned i = 0;
+
+    while (n >>= 1)
+        ++i;
+    return i < CAMELLIA_STATS_BUCKETS ? i : CAMELLIA_STATS_BUCKETS - 1;
+}
+
+/* 呼び出し元スレッドの実行時統計を登録
+ * 戻り値: 呼び出し元スレッドの実行時統計
+ */
+CamelliaStats *camelliaStatsAttach(void) {
+    static CamelliaStats lost;  /* 登録できなかったスレッドの集計値(取得の対象外) */
+    Local *local;
+
+    if (camelliaStatsThread != NULL)
+        return camelliaStatsThread;
+    local = calloc(1, sizeof(*local));
+    if (local == NULL)
+        return &lost;
+    pthread_once(&once, init);
+    pthread_mutex_lock(&mutex);
+    local->next = locals;
+    if (locals != NULL)
+        locals->prev = local;
+    locals = local;
+    pthread_mutex_unlock(&mutex);
+    pthread_setspecific(key, local);
+    camelliaStatsThread = &local->stats;
+    return camelliaStatsThread;
+}
+
+/* 複数ブロック一括の呼び出しの集計の開始
+ * 呼び出し回数, ブロック数, ブロック数のヒストグラムを集計し, 抜き取る呼び出しならサイクル数の計測を始める
+ * n: ブロック数
+ * 戻り値: 0以外=計測開始時のサイクル数, 0=抜き取らない
+ */
+uint64_t camelliaStatsBegin(size_t n) {
+    uint64_t begin = 0;
+
+    STATS_ADD(bulk, 1);
+    STATS_ADD(bulkBlocks, n);
+    STATS_ADD(batch[bucket(n)], 1);
+    if (camelliaStatsThread != NULL &&
+        (++((Local *)camelliaStatsThread)->tick & (SAMPLE_INTERVAL - 1)) == 0 )
+        begin = tsc();
+    return begin;
+}
+
+/* 複数ブロック一括の呼び出しの集計の終了
+ * begin: camelliaStatsBegin() の戻り値(0=何もしない)
+ * n: ブロック数
+ */
+void camelliaStatsEnd(uint64_t begin, size_t n) {
+    uint64_t t;
+
+    if (begin == 0)
+        return;
+    t = tsc() - begin;
+    STATS_ADD(sampled, 1);
+    STATS_ADD(sampledBlocks, n);
+    STATS_ADD(sampledCycles, t);
+    STATS_ADD(cycles[bucket(t)], 1);
+}
+
+/* 実行時統計の取得
+ * 全スレッド(終了したスレッドを含む)の集計値から, 前回 camelliaStatsReset() した時点の値を引いて返す
+ * stats: 実行時統計
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(集計なしでビルドした, stats は全て0)
+ */
+int camelliaStatsGet(CamelliaStats *stats) {
+    uint64_t *x = (uint64_t *)stats;
+    const uint64_t *y = (const uint64_t *)&base;
+    size_t n;
+
+    pthread_mutex_lock(&mutex);
+    collect(stats);
+    for (n = 0; n < FIELDS; ++n)
+        x[n] -= y[n];
+    pthread_mutex_unlock(&mutex);
+    return 0;
+}
+
+/* 実行時統計の初期化
+ * 他のスレッドの集計値は書き換えず, 現在の集計値を基準値として記録する
+ */
+void camelliaStatsReset(void) {
+    pthread_mutex_lock(&mutex);
+    collect(&base);
+    pthread_mutex_unlock(&mutex);
+}
+#else  /* #if STATS */
+/* 集計なしでビルドした場合は常に異常終了する */
+int camelliaStatsGet(CamelliaStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    return -1;
+}
+
+void camelliaStatsReset(void) {
+}
+#endif  /* #if STATS */
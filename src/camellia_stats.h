@@ -0,0 +1,80 @@
+/* camellia_stats.h - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - runtime statistics.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _INCLUDE_camellia_stats_h
+#define _INCLUDE_camellia_stats_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camellia.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* #ifdef __cplusplus */
+
+/* 集計するカーネル種別の数(CamelliaKernel の値を添字とする) */
+#define CAMELLIA_STATS_KERNELS 8
+
+/* ヒストグラムの区間数(区間 i は 2^i 以上 2^(i+1) 未満, 最後の区間は上限なし) */
+#define CAMELLIA_STATS_BUCKETS 24
+
+/* 実行時統計
+ * configure --enable-stats でビルドした場合のみ集計する(それ以外は処理に影響しない)
+ */
+typedef struct {  /* 実行時統計 */
+    uint64_t keysche[3];                          /* キースケジューリング処理のキー数(128bit, 192bit, 256bit キー) */
+    uint64_t keyscheBulk;                         /* camelliaKeyscheBulk() の呼び出し回数 */
+    uint64_t single;                              /* 1ブロック単位の呼び出し回数(camelliaDatarand(), camelliaDatarandInv()) */
+    uint64_t pair;                                /* 2ブロック並行の呼び出し回数(CCM など) */
+    uint64_t bulk;                                /* 複数ブロック一括の呼び出し回数 */
+    uint64_t bulkBlocks;                          /* 複数ブロック一括のブロック数 */
+    uint64_t multi;                               /* 独立したブロック列の呼び出し回数 */
+    uint64_t multiBlocks;                         /* 独立したブロック列のブロック数(列数 * 列ごとのブロック数) */
+    uint64_t kernelBytes[CAMELLIA_STATS_KERNELS]; /* カーネルごとの処理バイト数(端数ブロックを処理したカーネルを含む) */
+    uint64_t batch[CAMELLIA_STATS_BUCKETS];       /* 複数ブロック一括の呼び出しごとのブロック数のヒストグラム */
+    uint64_t cycles[CAMELLIA_STATS_BUCKETS];      /* 抜き取った複数ブロック一括の呼び出しごとのサイクル数のヒストグラム */
+    uint64_t sampled;                             /* 抜き取った呼び出し回数 */
+    uint64_t sampledBlocks;                       /* 抜き取った呼び出しのブロック数 */
+    uint64_t sampledCycles;                       /* 抜き取った呼び出しのサイクル数の合計 */
+} CamelliaStats;
+
+/* 実行時統計の取得
+ * 全スレッド(終了したスレッドを含む)の集計値から, 前回 camelliaStatsReset() した時点の値を引いて返す
+ * stats: 実行時統計
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(集計なしでビルドした, stats は全て0)
+ */
+extern int camelliaStatsGet(CamelliaStats *stats);
+
+/* 実行時統計の初期化
+ * 他のスレッドの集計値は書き換えず, 現在の集計値を基準値として記録する
+ */
+extern void camelliaStatsReset(void);
+
+#ifdef __cplusplus
+}
+#endif  /* #ifdef __cplusplus */
+
+#endif  /* #ifndef _INCLUDE_camellia_stats_h */
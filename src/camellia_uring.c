@@ -0,0 +1,499 @@
+/* camellia_uring.c - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - io_uring pipeline.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "camellia.h"
+#include "camellia_kernel.h"
+#include "camellia_ctr.h"
+#include "camellia_xts.h"
+#include "camellia_uring.h"
+
+#if HAVE_LINUX_IO_URING_H
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+
+/* バッファのアライメント */
+#define ALIGN 4096
+
+/* SQE の user_data (バッファ番号*2 + 0=読み込み, 1=書き出し, EVENT=完了通知) */
+#define EVENT (~(uint64_t)0)
+
+/* バッファ
+ */
+typedef struct {  /* バッファ */
+    uint8_t *p;       /* バッファ領域 */
+    uint64_t pos;     /* 処理範囲の先頭からの位置 */
+    size_t len;       /* データのバイト数 */
+    size_t done;      /* 読み込み/書き出し済みのバイト数 */
+    int status;       /* 暗号化/復号の結果 (0以上=正常終了, 0未満=異常終了) */
+} Buf;
+
+/* 非同期暗号化パイプライン
+ */
+struct CamelliaUring {
+    int fd;                          /* io_uring */
+    void *sqring, *cqring;           /* SQ, CQ リング (同一領域の場合あり) */
+    size_t sqsize, cqsize;           /* sqring, cqring のバイト数 */
+    unsigned *sqtail, *sqmask, *sqarray;
+    unsigned *cqhead, *cqtail, *cqmask;
+    struct io_uring_sqe *sqes;       /* SQE の並び */
+    struct io_uring_cqe *cqes;       /* CQE の並び */
+    unsigned sqentries;              /* SQE 数 */
+    unsigned pending;                /* 未提出の SQE 数 */
+    int fixed;                       /* 0以外=バッファを登録済み */
+    int efd;                         /* ワーカースレッドからの完了通知 (eventfd) */
+    uint64_t event;                  /* 完了通知の読み込み先 */
+    uint8_t *mem;                    /* バッファ領域 */
+    size_t bufsize;                  /* 1バッファのバイト数 */
+    unsigned depth;                  /* バッファ数 */
+    Buf *buf;                        /* バッファ */
+    const CamelliaUringCipher *cipher;  /* 処理中の暗号化/復号の条件 */
+    int broken;                      /* 0以外=完了待ちに失敗した(提出済みの読み込み/書き出しが残る) */
+    pthread_mutex_t mutex;           /* 以下の変数の排他 */
+    pthread_cond_t cond;             /* 暗号化/復号待ちのバッファ, 終了要求の通知 */
+    pthread_cond_t idle;             /* 暗号化/復号中のバッファがなくなった通知 */
+    unsigned *queue;                 /* 暗号化/復号待ちのバッファ番号 (FIFO) */
+    unsigned qhead, qcount;          /* queue の先頭, 個数 */
+    unsigned busy;                   /* 暗号化/復号中のバッファ数 */
+    unsigned *finished;              /* 暗号化/復号済みのバッファ番号 */
+    unsigned nfinished;              /* finished の個数 */
+    int quit;                        /* 0以外=ワーカースレッドの終了要求 */
+    int nthreads;                    /* 起動したワーカースレッド数 */
+    pthread_t threads[];             /* ワーカースレッド */
+};
+
+/* バッファの暗号化/復号
+ * u: 非同期暗号化パイプライン
+ * b: バッファ
+ * 戻り値: 0以上=正常終了, 0未満=異常終了
+ */
+static int transform(const CamelliaUring *u, Buf *b) {
+    int status = -1;
+    const CamelliaUringCipher *cipher = u->cipher;
+    CamelliaCtr ctr;
+
+    switch (cipher->mode) {
+    case CamelliaUringCtr:
+        if (camelliaCtrInit(&ctr, cipher->data, cipher->iv) < 0)
+            goto error;
+        camelliaCounterAdd(ctr.ctr, b->pos / 16);
+        if (camelliaCtrUpdate(&ctr, b->p, b->p, b->len) < 0)
+            goto error;
+        break;
+    case CamelliaUringXtsEncrypt:
+    case CamelliaUringXtsDecrypt:
+        if ((cipher->mode == CamelliaUringXtsDecrypt ? camelliaXtsDecryptSectors : camelliaXtsEncryptSectors)(
+                cipher->data, cipher->data2, cipher->sector + b->pos / cipher->size, cipher->size,
+                b->p, b->p, b->len ) < 0 )
+            goto error;
+        break;
+    default:
+        goto error;
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* ワーカースレッド */
+static void *worker(void *arg) {
+    CamelliaUring *u = arg;
+    const uint64_t one = 1;
+    unsigned i;
+    int status;
+
+    pthread_mutex_lock(&u->mutex);
+    for (;;) {
+        while (!u->quit && u->qcount == 0)
+            pthread_cond_wait(&u->cond, &u->mutex);
+        if (u->quit)
+            break;
+        i = u->queue[u->qhead];
+        u->qhead = (u->qhead + 1) % u->depth, --u->qcount;
+        ++u->busy;
+        pthread_mutex_unlock(&u->mutex);
+        status = transform(u, &u->buf[i]);
+        pthread_mutex_lock(&u->mutex);
+        if (--u->busy == 0)
+            pthread_cond_broadcast(&u->idle);
+        u->buf[i].status = status;
+        u->finished[u->nfinished++] = i;
+        if (u->nfinished == 1)  /* 呼び出し元スレッドに通知 */
+            while (write(u->efd, &one, sizeof(one)) < 0 && errno == EINTR);
+    }
+    pthread_mutex_unlock(&u->mutex);
+    return NULL;
+}
+
+/* SQE の取得(内容は0クリアする) */
+static struct io_uring_sqe *sqe(CamelliaUring *u) {
+    struct io_uring_sqe *e;
+    unsigned tail, index;
+
+    tail = *u->sqtail + u->pending;
+    index = tail & *u->sqmask;
+    e = &u->sqes[index];
+    memset(e, 0, sizeof(*e));
+    u->sqarray[index] = index;
+    ++u->pending;
+    return e;
+}
+
+/* 完了通知の読み込みを提出 */
+static void submitEvent(CamelliaUring *u) {
+    struct io_uring_sqe *e = sqe(u);
+
+    e->opcode = IORING_OP_READ;
+    e->fd = u->efd;
+    e->addr = (uintptr_t)&u->event;
+    e->len = sizeof(u->event);
+    e->off = (uint64_t)-1;
+    e->user_data = EVENT;
+}
+
+/* バッファの読み込み/書き出しの残りを提出
+ * u: 非同期暗号化パイプライン
+ * i: バッファ番号
+ * write: 0=読み込み, 0以外=書き出し
+ * fd: ファイル
+ * off: ファイルの処理範囲の開始位置
+ */
+static void submitIo(CamelliaUring *u, unsigned i, int write, int fd, uint64_t off) {
+    struct io_uring_sqe *e = sqe(u);
+    Buf *b = &u->buf[i];
+
+    if (u->fixed) {
+        e->opcode = write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+        e->buf_index = i;
+    }
+    else
+        e->opcode = write ? IORING_OP_WRITE : IORING_OP_READ;
+    e->fd = fd;
+    e->addr = (uintptr_t)(b->p + b->done);
+    e->len = b->len - b->done;
+    e->off = off + b->pos + b->done;
+    e->user_data = (uint64_t)i * 2 + !!write;
+}
+
+/* 提出と完了待ち
+ * 戻り値: 0以上=正常終了, 0未満=異常終了
+ */
+static int enter(CamelliaUring *u, unsigned wait) {
+    int status = -1;
+    long r;
+
+    __atomic_store_n(u->sqtail, *u->sqtail + u->pending, __ATOMIC_RELEASE);
+    for (;;) {
+        r = syscall(__NR_io_uring_enter, u->fd, u->pending, wait, wait > 0 ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+        if (r >= 0)
+            break;
+        if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+            goto error;
+    }
+    u->pending -= r;
+    status = 0;
+error:
+    return status;
+}
+
+/* 非同期暗号化パイプラインの生成
+ * depth: 登録するバッファ数(同時に処理中にできる読み込み/書き出しの数)
+ * bufsize: 1バッファのバイト数(16の倍数に切り捨てる)
+ * threads: 暗号化/復号するワーカースレッド数(0以下=CPU数)
+ * 戻り値: 非同期暗号化パイプライン (NULL=異常終了, io_uring が利用できない場合を含む)
+ */
+CamelliaUring *camelliaUringCreate(unsigned depth, size_t bufsize,
+                                   int threads ) {
+    CamelliaUring *u = NULL;
+    struct io_uring_params p;
+    struct iovec *iov = NULL;
+    long cpus;
+    unsigned i;
+
+    bufsize &= ~(size_t)15;
+    if (depth == 0 || bufsize == 0)
+        goto error;
+    if (threads <= 0) {
+        cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    u = calloc(1, sizeof(*u) + sizeof(*u->threads) * threads);
+    if (u == NULL)
+        goto error;
+    u->fd = -1, u->efd = -1;
+    u->sqring = MAP_FAILED, u->cqring = MAP_FAILED, u->sqes = MAP_FAILED;
+    pthread_mutex_init(&u->mutex, NULL);
+    pthread_cond_init(&u->cond, NULL);
+    pthread_cond_init(&u->idle, NULL);
+    u->depth = depth, u->bufsize = bufsize;
+
+    /* io_uring */
+    memset(&p, 0, sizeof(p));
+    u->fd = syscall(__NR_io_uring_setup, depth + 1, &p);
+    if (u->fd < 0)
+        goto error;
+    u->sqentries = p.sq_entries;
+    u->sqsize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    u->cqsize = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (u->cqsize > u->sqsize)
+            u->sqsize = u->cqsize;
+        u->cqsize = u->sqsize;
+    }
+    u->sqring = mmap(NULL, u->sqsize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_SQ_RING);
+    if (u->sqring == MAP_FAILED)
+        goto error;
+    if (p.features & IORING_FEAT_SINGLE_MMAP)
+        u->cqring = u->sqring;
+    else {
+        u->cqring = mmap(NULL, u->cqsize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_CQ_RING);
+        if (u->cqring == MAP_FAILED)
+            goto error;
+    }
+    u->sqes = mmap(NULL, p.sq_entries * sizeof(struct io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_SQES);
+    if (u->sqes == MAP_FAILED)
+        goto error;
+    u->sqtail = (unsigned *)((uint8_t *)u->sqring + p.sq_off.tail);
+    u->sqmask = (unsigned *)((uint8_t *)u->sqring + p.sq_off.ring_mask);
+    u->sqarray = (unsigned *)((uint8_t *)u->sqring + p.sq_off.array);
+    u->cqhead = (unsigned *)((uint8_t *)u->cqring + p.cq_off.head);
+    u->cqtail = (unsigned *)((uint8_t *)u->cqring + p.cq_off.tail);
+    u->cqmask = (unsigned *)((uint8_t *)u->cqring + p.cq_off.ring_mask);
+    u->cqes = (struct io_uring_cqe *)((uint8_t *)u->cqring + p.cq_off.cqes);
+
+    /* バッファ(登録できない場合は登録せずに使う) */
+    u->buf = calloc(depth, sizeof(*u->buf));
+    u->queue = calloc(depth, sizeof(*u->queue));
+    u->finished = calloc(depth, sizeof(*u->finished));
+    iov = calloc(depth, sizeof(*iov));
+    if (u->buf == NULL || u->queue == NULL || u->finished == NULL || iov == NULL)
+        goto error;
+    if (posix_memalign((void **)&u->mem, ALIGN, (bufsize + ALIGN - 1) / ALIGN * ALIGN * depth))
+        goto error;
+    for (i = 0; i < depth; ++i) {
+        u->buf[i].p = u->mem + (bufsize + ALIGN - 1) / ALIGN * ALIGN * i;
+        iov[i].iov_base = u->buf[i].p, iov[i].iov_len = bufsize;
+    }
+    u->fixed = syscall(__NR_io_uring_register, u->fd, IORING_REGISTER_BUFFERS, iov, depth) == 0;
+
+    /* 完了通知 */
+    u->efd = eventfd(0, EFD_CLOEXEC);
+    if (u->efd < 0)
+        goto error;
+    submitEvent(u);
+    if (enter(u, 0) < 0)
+        goto error;
+
+    /* ワーカースレッド */
+    for (u->nthreads = 0; u->nthreads < threads; ++u->nthreads)
+        if (pthread_create(&u->threads[u->nthreads], NULL, worker, u))
+            goto error;
+    free(iov);
+    return u;
+error:
+    free(iov);
+    camelliaUringDestroy(u);
+    return NULL;
+}
+
+/* 非同期暗号化パイプラインの破棄
+ * u: 非同期暗号化パイプライン (NULL の場合は何もしない)
+ */
+void camelliaUringDestroy(CamelliaUring *u) {
+    int n;
+
+    if (u == NULL)
+        return;
+    pthread_mutex_lock(&u->mutex);
+    u->quit = 1;
+    pthread_cond_broadcast(&u->cond);
+    pthread_mutex_unlock(&u->mutex);
+    for (n = 0; n < u->nthreads; ++n)
+        pthread_join(u->threads[n], NULL);
+    if (u->fd >= 0)
+        close(u->fd);  /* 提出済みの完了通知の読み込みも取り消される */
+    if (u->efd >= 0)
+        close(u->efd);
+    if (u->sqes != MAP_FAILED)
+        munmap(u->sqes, u->sqentries * sizeof(struct io_uring_sqe));
+    if (u->cqring != MAP_FAILED && u->cqring != u->sqring)
+        munmap(u->cqring, u->cqsize);
+    if (u->sqring != MAP_FAILED)
+        munmap(u->sqring, u->sqsize);
+    free(u->mem);
+    free(u->finished);
+    free(u->queue);
+    free(u->buf);
+    pthread_cond_destroy(&u->idle);
+    pthread_cond_destroy(&u->cond);
+    pthread_mutex_destroy(&u->mutex);
+    free(u);
+}
+
+/* ファイルの範囲の暗号化/復号
+ * 入力の全範囲を読み込み, 暗号化/復号して出力に書き出すまで戻らない
+ * (入力と出力に同じファイルの同じ位置を指定して書き換えてもよい)
+ * u: 非同期暗号化パイプライン
+ * cipher: 暗号化/復号の条件
+ * ifd: 入力ファイル
+ * ioff: 入力ファイルの開始位置
+ * ofd: 出力ファイル
+ * ooff: 出力ファイルの開始位置
+ * len: バイト数 (XTS モードは最後のセクタが size より短くてもよいが16以上)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, 入出力エラー, 入力が len より短い)
+ *  (完了待ちに失敗した場合は提出済みの読み込み/書き出しが残るので, 以降の呼び出しも異常終了する.
+ *   camelliaUringDestroy() で破棄すること)
+ */
+int camelliaUringRun(CamelliaUring *u, const CamelliaUringCipher *cipher,
+                     int ifd, uint64_t ioff, int ofd, uint64_t ooff,
+                     uint64_t len ) {
+    int status = -1;
+    int failed = 0;
+    size_t chunk;
+    uint64_t next = 0;
+    unsigned active = 0;
+    unsigned head, tail, i, n;
+    struct io_uring_cqe *cqe;
+    Buf *b;
+
+    if (u->broken)
+        goto error;
+    if (cipher->mode != CamelliaUringCtr) {
+        if (cipher->size < 16 || cipher->size > u->bufsize)
+            goto error;
+        chunk = u->bufsize / cipher->size * cipher->size;
+    }
+    else
+        chunk = u->bufsize;
+    u->cipher = cipher;
+    for (i = 0; i < u->depth && next < len; ++i, ++active) {
+        b = &u->buf[i];
+        b->pos = next, b->len = len - next < chunk ? len - next : chunk, b->done = 0;
+        next += b->len;
+        submitIo(u, i, 0, ifd, ioff);
+    }
+    while (active > 0) {
+        if (enter(u, 1) < 0) {  /* 完了を待てない場合は中断し, 以降は使えなくする */
+            pthread_mutex_lock(&u->mutex);
+            u->qcount = 0;  /* 暗号化/復号待ちのバッファは取り下げる */
+            while (u->busy > 0)  /* cipher を参照し終えるまで待つ */
+                pthread_cond_wait(&u->idle, &u->mutex);
+            u->nfinished = 0;
+            pthread_mutex_unlock(&u->mutex);
+            u->broken = 1;
+            failed = 1;
+            break;
+        }
+        head = *u->cqhead;
+        tail = __atomic_load_n(u->cqtail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            cqe = &u->cqes[head & *u->cqmask];
+            if (cqe->user_data == EVENT) {  /* 暗号化/復号済みのバッファを書き出す */
+                pthread_mutex_lock(&u->mutex);
+                for (n = 0; n < u->nfinished; ++n) {
+                    b = &u->buf[i = u->finished[n]];
+                    if (b->status < 0)
+                        failed = 1;
+                    if (failed)
+                        --active;
+                    else
+                        b->done = 0, submitIo(u, i, 1, ofd, ooff);
+                }
+                u->nfinished = 0;
+                pthread_mutex_unlock(&u->mutex);
+                submitEvent(u);
+                continue;
+            }
+            b = &u->buf[i = cqe->user_data / 2];
+            if (cqe->res == -EINTR || cqe->res == -EAGAIN) {  /* 再提出 */
+                submitIo(u, i, cqe->user_data & 1, cqe->user_data & 1 ? ofd : ifd, cqe->user_data & 1 ? ooff : ioff);
+                continue;
+            }
+            if (cqe->res <= 0)  /* 入出力エラー, 入力が短い */
+                failed = 1;
+            else
+                b->done += cqe->res;
+            if (failed) {
+                --active;
+                continue;
+            }
+            if (b->done < b->len) {  /* 残りを再提出 */
+                submitIo(u, i, cqe->user_data & 1, cqe->user_data & 1 ? ofd : ifd, cqe->user_data & 1 ? ooff : ioff);
+                continue;
+            }
+            if (!(cqe->user_data & 1)) {  /* 読み込み完了: ワーカースレッドで暗号化/復号 */
+                pthread_mutex_lock(&u->mutex);
+                u->queue[(u->qhead + u->qcount++) % u->depth] = i;
+                pthread_cond_signal(&u->cond);
+                pthread_mutex_unlock(&u->mutex);
+            }
+            else if (next < len) {  /* 書き出し完了: 次の範囲を読み込む */
+                b->pos = next, b->len = len - next < chunk ? len - next : chunk, b->done = 0;
+                next += b->len;
+                submitIo(u, i, 0, ifd, ioff);
+            }
+            else
+                --active;
+        }
+        __atomic_store_n(u->cqhead, head, __ATOMIC_RELEASE);
+    }
+    if (failed)
+        goto error;
+    status = 0;
+error:
+    u->cipher = NULL;
+    return status;
+}
+#else  /* #if HAVE_LINUX_IO_URING_H */
+/* io_uring が利用できない環境では常に異常終了する */
+CamelliaUring *camelliaUringCreate(unsigned depth, size_t bufsize,
+                                   int threads ) {
+    (void)depth, (void)bufsize, (void)threads;
+    errno = ENOSYS;
+    return NULL;
+}
+
+void camelliaUringDestroy(CamelliaUring *u) {
+    (void)u;
+}
+
+int camelliaUringRun(CamelliaUring *u, const CamelliaUringCipher *cipher,
+                     int ifd, uint64_t ioff, int ofd, uint64_t ooff,
+                     uint64_t len ) {
+    (void)u, (void)cipher, (void)ifd, (void)ioff, (void)ofd, (void)ooff, (void)len;
+    errno = ENOSYS;
+    return -1;
+}
+#endif  /* #if HAVE_LINUX_IO_URING_H */
@@ -0,0 +1,99 @@
+/* camellia_uring.h - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - io_uring pipeline.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _INCLUDE_camellia_uring_h
+#define _INCLUDE_camellia_uring_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camellia.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* #ifdef __cplusplus */
+
+/* io_uring による非同期暗号化パイプライン
+ * 登録済みバッファに io_uring で読み込み, ワーカースレッドでその場で暗号化/復号し,
+ * 同じバッファから io_uring で書き出す (読み込み, 暗号化/復号, 書き出しは
+ * バッファごとに並行して進み, 処理中にメモリの確保やコピーを行わない)
+ * io_uring が利用できない環境(ヘッダがない, カーネルが対応していない)では生成に失敗する
+ * 1つのパイプラインを複数のスレッドから同時に呼び出さないこと
+ */
+typedef struct CamelliaUring CamelliaUring;  /* 非同期暗号化パイプライン */
+
+/* 暗号利用モード
+ */
+typedef enum {  /* 暗号利用モード */
+    CamelliaUringCtr=0,       /* CTR モードの暗号化/復号 */
+    CamelliaUringXtsEncrypt,  /* XTS モードの暗号化 */
+    CamelliaUringXtsDecrypt   /* XTS モードの復号 */
+} CamelliaUringMode;
+typedef struct {  /* 暗号化/復号の条件 */
+    CamelliaUringMode mode;     /* 暗号利用モード */
+    const CamelliaData *data;   /* 変換テーブル(XTS モードはデータ用キー) */
+    const CamelliaData *data2;  /* 変換テーブル(XTS モードの調整値用キー, CTR モードは未使用) */
+    uint8_t iv[16];             /* CTR モードの先頭のカウンタブロック(16バイトごとに1加算する) */
+    uint64_t sector;            /* XTS モードの先頭のセクタ番号(以降のセクタは1ずつ増やす) */
+    size_t size;                /* XTS モードのセクタのバイト数(16以上, バッファのバイト数以下) */
+} CamelliaUringCipher;
+
+/* 非同期暗号化パイプラインの生成
+ * depth: 登録するバッファ数(同時に処理中にできる読み込み/書き出しの数)
+ * bufsize: 1バッファのバイト数(16の倍数に切り捨てる)
+ * threads: 暗号化/復号するワーカースレッド数(0以下=CPU数)
+ * 戻り値: 非同期暗号化パイプライン (NULL=異常終了, io_uring が利用できない場合を含む)
+ */
+extern CamelliaUring *camelliaUringCreate(unsigned depth, size_t bufsize,
+                                          int threads );
+
+/* 非同期暗号化パイプラインの破棄
+ * u: 非同期暗号化パイプライン (NULL の場合は何もしない)
+ */
+extern void camelliaUringDestroy(CamelliaUring *u);
+
+/* ファイルの範囲の暗号化/復号
+ * 入力の全範囲を読み込み, 暗号化/復号して出力に書き出すまで戻らない
+ * (入力と出力に同じファイルの同じ位置を指定して書き換えてもよい)
+ * u: 非同期暗号化パイプライン
+ * cipher: 暗号化/復号の条件
+ * ifd: 入力ファイル
+ * ioff: 入力ファイルの開始位置
+ * ofd: 出力ファイル
+ * ooff: 出力ファイルの開始位置
+ * len: バイト数 (XTS モードは最後のセクタが size より短くてもよいが16以上)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, 入出力エラー, 入力が len より短い)
+ *  (完了待ちに失敗した場合は提出済みの読み込み/書き出しが残るので, 以降の呼び出しも異常終了する.
+ *   camelliaUringDestroy() で破棄すること)
+ */
+extern int camelliaUringRun(CamelliaUring *u, const CamelliaUringCipher *cipher,
+                            int ifd, uint64_t ioff, int ofd, uint64_t ooff,
+                            uint64_t len );
+
+#ifdef __cplusplus
+}
+#endif  /* #ifdef __cplusplus */
+
+#endif  /* #ifndef _INCLUDE_camellia_uring_h */
@@ -0,0 +1,473 @@
+/* camellia_x86.c - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - x86 SIMD kernels.
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camellia.h"
+#include "camellia_kernel.h"
+
+#if KERNEL_X86
+#include <immintrin.h>
+
+#define FORCE_INLINE __inline__ __attribute__((always_inline))
+
+/* ファイル内共有定数
+ * Camellia の S-box を AES の S-box で求めるためのアフィン変換テーブル
+ * (4ビット単位の参照テーブル, lo=下位4ビット, hi=上位4ビット),
+ * GFNI で求めるためのアフィン変換行列(定数項は GFNI_* の即値)
+ * と RFC 3713 規定の定数 Sigma1 ～ Sigma6
+ */
+static const struct {
+    uint64_t sigma[6];
+    uint64_t gfpre1, gfpre4, gfpost1, gfpost2, gfpost3;
+    uint8_t isr[16];
+    uint8_t prelo1[16], prehi1[16], prelo4[16], prehi4[16];
+    uint8_t postlo1[16], posthi1[16], postlo2[16], posthi2[16], postlo3[16], posthi3[16];
+} camelliaX86 = {
+    .sigma   = { 0xa09e667f3bcc908b, 0xb67ae8584caa73b2, 0xc6ef372fe94f82be,
+                 0x54ff53a5f1d36f1c, 0x10e527fade682d1d, 0xb05688c2b3e6c1fd },
+    .gfpre1  = 0xff38108aa65cc0bc,
+    .gfpre4  = 0xff1c0845532e605e,
+    .gfpost1 = 0xeb36241e33d3b1b7,
+    .gfpost2 = 0xb7eb36241e33d3b1,
+    .gfpost3 = 0x36241e33d3b1b7eb,
+    .isr     = { 0x00, 0x0d, 0x0a, 0x07, 0x04, 0x01, 0x0e, 0x0b, 0x08, 0x05, 0x02, 0x0f, 0x0c, 0x09, 0x06, 0x03 },
+    .prelo1  = { 0x08, 0x09, 0x11, 0x10, 0xb9, 0xb8, 0xa0, 0xa1, 0xa3, 0xa2, 0xba, 0xbb, 0x12, 0x13, 0x0b, 0x0a },
+    .prehi1  = { 0x00, 0xa7, 0x93, 0x34, 0x61, 0xc6, 0xf2, 0x55, 0xd9, 0x7e, 0x4a, 0xed, 0xb8, 0x1f, 0x2b, 0x8c },
+    .prelo4  = { 0x08, 0x11, 0xb9, 0xa0, 0xa3, 0xba, 0x12, 0x0b, 0xaf, 0xb6, 0x1e, 0x07, 0x04, 0x1d, 0xb5, 0xac },
+    .prehi4  = { 0x00, 0x93, 0x61, 0xf2, 0xd9, 0x4a, 0xb8, 0x2b, 0x01, 0x92, 0x60, 0xf3, 0xd8, 0x4b, 0xb9, 0x2a },
+    .postlo1 = { 0x11, 0x82, 0x84, 0x17, 0x3e, 0xad, 0xab, 0x38, 0x71, 0xe2, 0xe4, 0x77, 0x5e, 0xcd, 0xcb, 0x58 },
+    .posthi1 = { 0x00, 0xb8, 0xd9, 0x61, 0xa0, 0x18, 0x79, 0xc1, 0xa8, 0x10, 0x71, 0xc9, 0x08, 0xb0, 0xd1, 0x69 },
+    .postlo2 = { 0x22, 0x05, 0x09, 0x2e, 0x7c, 0x5b, 0x57, 0x70, 0xe2, 0xc5, 0xc9, 0xee, 0xbc, 0x9b, 0x97, 0xb0 },
+    .posthi2 = { 0x00, 0x71, 0xb3, 0xc2, 0x41, 0x30, 0xf2, 0x83, 0x51, 0x20, 0xe2, 0x93, 0x10, 0x61, 0xa3, 0xd2 },
+    .postlo3 = { 0x88, 0x41, 0x42, 0x8b, 0x1f, 0xd6, 0xd5, 0x1c, 0xb8, 0x71, 0x72, 0xbb, 0x2f, 0xe6, 0xe5, 0x2c },
+    .posthi3 = { 0x00, 0x5c, 0xec, 0xb0, 0x50, 0x0c, 0xbc, 0xe0, 0x54, 0x08, 0xb8, 0xe4, 0x04, 0x58, 0xe8, 0xb4 }
+};
+
+/* AES-NI, AVX (128ビット, 16ブロック並行)
+ */
+#define VEC __m128i
+#define LANES 16
+#define TARGET __attribute__((target("aes,avx")))
+#define NAME(_name) _name##Aesni
+#define vload(_p, _j) _mm_loadu_si128((const __m128i *)((_p) + (_j) * 16))
+#define vstore(_p, _j, _v) _mm_storeu_si128((__m128i *)((_p) + (_j) * 16), (_v))
+#define vloadp(_pp, _j, _o) _mm_loadu_si128((const __m128i *)((_pp)[_j] + (_o)))
+#define vstorep(_pp, _j, _o, _v) _mm_storeu_si128((__m128i *)((_pp)[_j] + (_o)), (_v))
+#define vtab(_p) _mm_loadu_si128((const __m128i *)(_p))
+#define vset8(_b) _mm_set1_epi8((char)(_b))
+#define vxor _mm_xor_si128
+#define vand _mm_and_si128
+#define vor _mm_or_si128
+#define vadd8 _mm_add_epi8
+#define vsrl16 _mm_srli_epi16
+#define vshuf _mm_shuffle_epi8
+#define vaesl _mm_aesenclast_si128
+#define vzero _mm_setzero_si128
+#define vunlo8 _mm_unpacklo_epi8
+#define vunhi8 _mm_unpackhi_epi8
+#include "camellia_simd.h"
+#undef VEC
+#undef LANES
+#undef TARGET
+#undef NAME
+#undef vload
+#undef vstore
+#undef vloadp
+#undef vstorep
+#undef vtab
+#undef vset8
+#undef vxor
+#undef vand
+#undef vor
+#undef vadd8
+#undef vsrl16
+#undef vshuf
+#undef vaesl
+#undef vzero
+#undef vunlo8
+#undef vunhi8
+
+/* AVX2, VAES (256ビット, 32ブロック並行)
+ * 下位レーンにブロック0-15, 上位レーンにブロック16-31を置く
+ */
+#define VEC __m256i
+#define LANES 32
+#define TARGET __attribute__((target("aes,avx2,vaes")))
+#define NAME(_name) _name##Vaes
+#define vload(_p, _j) \
+    _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)((_p) + (_j) * 16))), \
+                            _mm_loadu_si128((const __m128i *)((_p) + ((_j) + 16) * 16)), 1 )
+#define vstore(_p, _j, _v) \
+    do { \
+        _mm_storeu_si128((__m128i *)((_p) + (_j) * 16), _mm256_castsi256_si128(_v)); \
+        _mm_storeu_si128((__m128i *)((_p) + ((_j) + 16) * 16), _mm256_extracti128_si256((_v), 1)); \
+    } while (0)
+#define vloadp(_pp, _j, _o) \
+    _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)((_pp)[_j] + (_o)))), \
+                            _mm_loadu_si128((const __m128i *)((_pp)[(_j) + 16] + (_o))), 1 )
+#define vstorep(_pp, _j, _o, _v) \
+    do { \
+        _mm_storeu_si128((__m128i *)((_pp)[_j] + (_o)), _mm256_castsi256_si128(_v)); \
+        _mm_storeu_si128((__m128i *)((_pp)[(_j) + 16] + (_o)), _mm256_extracti128_si256((_v), 1)); \
+    } while (0)
+#define vtab(_p) _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)(_p)))
+#define vset8(_b) _mm256_set1_epi8((char)(_b))
+#define vxor _mm256_xor_si256
+#define vand _mm256_and_si256
+#define vor _mm256_or_si256
+#define vadd8 _mm256_add_epi8
+#define vsrl16 _mm256_srli_epi16
+#define vshuf _mm256_shuffle_epi8
+#define vaesl _mm256_aesenclast_epi128
+#define vzero _mm256_setzero_si256
+#define vunlo8 _mm256_unpacklo_epi8
+#define vunhi8 _mm256_unpackhi_epi8
+#include "camellia_simd.h"
+#undef VEC
+#undef LANES
+#undef TARGET
+#undef NAME
+#undef vload
+#undef vstore
+#undef vloadp
+#undef vstorep
+#undef vtab
+#undef vset8
+#undef vxor
+#undef vand
+#undef vor
+#undef vadd8
+#undef vsrl16
+#undef vshuf
+#undef vaesl
+#undef vzero
+#undef vunlo8
+#undef vunhi8
+
+/* AVX-512, VAES, GFNI (512ビット, 64ブロック並行)
+ * 128ビットレーン0-3にブロック0-15, 16-31, 32-47, 48-63を置き, S-box は GFNI で求める
+ */
+#define GFNI_PRE   0x08  /* sbox1 ～ sbox4 の前処理の定数項 */
+#define GFNI_POST1 0x6e  /* sbox1, sbox4 の後処理の定数項 */
+#define GFNI_POST2 0xdc  /* sbox2 の後処理の定数項 */
+#define GFNI_POST3 0x37  /* sbox3 の後処理の定数項 */
+#define VEC __m512i
+#define LANES 64
+#define TARGET __attribute__((target("avx512f,avx512bw,gfni")))
+#define NAME(_name) _name##Avx512
+#define vload(_p, _j) \
+    _mm512_inserti64x4(_mm512_castsi256_si512(vload4((_p) + (_j) * 16, (_p) + ((_j) + 16) * 16)), \
+                       vload4((_p) + ((_j) + 32) * 16, (_p) + ((_j) + 48) * 16), 1 )
+#define vstore(_p, _j, _v) \
+    do { \
+        _mm_storeu_si128((__m128i *)((_p) + (_j) * 16), _mm512_extracti32x4_epi32((_v), 0)); \
+        _mm_storeu_si128((__m128i *)((_p) + ((_j) + 16) * 16), _mm512_extracti32x4_epi32((_v), 1)); \
+        _mm_storeu_si128((__m128i *)((_p) + ((_j) + 32) * 16), _mm512_extracti32x4_epi32((_v), 2)); \
+        _mm_storeu_si128((__m128i *)((_p) + ((_j) + 48) * 16), _mm512_extracti32x4_epi32((_v), 3)); \
+    } while (0)
+#define vloadp(_pp, _j, _o) \
+    _mm512_inserti64x4(_mm512_castsi256_si512(vload4((_pp)[_j] + (_o), (_pp)[(_j) + 16] + (_o))), \
+                       vload4((_pp)[(_j) + 32] + (_o), (_pp)[(_j) + 48] + (_o)), 1 )
+#define vstorep(_pp, _j, _o, _v) \
+    do { \
+        _mm_storeu_si128((__m128i *)((_pp)[_j] + (_o)), _mm512_extracti32x4_epi32((_v), 0)); \
+        _mm_storeu_si128((__m128i *)((_pp)[(_j) + 16] + (_o)), _mm512_extracti32x4_epi32((_v), 1)); \
+        _mm_storeu_si128((__m128i *)((_pp)[(_j) + 32] + (_o)), _mm512_extracti32x4_epi32((_v), 2)); \
+        _mm_storeu_si128((__m128i *)((_pp)[(_j) + 48] + (_o)), _mm512_extracti32x4_epi32((_v), 3)); \
+    } while (0)
+#define vload4(_p0, _p1) \
+    _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(_p0))), \
+                            _mm_loadu_si128((const __m128i *)(_p1)), 1 )
+#define vtab(_p) _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)(_p)))
+#define vset8(_b) _mm512_set1_epi8((char)(_b))
+#define vset64(_q) _mm512_set1_epi64((long long)(_q))
+#define vxor _mm512_xor_si512
+#define vand _mm512_and_si512
+#define vor _mm512_or_si512
+#define vadd8 _mm512_add_epi8
+#define vsrl16 _mm512_srli_epi16
+#define vshuf _mm512_shuffle_epi8
+#define vzero _mm512_setzero_si512
+#define vunlo8 _mm512_unpacklo_epi8
+#define vunhi8 _mm512_unpackhi_epi8
+#define vaffine _mm512_gf2p8affine_epi64_epi8
+#define vaffinv _mm512_gf2p8affineinv_epi64_epi8
+#include "camellia_simd.h"
+#undef GFNI_PRE
+#undef GFNI_POST1
+#undef GFNI_POST2
+#undef GFNI_POST3
+#undef VEC
+#undef LANES
+#undef TARGET
+#undef NAME
+#undef vload
+#undef vstore
+#undef vloadp
+#undef vstorep
+#undef vload4
+#undef vtab
+#undef vset8
+#undef vset64
+#undef vxor
+#undef vand
+#undef vor
+#undef vadd8
+#undef vsrl16
+#undef vshuf
+#undef vzero
+#undef vunlo8
+#undef vunhi8
+#undef vaffine
+#undef vaffinv
+
+/* PCLMULQDQ による GHASH
+ * バイト順を反転した値で計算する
+ */
+#define TARGET_CLMUL __attribute__((target("pclmul,ssse3")))
+
+/* 128ビット x 128ビットの繰り上がりなし乗算(リダクションなし)を加算
+ * a, b: 乗数
+ * lo, mid, hi: 積の下位, 中位, 上位の累積値
+ */
+static FORCE_INLINE TARGET_CLMUL void clmulAcc(__m128i a, __m128i b,
+                                               __m128i *lo, __m128i *mid,
+                                               __m128i *hi ) {
+    *lo = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, b, 0x00));
+    *mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x01));
+    *mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x10));
+    *hi = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, b, 0x11));
+}
+
+/* バイト順を反転してロード
+ * p[16]: ロードする値
+ * 戻り値: バイト順を反転した値
+ */
+static FORCE_INLINE TARGET_CLMUL __m128i clmulLoad(const uint8_t *p) {
+    return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)p),
+                            _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15) );
+}
+
+/* 256ビットの積を GF(2^128) の値にリダクション
+ * lo, mid, hi: 積の下位, 中位, 上位
+ * 戻り値: リダクションした値
+ */
+static FORCE_INLINE TARGET_CLMUL __m128i clmulReduce(__m128i lo, __m128i mid,
+                                                     __m128i hi ) {
+    __m128i t1, t2, t3;
+
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+    /* ビット順反転の補正(1ビット左シフト) */
+    t1 = _mm_srli_epi32(lo, 31), t2 = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1), hi = _mm_slli_epi32(hi, 1);
+    t3 = _mm_srli_si128(t1, 12), t2 = _mm_slli_si128(t2, 4), t1 = _mm_slli_si128(t1, 4);
+    lo = _mm_or_si128(lo, t1), hi = _mm_or_si128(hi, t2), hi = _mm_or_si128(hi, t3);
+    /* x^128 + x^7 + x^2 + x + 1 によるリダクション */
+    t1 = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30)),
+                       _mm_slli_epi32(lo, 25) );
+    t2 = _mm_srli_si128(t1, 4), t1 = _mm_slli_si128(t1, 12);
+    lo = _mm_xor_si128(lo, t1);
+    t1 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2)),
+                       _mm_srli_epi32(lo, 7) );
+    t1 = _mm_xor_si128(t1, t2);
+    lo = _mm_xor_si128(lo, t1);
+    return _mm_xor_si128(hi, lo);
+}
+
+/* GHASH 処理(PCLMULQDQ で4ブロック単位の集約リダクション)
+ * x[16]: GHASH 途中結果(処理後の値に更新)
+ * hp[4][16]: H, H^2, H^3, H^4
+ * p[16*n]: 入力ブロックの並び
+ * n: ブロック数
+ */
+TARGET_CLMUL void camelliaGhashClmul(uint8_t *x, const uint8_t (*hp)[16],
+                                     const uint8_t *p, size_t n ) {
+    __m128i h1, h2, h3, h4;
+    __m128i y, d0, d1, d2, d3;
+    __m128i lo, mid, hi;
+
+    h1 = clmulLoad(hp[0]), h2 = clmulLoad(hp[1]), h3 = clmulLoad(hp[2]), h4 = clmulLoad(hp[3]);
+    y = clmulLoad(x);
+    for (; n >= 4; n -= 4, p += 64) {
+        d0 = _mm_xor_si128(clmulLoad(p + 0), y);
+        d1 = clmulLoad(p + 16), d2 = clmulLoad(p + 32), d3 = clmulLoad(p + 48);
+        lo = mid = hi = _mm_setzero_si128();
+        clmulAcc(d0, h4, &lo, &mid, &hi);
+        clmulAcc(d1, h3, &lo, &mid, &hi);
+        clmulAcc(d2, h2, &lo, &mid, &hi);
+        clmulAcc(d3, h1, &lo, &mid, &hi);
+        y = clmulReduce(lo, mid, hi);
+    }
+    for (; n > 0; --n, p += 16) {
+        d0 = _mm_xor_si128(clmulLoad(p), y);
+        lo = mid = hi = _mm_setzero_si128();
+        clmulAcc(d0, h1, &lo, &mid, &hi);
+        y = clmulReduce(lo, mid, hi);
+    }
+    _mm_storeu_si128((__m128i *)x,
+                     _mm_shuffle_epi8(y, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)) );
+}
+
+/* CPU の対応機能を取得
+ * 戻り値: CPU_* の論理和
+ */
+unsigned camelliaCpuid(void) {
+    unsigned cpu = 0;
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("aes") && __builtin_cpu_supports("avx"))
+        cpu |= CPU_AESNI;
+    if (__builtin_cpu_supports("aes") && __builtin_cpu_supports("avx2") &&
+        __builtin_cpu_supports("vaes") )
+        cpu |= CPU_VAES;
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3"))
+        cpu |= CPU_CLMUL;
+    if (__builtin_cpu_supports("sse2"))
+        cpu |= CPU_SSE2;
+    if (__builtin_cpu_supports("avx2"))
+        cpu |= CPU_AVX2;
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("gfni") )
+        cpu |= CPU_AVX512;
+    return cpu;
+}
+
+/* RFC 3713 規定のデータランダム化処理(AES-NI, AVX で16ブロック並行)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数(16の倍数)
+ * inv: 0=順変換, 0以外=逆変換
+ */
+void camelliaDatarandAesni(const uint8_t *m, const CamelliaData *data,
+                           uint8_t *c, size_t n, int inv ) {
+    datarandAesni(m, data, c, n, inv);
+}
+
+/* RFC 3713 規定のデータランダム化処理(AVX2, VAES で32ブロック並行)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数(32の倍数)
+ * inv: 0=順変換, 0以外=逆変換
+ */
+void camelliaDatarandVaes(const uint8_t *m, const CamelliaData *data,
+                          uint8_t *c, size_t n, int inv ) {
+    datarandVaes(m, data, c, n, inv);
+}
+
+/* RFC 3713 規定のデータランダム化処理(AVX-512, GFNI で64ブロック並行)
+ * m[16*n]: RFC 3713 規定の変数M の並び
+ * data: 変換テーブル(キー種別は確認済みであること)
+ * c[16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * n: ブロック数(64の倍数)
+ * inv: 0=順変換, 0以外=逆変換
+ */
+void camelliaDatarandAvx512(const uint8_t *m, const CamelliaData *data,
+                            uint8_t *c, size_t n, int inv ) {
+    datarandAvx512(m, data, c, n, inv);
+}
+
+/* 独立したブロック列のデータランダム化処理(AES-NI, AVX で16列並行, 列ごとに異なる変換テーブル)
+ * m[16][16*n]: RFC 3713 規定の変数M の並び
+ * data[16]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[16][16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[16][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+void camelliaDatarandMultiAesni(const uint8_t *const *m,
+                                const CamelliaData *const *data,
+                                uint8_t *const *c, uint8_t *const *iv,
+                                size_t n, int groups ) {
+    datarandMultiAesni(m, data, c, iv, n, groups);
+}
+
+/* 独立したブロック列のデータランダム化処理(AVX2, VAES で32列並行, 列ごとに異なる変換テーブル)
+ * m[32][16*n]: RFC 3713 規定の変数M の並び
+ * data[32]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[32][16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[32][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+void camelliaDatarandMultiVaes(const uint8_t *const *m,
+                               const CamelliaData *const *data,
+                               uint8_t *const *c, uint8_t *const *iv,
+                               size_t n, int groups ) {
+    datarandMultiVaes(m, data, c, iv, n, groups);
+}
+
+/* 独立したブロック列のデータランダム化処理(AVX-512, GFNI で64列並行, 列ごとに異なる変換テーブル)
+ * m[64][16*n]: RFC 3713 規定の変数M の並び
+ * data[64]: 変換テーブル(キー種別は確認済み, 全て groups が同じであること)
+ * c[64][16*n]: RFC 3713 規定の変数C の並び (m と同一領域も可)
+ * iv[64][16]: CBC モードの初期化ベクタ(処理後は最後の C に更新, NULL=列のブロックを独立に処理する)
+ * n: 列ごとのブロック数
+ * groups: 6ラウンド単位のグループ数
+ */
+void camelliaDatarandMultiAvx512(const uint8_t *const *m,
+                                 const CamelliaData *const *data,
+                                 uint8_t *const *c, uint8_t *const *iv,
+                                 size_t n, int groups ) {
+    datarandMultiAvx512(m, data, c, iv, n, groups);
+}
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(AES-NI, AVX で16キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数(16の倍数)
+ */
+void camelliaKeygenAesni(const uint8_t *kl, const uint8_t *kr,
+                         uint8_t *ka, uint8_t *kb, size_t n ) {
+    keygenAesni(kl, kr, ka, kb, n);
+}
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(AVX2, VAES で32キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数(32の倍数)
+ */
+void camelliaKeygenVaes(const uint8_t *kl, const uint8_t *kr,
+                        uint8_t *ka, uint8_t *kb, size_t n ) {
+    keygenVaes(kl, kr, ka, kb, n);
+}
+
+/* RFC 3713 規定のキースケジューリング処理の変数KA, KB の生成(AVX-512, GFNI で64キー並行)
+ * kl[16*n], kr[16*n]: RFC 3713 規定の変数KL, KR の並び
+ * ka[16*n]: RFC 3713 規定の変数KA の並び
+ * kb[16*n]: RFC 3713 規定の変数KB の並び (NULL=生成しない(128bit キー))
+ * n: キー数(64の倍数)
+ */
+void camelliaKeygenAvx512(const uint8_t *kl, const uint8_t *kr,
+                          uint8_t *ka, uint8_t *kb, size_t n ) {
+    keygenAvx512(kl, kr, ka, kb, n);
+}
+#endif  /* #if KERNEL_X86 */
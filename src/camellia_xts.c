@@ -0,0 +1,297 @@
+/* camellia_xts.c - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - XTS mode (IEEE 1619).
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "camellia.h"
+#include "camellia_kernel.h"
+#include "camellia_xts.h"
+
+/* リトルエンディアンの8バイトデータを変換 */
+static uint64_t l8u64(const uint8_t *l64) {
+    uint64_t u64 = 0;
+    int n;
+
+    for (n = 8; n-- > 0; )
+        u64 = u64 << 8 | l64[n];
+    return u64;
+}
+
+/* リトルエンディアンの8バイトデータに変換 */
+static void u8l64_set(uint64_t u64, uint8_t *l64) {
+    int n;
+
+    for (n = 0; n < 8; ++n)
+        l64[n] = (uint8_t)(u64 >> n * 8);
+}
+
+/* 調整値を GF(2^128) 上で2倍(αを乗算)
+ * t[2]: 調整値 (下位, 上位64ビット)
+ */
+static void twice(uint64_t *t) {
+    uint64_t carry;
+
+    carry = t[1] >> 63;
+    t[1] = t[1] << 1 | t[0] >> 63;
+    t[0] = t[0] << 1 ^ (0x87 & -carry);
+}
+
+/* XTS モードのブロック処理(複数ブロック一括)
+ * data: 変換テーブル(データ用キー)
+ * t[2]: 調整値 (下位, 上位64ビット, 処理後は続きの値に更新)
+ * in[16*n]: 入力ブロックの並び
+ * out[16*n]: 出力ブロックの並び (in と同一領域も可)
+ * n: ブロック数
+ * dec: 0=暗号化, 0以外=復号
+ */
+static void blocks(const CamelliaData *data, uint64_t *t,
+                   const uint8_t *in, uint8_t *out, size_t n, int dec ) {
+    uint8_t tw[16 * BATCH_BLOCKS];
+    size_t nb, i;
+
+    while (n > 0) {
+        nb = n < BATCH_BLOCKS ? n : BATCH_BLOCKS;
+        for (i = 0; i < nb; ++i) {
+            u8l64_set(t[0], tw + 16 * i + 0);
+            u8l64_set(t[1], tw + 16 * i + 8);
+            twice(t);
+        }
+        camelliaXor(out, in, tw, 16 * nb);
+        if (dec)
+            camelliaDecryptBulk(out, data, out, nb);
+        else
+            camelliaDatarandBulk(out, data, out, nb);
+        camelliaXor(out, out, tw, 16 * nb);
+        in += 16 * nb, out += 16 * nb, n -= nb;
+    }
+}
+
+/* XTS モードのキー種別の確認
+ * data1: 変換テーブル(データ用キー)
+ * data2: 変換テーブル(調整値用キー)
+ * dec: 0=暗号化, 0以外=復号
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した)
+ */
+static int check(const CamelliaData *data1, const CamelliaData *data2, int dec) {
+    int status = -1;
+
+    switch (data1->type) {
+    case Camellia128Encrypt:
+    case Camellia192Encrypt:
+    case Camellia256Encrypt:
+        break;
+    case Camellia128Decrypt:
+    case Camellia192Decrypt:
+    case Camellia256Decrypt:
+        if (!dec)  /* 復号キーでは暗号化しない */
+            goto error;
+        break;
+    default:
+        goto error;
+    }
+    switch (data2->type) {  /* 調整値は常に暗号化で求める */
+    case Camellia128Encrypt:
+    case Camellia192Encrypt:
+    case Camellia256Encrypt:
+        break;
+    default:
+        goto error;
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* XTS モードの1セクタ分のデータ処理
+ * data1: 変換テーブル(データ用キー)
+ * b[16]: 暗号化したセクタ番号(調整値の初期値)
+ * in[len]: 入力データ
+ * out[len]: 出力データ (in と同一領域も可)
+ * len: セクタのバイト数(16以上)
+ * dec: 0=暗号化, 0以外=復号
+ */
+static void transform(const CamelliaData *data1, const uint8_t *b,
+                      const uint8_t *in, uint8_t *out, size_t len, int dec ) {
+    uint64_t t[2], t1[2], t2[2];
+    uint8_t pp[16], cc[16];
+    size_t n, tail;
+
+    t[0] = l8u64(b + 0), t[1] = l8u64(b + 8);
+    n = len / 16, tail = len % 16;
+    if (tail > 0)
+        --n;
+    blocks(data1, t, in, out, n, dec);
+    if (tail > 0) {  /* 暗号文窃取 */
+        in += 16 * n, out += 16 * n;
+        memcpy(t1, t, sizeof(t1)), memcpy(t2, t, sizeof(t2)), twice(t2);
+        blocks(data1, dec ? t2 : t1, in, cc, 1, dec);
+        memcpy(pp, in + 16, tail);
+        memcpy(pp + tail, cc + tail, 16 - tail);
+        memcpy(out + 16, cc, tail);
+        blocks(data1, dec ? t1 : t2, pp, out, 1, dec);
+    }
+}
+
+/* XTS モードのセクタ処理
+ * data1: 変換テーブル(データ用キー)
+ * data2: 変換テーブル(調整値用キー, 暗号キー)
+ * sector: セクタ番号
+ * in[len]: 入力データ
+ * out[len]: 出力データ (in と同一領域も可)
+ * len: セクタのバイト数(16以上)
+ * dec: 0=暗号化, 0以外=復号
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, len が16未満)
+ */
+static int xts(const CamelliaData *data1, const CamelliaData *data2,
+               uint64_t sector, const uint8_t *in, uint8_t *out, size_t len,
+               int dec ) {
+    int status = -1;
+    uint8_t b[16];
+
+    if (len < 16)
+        goto error;
+    if (check(data1, data2, dec) < 0)
+        goto error;
+    u8l64_set(sector, b + 0);
+    u8l64_set(0, b + 8);
+    if (camelliaDatarand(b, data2, b) < 0)
+        goto error;
+    transform(data1, b, in, out, len, dec);
+    status = 0;
+error:
+    return status;
+}
+
+/* XTS モードの連続したセクタの処理
+ * 調整値は BATCH_BLOCKS セクタ分ずつ一括で暗号化する
+ * (処理時間がデータとキーに依存しないカーネルでも, セクタごとにカーネルを1回ずつ呼ばない)
+ * data1: 変換テーブル(データ用キー)
+ * data2: 変換テーブル(調整値用キー, 暗号キー)
+ * sector: 先頭のセクタ番号(以降のセクタは1ずつ増やす)
+ * size: セクタのバイト数(16以上)
+ * in[len]: 入力データ
+ * out[len]: 出力データ (in と同一領域も可)
+ * len: データのバイト数(最後のセクタは size より短くてもよいが16以上)
+ * dec: 0=暗号化, 0以外=復号
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, セクタが16バイト未満)
+ */
+static int sectors(const CamelliaData *data1, const CamelliaData *data2,
+                   uint64_t sector, size_t size,
+                   const uint8_t *in, uint8_t *out, size_t len, int dec ) {
+    int status = -1;
+    uint8_t tw[16 * BATCH_BLOCKS];
+    size_t ns, i, l;
+
+    if (size < 16 || (len % size > 0 && len % size < 16))
+        goto error;
+    if (check(data1, data2, dec) < 0)
+        goto error;
+    while (len > 0) {
+        ns = (len + size - 1) / size;
+        if (ns > BATCH_BLOCKS)
+            ns = BATCH_BLOCKS;
+        for (i = 0; i < ns; ++i) {
+            u8l64_set(sector + i, tw + 16 * i + 0);
+            u8l64_set(0, tw + 16 * i + 8);
+        }
+        if (camelliaDatarandBulk(tw, data2, tw, ns) < 0)
+            goto error;
+        for (i = 0; i < ns; ++i) {
+            l = len < size ? len : size;
+            transform(data1, tw + 16 * i, in, out, l, dec);
+            in += l, out += l, len -= l;
+        }
+        sector += ns;
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* XTS モードのセクタ暗号化
+ * セクタ長が16バイトの倍数でない場合は暗号文窃取(ciphertext stealing)で処理する
+ * data1: 変換テーブル(データ用キー, 暗号キー)
+ * data2: 変換テーブル(調整値用キー, 暗号キー)
+ * sector: セクタ番号(調整値, 128ビットのリトルエンディアン整数として扱う)
+ * in[len]: 平文
+ * out[len]: 暗号文 (in と同一領域も可)
+ * len: セクタのバイト数(16以上)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, len が16未満)
+ */
+int camelliaXtsEncrypt(const CamelliaData *data1,
+                       const CamelliaData *data2, uint64_t sector,
+                       const uint8_t *in, uint8_t *out, size_t len ) {
+    return xts(data1, data2, sector, in, out, len, 0);
+}
+
+/* XTS モードのセクタ復号
+ * セクタ長が16バイトの倍数でない場合は暗号文窃取(ciphertext stealing)で処理する
+ * data1: 変換テーブル(データ用キー, 暗号キーまたは復号キー, 暗号キーの場合は逆変換で復号する)
+ * data2: 変換テーブル(調整値用キー, 暗号キー)
+ * sector: セクタ番号(調整値, 128ビットのリトルエンディアン整数として扱う)
+ * in[len]: 暗号文
+ * out[len]: 平文 (in と同一領域も可)
+ * len: セクタのバイト数(16以上)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, len が16未満)
+ */
+int camelliaXtsDecrypt(const CamelliaData *data1,
+                       const CamelliaData *data2, uint64_t sector,
+                       const uint8_t *in, uint8_t *out, size_t len ) {
+    return xts(data1, data2, sector, in, out, len, 1);
+}
+
+/* XTS モードの連続したセクタの暗号化
+ * data1: 変換テーブル(データ用キー, 暗号キー)
+ * data2: 変換テーブル(調整値用キー, 暗号キー)
+ * sector: 先頭のセクタ番号(以降のセクタは1ずつ増やす)
+ * size: セクタのバイト数(16以上)
+ * in[len]: 平文
+ * out[len]: 暗号文 (in と同一領域も可)
+ * len: データのバイト数(最後のセクタは size より短くてもよいが16以上)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, セクタが16バイト未満)
+ */
+int camelliaXtsEncryptSectors(const CamelliaData *data1,
+                              const CamelliaData *data2, uint64_t sector, size_t size,
+                              const uint8_t *in, uint8_t *out, size_t len ) {
+    return sectors(data1, data2, sector, size, in, out, len, 0);
+}
+
+/* XTS モードの連続したセクタの復号
+ * data1: 変換テーブル(データ用キー, 暗号キーまたは復号キー, 暗号キーの場合は逆変換で復号する)
+ * data2: 変換テーブル(調整値用キー, 暗号キー)
+ * sector: 先頭のセクタ番号(以降のセクタは1ずつ増やす)
+ * size: セクタのバイト数(16以上)
+ * in[len]: 暗号文
+ * out[len]: 平文 (in と同一領域も可)
+ * len: データのバイト数(最後のセクタは size より短くてもよいが16以上)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, セクタが16バイト未満)
+ */
+int camelliaXtsDecryptSectors(const CamelliaData *data1,
+                              const CamelliaData *data2, uint64_t sector, size_t size,
+                              const uint8_t *in, uint8_t *out, size_t len ) {
+    return sectors(data1, data2, sector, size, in, out, len, 1);
+}
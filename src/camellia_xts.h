@@ -0,0 +1,100 @@
+/* camellia_xts.h - Last modified: 16-Oct-2026 (kobayasy)
+ * The Camellia Encryption Algorithm (RFC 3713) - XTS mode (IEEE 1619).
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _INCLUDE_camellia_xts_h
+#define _INCLUDE_camellia_xts_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camellia.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* #ifdef __cplusplus */
+
+/* XTS モードのセクタ暗号化
+ * セクタ長が16バイトの倍数でない場合は暗号文窃取(ciphertext stealing)で処理する
+ * data1: 変換テーブル(データ用キー, 暗号キー)
+ * data2: 変換テーブル(調整値用キー, 暗号キー)
+ * sector: セクタ番号(調整値, 128ビットのリトルエンディアン整数として扱う)
+ * in[len]: 平文
+ * out[len]: 暗号文 (in と同一領域も可)
+ * len: セクタのバイト数(16以上)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, len が16未満)
+ */
+extern int camelliaXtsEncrypt(const CamelliaData *data1,
+                              const CamelliaData *data2, uint64_t sector,
+                              const uint8_t *in, uint8_t *out, size_t len );
+
+/* XTS モードのセクタ復号
+ * セクタ長が16バイトの倍数でない場合は暗号文窃取(ciphertext stealing)で処理する
+ * data1: 変換テーブル(データ用キー, 暗号キーまたは復号キー, 暗号キーの場合は逆変換で復号する)
+ * data2: 変換テーブル(調整値用キー, 暗号キー)
+ * sector: セクタ番号(調整値, 128ビットのリトルエンディアン整数として扱う)
+ * in[len]: 暗号文
+ * out[len]: 平文 (in と同一領域も可)
+ * len: セクタのバイト数(16以上)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, len が16未満)
+ */
+extern int camelliaXtsDecrypt(const CamelliaData *data1,
+                              const CamelliaData *data2, uint64_t sector,
+                              const uint8_t *in, uint8_t *out, size_t len );
+
+/* XTS モードの連続したセクタの暗号化
+ * 各セクタの調整値をまとめて暗号化するので, camelliaXtsEncrypt() をセクタごとに呼ぶより速い
+ * data1: 変換テーブル(データ用キー, 暗号キー)
+ * data2: 変換テーブル(調整値用キー, 暗号キー)
+ * sector: 先頭のセクタ番号(以降のセクタは1ずつ増やす)
+ * size: セクタのバイト数(16以上)
+ * in[len]: 平文
+ * out[len]: 暗号文 (in と同一領域も可)
+ * len: データのバイト数(最後のセクタは size より短くてもよいが16以上)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, セクタが16バイト未満)
+ */
+extern int camelliaXtsEncryptSectors(const CamelliaData *data1,
+                                     const CamelliaData *data2, uint64_t sector, size_t size,
+                                     const uint8_t *in, uint8_t *out, size_t len );
+
+/* XTS モードの連続したセクタの復号
+ * 各セクタの調整値をまとめて暗号化するので, camelliaXtsDecrypt() をセクタごとに呼ぶより速い
+ * data1: 変換テーブル(データ用キー, 暗号キーまたは復号キー, 暗号キーの場合は逆変換で復号する)
+ * data2: 変換テーブル(調整値用キー, 暗号キー)
+ * sector: 先頭のセクタ番号(以降のセクタは1ずつ増やす)
+ * size: セクタのバイト数(16以上)
+ * in[len]: 暗号文
+ * out[len]: 平文 (in と同一領域も可)
+ * len: データのバイト数(最後のセクタは size より短くてもよいが16以上)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了(未サポートな type を指定した, セクタが16バイト未満)
+ */
+extern int camelliaXtsDecryptSectors(const CamelliaData *data1,
+                                     const CamelliaData *data2, uint64_t sector, size_t size,
+                                     const uint8_t *in, uint8_t *out, size_t len );
+
+#ifdef __cplusplus
+}
+#endif  /* #ifdef __cplusplus */
+
+#endif  /* #ifndef _INCLUDE_camellia_xts_h */
@@ -0,0 +1,698 @@
+/* cli.c - Last modified: 16-Oct-2026 (kobayasy)
+ *
+ * Copyright (c) 2026 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* ファイルの暗号化/復号
+ * 使い方: camellia [-d] -m モード -k キー [-i 初期化ベクタ] [-a 追加認証データ]
+ *                  [-n セクタ番号] [-s セクタサイズ] [-t スレッド数] [-o 出力ファイル] [入力ファイル]
+ *  -d: 復号 (省略時は暗号化)
+ *  -m: 暗号利用モード (ctr, cbc, gcm, xts)
+ *  -k: キー (16進数で16, 24, 32バイト, xts はデータ用キーと調整値用キーを連結した32, 48, 64バイト)
+ *  -i: 初期化ベクタ (16進数, ctr, cbc は16バイト, gcm は1 ～ 64バイトで12バイトを推奨)
+ *  -a: 追加認証データ (16進数, gcm のみ)
+ *  -n: 先頭のセクタ番号 (xts のみ, 省略時は0)
+ *  -s: セクタのバイト数 (xts のみ, 16以上, 省略時は512)
+ *  -t: 暗号化/復号するスレッド数 (ctr, xts のみ, 省略時はCPU数)
+ *  -o: 出力ファイル (省略時は標準出力)
+ * 入力ファイルを省略した場合または - の場合は標準入力から読み込む
+ * cbc は PKCS#7 パディングを付加/除去する
+ * gcm は暗号文の末尾に16バイトの認証タグを付加し, 復号時に検証する
+ *  (検証に失敗した場合は出力ファイルを削除して異常終了する,
+ *   出力が通常ファイルでない場合は検証が済むまで復号結果をメモリに保持し, 検証に失敗したら何も出力しない)
+ * 通常ファイルの入力はメモリマップし, それ以外はページ境界に置いた大きなバッファに読み込む
+ * 読み込み, 暗号化/復号, 書き出しは別スレッドで行い, バッファを順に受け渡して並行処理する
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <pthread.h>
+#include "camellia.h"
+#include "camellia_ctr.h"
+#include "camellia_gcm.h"
+#include "camellia_cbc.h"
+#include "camellia_xts.h"
+#include "camellia_mt.h"
+
+/* 1回に読み込むバイト数 */
+#define BUFSIZE (4 << 20)
+
+/* 読み込み, 暗号化/復号, 書き出しで受け渡すバッファ数 */
+#define SLOTS 3
+
+/* バッファのアライメント */
+#define ALIGN 4096
+
+/* 最適化で省かれない0クリア */
+static void *(*const volatile wipe)(void *s, int c, size_t n) = memset;
+
+/* 暗号利用モード */
+typedef enum {
+    ModeCtr=0,  /* CTR */
+    ModeCbc,    /* CBC (PKCS#7 パディング) */
+    ModeGcm,    /* GCM (認証タグ16バイト) */
+    ModeXts     /* XTS */
+} Mode;
+
+/* 受け渡すバッファ */
+typedef enum {  /* バッファの状態 */
+    SlotFree=0,  /* 空き(読み込み待ち) */
+    SlotRead,    /* 読み込み済み(暗号化/復号待ち) */
+    SlotDone     /* 暗号化/復号済み(書き出し待ち) */
+} SlotState;
+typedef struct {  /* バッファ */
+    uint8_t *buf;        /* 入力バッファ (メモリマップの場合は未使用) */
+    uint8_t *out;        /* 出力バッファ */
+    const uint8_t *in;   /* 入力データ */
+    size_t len;          /* 入力データのバイト数 */
+    size_t olen;         /* 出力データのバイト数 */
+    int last;            /* 0以外=最後のデータ */
+    SlotState state;     /* 状態 */
+} Slot;
+
+/* 処理状態 */
+typedef struct {  /* 処理状態 */
+    Mode mode;                 /* 暗号利用モード */
+    int dec;                   /* 0=暗号化, 0以外=復号 */
+    CamelliaData data;         /* 変換テーブル(暗号キー) */
+    CamelliaData data2;        /* 変換テーブル(XTS モードの調整値用キー) */
+    uint8_t iv[16];            /* CBC モードの初期化ベクタ */
+    CamelliaCtr ctr;           /* CTR モード 状態 */
+    CamelliaGcm gcm;           /* GCM モード 状態 */
+    CamelliaMt *mt;            /* 並列処理エンジン (CTR, XTS モード) */
+    uint64_t sector;           /* XTS モードの次のセクタ番号 */
+    size_t size;               /* XTS モードのセクタのバイト数 */
+    uint8_t hold[16];          /* 復号時に保留している入力の末尾 */
+    size_t nhold;              /* hold のバイト数 */
+    int ifd, ofd;              /* 入力, 出力ファイル */
+    int oreg;                  /* 0以外=出力は -o で指定した通常ファイル */
+    int defer;                 /* 0以外=最後のバッファまで出力を保留 (GCM モードの復号で出力が通常ファイルでない場合) */
+    uint8_t *pend;             /* 保留している出力 */
+    size_t npend, pendsize;    /* pend のバイト数, 確保済みバイト数 */
+    const char *iname, *oname; /* 入力, 出力ファイル名(エラー表示用) */
+    const uint8_t *map;        /* メモリマップした入力ファイル (NULL=読み込み) */
+    size_t mapsize;            /* map のバイト数 */
+    size_t offset;             /* map の次に処理する位置 */
+    size_t bufsize;            /* 1回に読み込むバイト数 */
+    Slot slot[SLOTS];          /* 受け渡すバッファ */
+    pthread_mutex_t mutex;     /* slot[].state, abort の排他 */
+    pthread_cond_t cond;       /* slot[].state, abort の変化の通知 */
+    int abort;                 /* 0以外=処理の中断 */
+} Tool;
+
+/* 16進数文字列をバイト列に変換
+ * s: 16進数文字列
+ * buf[size]: 変換したバイト列
+ * size: buf のバイト数
+ * 戻り値: 0以上=変換したバイト数, 0未満=異常終了(16進数でない, または size を超えた)
+ */
+static int hex(const char *s, uint8_t *buf, size_t size) {
+    int status = -1;
+    size_t n;
+    unsigned x;
+
+    for (n = 0; s[0] != '\0'; ++n, s += 2) {
+        if (n >= size || strspn(s, "0123456789abcdefABCDEF") < 2)
+            goto error;
+        sscanf(s, "%2x", &x);
+        buf[n] = x;
+    }
+    status = n;
+error:
+    return status;
+}
+
+/* バッファの状態の変化を待つ
+ * 戻り値: 0以上=正常終了, 0未満=処理の中断
+ */
+static int waitSlot(Tool *t, Slot *s, SlotState state) {
+    int status;
+
+    pthread_mutex_lock(&t->mutex);
+    while (s->state != state && !t->abort)
+        pthread_cond_wait(&t->cond, &t->mutex);
+    status = t->abort ? -1 : 0;
+    pthread_mutex_unlock(&t->mutex);
+    return status;
+}
+
+/* バッファの状態を変更 */
+static void postSlot(Tool *t, Slot *s, SlotState state) {
+    pthread_mutex_lock(&t->mutex);
+    s->state = state;
+    pthread_cond_broadcast(&t->cond);
+    pthread_mutex_unlock(&t->mutex);
+}
+
+/* 処理の中断 */
+static void fail(Tool *t) {
+    pthread_mutex_lock(&t->mutex);
+    t->abort = 1;
+    pthread_cond_broadcast(&t->cond);
+    pthread_mutex_unlock(&t->mutex);
+}
+
+/* 読み込みスレッド */
+static void *reader(void *arg) {
+    Tool *t = arg;
+    Slot *s;
+    size_t n;
+    ssize_t r;
+    uintptr_t page;
+    int last = 0;
+
+    for (n = 0; !last; ++n) {
+        s = &t->slot[n % SLOTS];
+        if (waitSlot(t, s, SlotFree) < 0)
+            break;
+        if (t->map != NULL) {  /* メモリマップ */
+            s->in = t->map + t->offset;
+            s->len = t->mapsize - t->offset < t->bufsize ? t->mapsize - t->offset : t->bufsize;
+            t->offset += s->len;
+            last = t->offset >= t->mapsize;
+            if (!last) {  /* 次の範囲を先読み */
+                page = (uintptr_t)(t->map + t->offset) & ~(uintptr_t)(ALIGN - 1);
+                madvise((void *)page, t->map + t->offset - (uint8_t *)page +
+                        (t->mapsize - t->offset < t->bufsize ? t->mapsize - t->offset : t->bufsize),
+                        MADV_WILLNEED );
+            }
+        }
+        else {  /* 読み込み(バッファが一杯になるかファイル終端まで) */
+            for (s->len = 0; s->len < t->bufsize; s->len += r) {
+                r = read(t->ifd, s->buf + s->len, t->bufsize - s->len);
+                if (r < 0) {
+                    if (errno == EINTR) {
+                        r = 0;
+                        continue;
+                    }
+                    fprintf(stderr, "camellia: %s: %s\n", t->iname, strerror(errno));
+                    fail(t);
+                    goto error;
+                }
+                if (r == 0)
+                    break;
+            }
+            s->in = s->buf;
+            last = s->len < t->bufsize;
+        }
+        s->last = last;
+        postSlot(t, s, SlotRead);
+    }
+error:
+    return NULL;
+}
+
+/* 出力ファイルに書き出し
+ * 戻り値: 0以上=正常終了, 0未満=異常終了
+ */
+static int output(Tool *t, const uint8_t *buf, size_t len) {
+    int status = -1;
+    size_t n;
+    ssize_t r;
+
+    for (n = 0; n < len; n += r) {
+        r = write(t->ofd, buf + n, len - n);
+        if (r < 0) {
+            if (errno == EINTR) {
+                r = 0;
+                continue;
+            }
+            fprintf(stderr, "camellia: %s: %s\n", t->oname, strerror(errno));
+            goto error;
+        }
+    }
+    status = 0;
+error:
+    return status;
+}
+
+/* 出力を保留
+ * 戻り値: 0以上=正常終了, 0未満=異常終了
+ */
+static int pend(Tool *t, const uint8_t *buf, size_t len) {
+    int status = -1;
+    uint8_t *p;
+    size_t size;
+
+    if (t->npend + len > t->pendsize) {
+        for (size = t->pendsize > 0 ? t->pendsize : BUFSIZE; size < t->npend + len; size *= 2)
+            ;
+        p = realloc(t->pend, size);
+        if (p == NULL) {
+            fprintf(stderr, "camellia: %s\n", strerror(ENOMEM));
+            goto error;
+        }
+        t->pend = p, t->pendsize = size;
+    }
+    memcpy(t->pend + t->npend, buf, len), t->npend += len;
+    status = 0;
+error:
+    return status;
+}
+
+/* 書き出しスレッド */
+static void *writer(void *arg) {
+    Tool *t = arg;
+    Slot *s;
+    size_t n;
+    int last = 0;
+
+    for (n = 0; !last; ++n) {
+        s = &t->slot[n % SLOTS];
+        if (waitSlot(t, s, SlotDone) < 0)
+            break;
+        if (t->defer && !s->last) {
+            if (pend(t, s->out, s->olen) < 0)
+                goto error;
+        }
+        else {
+            if (output(t, t->pend, t->npend) < 0 || output(t, s->out, s->olen) < 0)
+                goto error;
+            t->npend = 0;
+        }
+        last = s->last;
+        postSlot(t, s, SlotFree);
+    }
+    return NULL;
+error:
+    fail(t);
+    return NULL;
+}
+
+/* CBC モードの復号(保留しない部分) */
+static int cbcDecrypt(Tool *t, const uint8_t *in, uint8_t *out, size_t len) {
+    if (len % 16)
+        return -1;
+    return camelliaCbcDecrypt(&t->data, t->iv, in, out, len / 16);
+}
+
+/* GCM モードの復号(保留しない部分) */
+static int gcmDecrypt(Tool *t, const uint8_t *in, uint8_t *out, size_t len) {
+    return camelliaGcmDecrypt(&t->gcm, in, out, len);
+}
+
+/* 入力の末尾16バイトを保留しながら復号
+ * (CBC モードはパディング, GCM モードは認証タグの分を最後まで保留する)
+ * t: 処理状態
+ * in[len]: 入力データ
+ * out[len+16]: 出力データ
+ * len: 入力データのバイト数
+ * run: 保留しない部分を復号する関数
+ * 戻り値: 0以上=出力したバイト数, 0未満=異常終了
+ */
+static ssize_t holdback(Tool *t, const uint8_t *in, uint8_t *out, size_t len,
+                        int (*run)(Tool *t, const uint8_t *in, uint8_t *out, size_t len) ) {
+    ssize_t status = -1;
+    size_t n, n1, n2;
+
+    n = t->nhold + len > 16 ? t->nhold + len - 16 : 0;
+    n1 = n < t->nhold ? n : t->nhold;  /* 保留していた部分から復号するバイト数 */
+    n2 = n - n1;                       /* in から復号するバイト数 */
+    if (n1 > 0 && run(t, t->hold, out, n1) < 0)
+        goto error;
+    if (n2 > 0 && run(t, in, out + n1, n2) < 0)
+        goto error;
+    memmove(t->hold, t->hold + n1, t->nhold - n1);
+    memcpy(t->hold + t->nhold - n1, in + n2, len - n2);
+    t->nhold += len - n;
+    status = n;
+error:
+    return status;
+}
+
+/* バッファの暗号化/復号
+ * t: 処理状態
+ * s: バッファ
+ * 戻り値: 0以上=正常終了, 0未満=異常終了
+ */
+static int process(Tool *t, Slot *s) {
+    int status = -1;
+    uint8_t block[16];
+    ssize_t olen;
+    size_t n;
+
+    switch (t->mode) {
+    case ModeCtr:
+        if (camelliaMtCtr(t->mt, &t->ctr, s->in, s->out, s->len) < 0)
+            goto error;
+        s->olen = s->len;
+        break;
+    case ModeCbc:
+        if (!t->dec) {
+            n = s->len / 16;
+            if (camelliaCbcEncrypt(&t->data, t->iv, s->in, s->out, n) < 0)
+                goto error;
+            s->olen = n * 16;
+            if (s->last) {  /* PKCS#7 パディング */
+                memcpy(block, s->in + n * 16, s->len - n * 16);
+                memset(block + s->len - n * 16, 16 - (s->len - n * 16), 16 - (s->len - n * 16));
+                if (camelliaCbcEncrypt(&t->data, t->iv, block, s->out + s->olen, 1) < 0)
+                    goto error;
+                s->olen += 16;
+            }
+        }
+        else {
+            if ((olen = holdback(t, s->in, s->out, s->len, cbcDecrypt)) < 0) {
+                fprintf(stderr, "camellia: %s: input is not a multiple of 16 bytes\n", t->iname);
+                goto error;
+            }
+            s->olen = olen;
+            if (s->last) {  /* PKCS#7 パディングの除去 */
+                if (t->nhold != 16) {
+                    fprintf(stderr, "camellia: %s: input is not a multiple of 16 bytes\n", t->iname);
+                    goto error;
+                }
+                if (camelliaCbcDecrypt(&t->data, t->iv, t->hold, block, 1) < 0 ||
+                    block[15] < 1 || block[15] > 16 )
+                    goto bad;
+                for (n = 16 - block[15]; n < 16; ++n)
+                    if (block[n] != block[15])
+                        goto bad;
+                memcpy(s->out + s->olen, block, 16 - block[15]);
+                s->olen += 16 - block[15];
+            }
+        }
+        break;
+    case ModeGcm:
+        if (!t->dec) {
+            if (camelliaGcmEncrypt(&t->gcm, s->in, s->out, s->len) < 0)
+                goto error;
+            s->olen = s->len;
+            if (s->last) {  /* 認証タグの付加 */
+                if (camelliaGcmFinal(&t->gcm, s->out + s->olen, 16) < 0)
+                    goto error;
+                s->olen += 16;
+            }
+        }
+        else {
+            if ((olen = holdback(t, s->in, s->out, s->len, gcmDecrypt)) < 0)
+                goto error;
+            s->olen = olen;
+            if (s->last) {  /* 認証タグの検証 */
+                if (t->nhold != 16 || camelliaGcmVerify(&t->gcm, t->hold, 16) < 0) {
+                    fprintf(stderr, "camellia: %s: authentication failed\n", t->iname);
+                    goto error;
+                }
+            }
+        }
+        break;
+    case ModeXts:
+        if (s->len > 0 &&
+            (t->dec ? camelliaMtXtsDecrypt : camelliaMtXtsEncrypt)(
+                t->mt, &t->data, &t->data2, t->sector, t->size, s->in, s->out, s->len ) < 0 ) {
+            if (s->len % t->size > 0 && s->len % t->size < 16)
+                fprintf(stderr, "camellia: %s: last sector is shorter than 16 bytes\n", t->iname);
+            else
+                fprintf(stderr, "camellia: %s: %s failed\n", t->iname, t->dec ? "decryption" : "encryption");
+            goto error;
+        }
+        t->sector += s->len / t->size;
+        s->olen = s->len;
+        break;
+    }
+    status = 0;
+error:
+    return status;
+bad:
+    fprintf(stderr, "camellia: %s: bad padding\n", t->iname);
+    goto error;
+}
+
+/* 入力ファイルの全体を暗号化/復号して出力
+ * t: 処理状態(モード, キー, 入出力ファイルは設定済みであること)
+ * 戻り値: 0以上=正常終了, 0未満=異常終了
+ */
+static int run(Tool *t) {
+    int status = -1;
+    pthread_t rthread, wthread;
+    int rstarted = 0, wstarted = 0;
+    struct stat st;
+    void *map = MAP_FAILED;
+    Slot *s;
+    size_t n;
+    int last = 0;
+
+    pthread_mutex_init(&t->mutex, NULL);
+    pthread_cond_init(&t->cond, NULL);
+    t->bufsize = t->mode == ModeXts ? (BUFSIZE / t->size > 0 ? BUFSIZE / t->size : 1) * t->size : BUFSIZE;
+    if (fstat(t->ifd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+        (uintmax_t)st.st_size <= SIZE_MAX ) {  /* 通常ファイルはメモリマップする */
+        map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, t->ifd, 0);
+        if (map != MAP_FAILED) {
+            madvise(map, st.st_size, MADV_SEQUENTIAL);
+            t->map = map, t->mapsize = st.st_size;
+        }
+    }
+    for (n = 0; n < SLOTS; ++n) {
+        if (t->map == NULL && posix_memalign((void **)&t->slot[n].buf, ALIGN, t->bufsize))
+            goto nomem;
+        if (posix_memalign((void **)&t->slot[n].out, ALIGN, t->bufsize + 32))
+            goto nomem;
+    }
+    if (pthread_create(&rthread, NULL, reader, t))
+        goto nomem;
+    rstarted = 1;
+    if (pthread_create(&wthread, NULL, writer, t))
+        goto nomem;
+    wstarted = 1;
+    for (n = 0; !last; ++n) {
+        s = &t->slot[n % SLOTS];
+        if (waitSlot(t, s, SlotRead) < 0)
+            goto error;
+        if (process(t, s) < 0)
+            goto error;
+        last = s->last;
+        postSlot(t, s, SlotDone);
+    }
+    pthread_join(wthread, NULL), wstarted = 0;
+    if (t->abort)
+        goto error;
+    status = 0;
+error:
+    if (status < 0)
+        fail(t);
+    if (wstarted)
+        pthread_join(wthread, NULL);
+    if (rstarted)
+        pthread_join(rthread, NULL);
+    for (n = 0; n < SLOTS; ++n) {
+        free(t->slot[n].buf), t->slot[n].buf = NULL;
+        free(t->slot[n].out), t->slot[n].out = NULL;
+    }
+    if (map != MAP_FAILED)
+        munmap(map, st.st_size);
+    pthread_cond_destroy(&t->cond);
+    pthread_mutex_destroy(&t->mutex);
+    return status;
+nomem:
+    fprintf(stderr, "camellia: %s\n", strerror(ENOMEM));
+    goto error;
+}
+
+int main(int argc, char *argv[]) {
+    const char *modes[] = {"ctr", "cbc", "gcm", "xts"};
+    Tool *t = NULL;
+    const char *mode = NULL, *key = NULL, *iv = NULL, *aad = NULL;
+    int nthreads = 0;
+    uint8_t k[64], v[64];
+    uint8_t *a = NULL;
+    int klen, vlen, alen = 0;
+    CamelliaKeytype type;
+    struct stat st;
+    int opt;
+    int status = -1;
+
+    if (posix_memalign((void **)&t, _Alignof(Tool), sizeof(*t)))  /* CamelliaData のアライメントを保つ */
+        goto error;
+    memset(t, 0, sizeof(*t));
+    t->ifd = STDIN_FILENO, t->ofd = STDOUT_FILENO;
+    t->iname = "(stdin)", t->oname = "(stdout)";
+    t->size = 512;
+    while ((opt = getopt(argc, argv, "dm:k:i:a:n:s:t:o:")) != -1)
+        switch (opt) {
+        case 'd':
+            t->dec = 1;
+            break;
+        case 'm':
+            mode = optarg;
+            break;
+        case 'k':
+            key = optarg;
+            break;
+        case 'i':
+            iv = optarg;
+            break;
+        case 'a':
+            aad = optarg;
+            break;
+        case 'n':
+            t->sector = strtoull(optarg, NULL, 0);
+            break;
+        case 's':
+            t->size = strtoul(optarg, NULL, 0);
+            break;
+        case 't':
+            nthreads = atoi(optarg);
+            break;
+        case 'o':
+            t->oname = optarg;
+            break;
+        default:
+            goto usage;
+        }
+    if (mode == NULL || key == NULL || argc - optind > 1)
+        goto usage;
+    for (t->mode = ModeCtr; t->mode <= ModeXts; ++t->mode)
+        if (!strcmp(mode, modes[t->mode]))
+            break;
+    if (t->mode > ModeXts)
+        goto usage;
+
+    /* キー */
+    klen = hex(key, k, sizeof(k));
+    if (t->mode == ModeXts)  /* データ用キーと調整値用キー */
+        klen = klen % 2 ? -1 : klen / 2;
+    switch (klen) {
+    case 16:
+        type = Camellia128Encrypt;
+        break;
+    case 24:
+        type = Camellia192Encrypt;
+        break;
+    case 32:
+        type = Camellia256Encrypt;
+        break;
+    default:
+        fprintf(stderr, "camellia: bad key length\n");
+        goto error;
+    }
+    if (camelliaKeysche(type, k, &t->data) < 0)
+        goto error;
+    if (t->mode == ModeXts && camelliaKeysche(type, k + klen, &t->data2) < 0)
+        goto error;
+    wipe(k, 0, sizeof(k));
+
+    /* 初期化ベクタ, 追加認証データ */
+    vlen = iv != NULL ? hex(iv, v, sizeof(v)) : 0;
+    if (t->mode == ModeCtr || t->mode == ModeCbc ? vlen != 16 :
+        t->mode == ModeGcm ? vlen < 1 : iv != NULL ) {
+        fprintf(stderr, "camellia: bad iv length\n");
+        goto error;
+    }
+    if (aad != NULL) {
+        a = malloc(strlen(aad) / 2 + 1);
+        if (a == NULL)
+            goto error;
+        if (t->mode != ModeGcm || (alen = hex(aad, a, strlen(aad) / 2)) < 0) {
+            fprintf(stderr, "camellia: bad aad\n");
+            goto error;
+        }
+    }
+    if (t->mode == ModeXts && t->size < 16) {
+        fprintf(stderr, "camellia: bad sector size\n");
+        goto error;
+    }
+    switch (t->mode) {
+    case ModeCtr:
+        if (camelliaCtrInit(&t->ctr, &t->data, v) < 0)
+            goto error;
+        break;
+    case ModeCbc:
+        memcpy(t->iv, v, sizeof(t->iv));
+        break;
+    case ModeGcm:
+        if (camelliaGcmInit(&t->gcm, &t->data, v, vlen) < 0)
+            goto error;
+        if (camelliaGcmAad(&t->gcm, a, alen) < 0)
+            goto error;
+        break;
+    case ModeXts:
+        break;
+    }
+    if (t->mode == ModeCtr || t->mode == ModeXts) {
+        t->mt = camelliaMtCreate(nthreads, 0);
+        if (t->mt == NULL)
+            goto error;
+    }
+
+    /* 入出力ファイル */
+    if (optind < argc && strcmp(argv[optind], "-")) {
+        t->iname = argv[optind];
+        t->ifd = open(t->iname, O_RDONLY);
+        if (t->ifd < 0) {
+            fprintf(stderr, "camellia: %s: %s\n", t->iname, strerror(errno));
+            goto error;
+        }
+    }
+    if (strcmp(t->oname, "(stdout)")) {
+        t->ofd = open(t->oname, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if (t->ofd < 0) {
+            fprintf(stderr, "camellia: %s: %s\n", t->oname, strerror(errno));
+            goto error;
+        }
+        t->oreg = fstat(t->ofd, &st) == 0 && S_ISREG(st.st_mode);
+    }
+    t->defer = t->mode == ModeGcm && t->dec && !t->oreg;  /* 認証前の平文を削除できない出力に渡さない */
+
+    if (run(t) < 0) {
+        if (t->oreg)  /* 不完全な出力を残さない */
+            unlink(t->oname);
+        goto error;
+    }
+    if (t->ofd != STDOUT_FILENO && close(t->ofd) < 0) {
+        fprintf(stderr, "camellia: %s: %s\n", t->oname, strerror(errno));
+        t->ofd = STDOUT_FILENO;
+        goto error;
+    }
+    t->ofd = STDOUT_FILENO;
+    status = 0;
+error:
+    if (t != NULL) {
+        if (t->ifd != STDIN_FILENO && t->ifd >= 0)
+            close(t->ifd);
+        if (t->ofd != STDOUT_FILENO && t->ofd >= 0)
+            close(t->ofd);
+        camelliaMtDestroy(t->mt);
+        if (t->pend != NULL)
+            wipe(t->pend, 0, t->pendsize);
+        free(t->pend);
+        wipe(t, 0, sizeof(*t));
+        free(t);
+    }
+    wipe(k, 0, sizeof(k));
+    free(a);
+    return status < 0 ? 1 : 0;
+usage:
+    fprintf(stderr, "usage: %s [-d] -m ctr|cbc|gcm|xts -k key [-i iv] [-a aad] [-n sector] [-s size] [-t threads] [-o output] [input]\n", argv[0]);
+    fprintf(stderr, "  gcm -d holds the plaintext in memory until the tag is verified unless output is a regular file given by -o\n");
+    goto error;
+}
@@ -1,4 +1,4 @@
-/* example.c - Last modified: 31-Jul-2021 (kobayasy)
+/* example.c - Last modified: 16-Oct-2026 (kobayasy)
  *
  * Copyright (c) 2021 by Yuichi Kobayashi <kobayasy@kobayasy.com>
  *
@@ -26,7 +26,40 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
 #include "camellia.h"
+#include "camellia_ctr.h"
+#include "camellia_gcm.h"
+#include "camellia_cbc.h"
+#include "camellia_xts.h"
+#include "camellia_mt.h"
+#include "camellia_uring.h"
+#include "camellia_cache.h"
+#include "camellia_cmac.h"
+#include "camellia_ccm.h"
+#include "camellia_stats.h"
+#include "camellia_kernel.h"
+
+/* 動作確認用の擬似乱数 (xorshift64)
+ * x: 状態 (0以外)
+ * 戻り値: 擬似乱数
+ */
+static uint64_t rnd(uint64_t *x) {
+    *x ^= *x << 13, *x ^= *x >> 7, *x ^= *x << 17;
+    return *x;
+}
+
+/* 16バイト単位の排他的論理和
+ * in[len]: 入力 (len は16の倍数でなくてもよい)
+ * len: バイト数
+ * out[16]: in を16バイト単位で排他的論理和した値を加える
+ */
+static void fold(const uint8_t *in, size_t len, uint8_t *out) {
+    size_t n;
+
+    for (n = 0; n < len; ++n)
+        out[n % 16] ^= in[n];
+}
 
 int main(int argc, char *argv[]) {
     const uint8_t k128[16] = {  /* 128bitサイズキー */
@@ -60,8 +93,226 @@ int main(int argc, char *argv[]) {
         0x9a, 0xcc, 0x23, 0x7d, 0xff, 0x16, 0xd7, 0x6c,
         0x20, 0xef, 0x7c, 0x91, 0x9e, 0x3a, 0x75, 0x09
     };
+    const uint8_t ivctr[16] = {  /* CTR モード動作確認用カウンタ初期値 */
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe
+    };
+    const uint8_t cctr[100] = {  /* CTR モード動作確認用暗号文期待値(平文は n*7+3) */
+        0xe5, 0xd0, 0x50, 0x4e, 0xaf, 0xaa, 0x36, 0x26,
+        0xc2, 0x35, 0xd5, 0xab, 0xee, 0x74, 0x46, 0x46,
+        0x37, 0x36, 0x4d, 0x08, 0x07, 0x38, 0x10, 0xf3,
+        0xc7, 0xa1, 0xcc, 0x0e, 0x1b, 0xa6, 0x06, 0x19,
+        0xe9, 0xa8, 0xe0, 0x77, 0x0a, 0x47, 0xc4, 0x6c,
+        0xb3, 0x76, 0xee, 0x8f, 0x66, 0x1d, 0x00, 0x57,
+        0xea, 0x77, 0x38, 0x04, 0xa1, 0xd5, 0x79, 0x7d,
+        0xdd, 0xf3, 0x6f, 0xd3, 0x93, 0xff, 0x55, 0xb1,
+        0xb9, 0x47, 0xe5, 0x54, 0x40, 0x4b, 0x27, 0xdb,
+        0xfb, 0x91, 0x7d, 0xbc, 0x68, 0xb4, 0x74, 0x37,
+        0xaf, 0xf9, 0xf5, 0x90, 0x80, 0xa5, 0x43, 0xcb,
+        0xfc, 0x5d, 0x84, 0x8f, 0xde, 0x6e, 0x65, 0x3f,
+        0x68, 0xe5, 0x92, 0x5b
+    };
+    const uint8_t ivgcm[12] = {  /* GCM モード動作確認用初期化ベクタ */
+        0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+        0xde, 0xca, 0xf8, 0x88
+    };
+    const uint8_t aadgcm[20] = {  /* GCM モード動作確認用追加認証データ */
+        0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+        0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+        0xab, 0xad, 0xda, 0xd2
+    };
+    const uint8_t cgcm[100] = {  /* GCM モード動作確認用暗号文期待値(平文は n*7+3) */
+        0x0e, 0x0e, 0xfb, 0x8a, 0xeb, 0xcb, 0x36, 0x6c,
+        0x02, 0x96, 0xab, 0x08, 0x12, 0xd1, 0x9e, 0x89,
+        0x1d, 0xc1, 0x07, 0xa0, 0x9b, 0x18, 0xaa, 0x29,
+        0xa5, 0xf5, 0xb8, 0x64, 0x81, 0xba, 0x5c, 0x6f,
+        0x6b, 0x31, 0x40, 0x29, 0xcf, 0x94, 0x5c, 0x0b,
+        0x3c, 0x5e, 0xee, 0xa7, 0x89, 0xa7, 0xf7, 0x1a,
+        0xe1, 0x6b, 0xaa, 0xf0, 0x8b, 0xc3, 0xfd, 0x21,
+        0xe3, 0x6f, 0x9c, 0x8c, 0x65, 0x7a, 0x18, 0x99,
+        0x8a, 0xb3, 0x46, 0xe6, 0x10, 0x04, 0xa0, 0xb4,
+        0x6f, 0x8b, 0x94, 0xcf, 0x3b, 0xee, 0x4d, 0x99,
+        0x03, 0x0c, 0xa0, 0x19, 0xb3, 0xf0, 0xae, 0xd1,
+        0x39, 0xb7, 0x9c, 0x51, 0x64, 0x3e, 0xe8, 0xeb,
+        0xe7, 0xbf, 0x6b, 0x6a
+    };
+    const uint8_t tgcm[16] = {  /* GCM モード動作確認用認証タグ期待値 */
+        0x4b, 0xac, 0xac, 0x29, 0xfd, 0x0d, 0x5d, 0xc9,
+        0xee, 0xde, 0x18, 0x01, 0xa9, 0xaf, 0x32, 0x98
+    };
+    const uint8_t cccm[100] = {  /* CCM モード動作確認用暗号文期待値(平文は n*7+3, ナンスと AAD は GCM モードと同じ) */
+        0xa5, 0xb3, 0x92, 0xe2, 0x35, 0xcb, 0x4a, 0x18,
+        0x27, 0x2d, 0x5e, 0xc8, 0x1b, 0x62, 0x6e, 0x66,
+        0x4c, 0xa5, 0x4f, 0x95, 0xd0, 0x0c, 0xfc, 0x82,
+        0x4c, 0x3a, 0xe2, 0xd7, 0xfe, 0x39, 0x9e, 0x06,
+        0x1e, 0xe9, 0x7e, 0x61, 0x78, 0xfb, 0x58, 0x28,
+        0xec, 0x1c, 0x42, 0x60, 0xed, 0x1a, 0xcc, 0x63,
+        0xef, 0x46, 0x65, 0x88, 0x1f, 0x25, 0x32, 0x59,
+        0x3f, 0x89, 0x63, 0x1f, 0x23, 0x91, 0x96, 0xa4,
+        0x82, 0x80, 0x58, 0x38, 0xc6, 0x33, 0x31, 0xbc,
+        0xfd, 0x03, 0x87, 0x78, 0xab, 0x20, 0x24, 0x11,
+        0x63, 0x49, 0x3f, 0x7f, 0x6e, 0xbd, 0x3e, 0x64,
+        0xbb, 0xb7, 0x56, 0x80, 0xcd, 0xf2, 0xbf, 0x99,
+        0xeb, 0xd9, 0x6a, 0x4f
+    };
+    const uint8_t tccm[16] = {  /* CCM モード動作確認用認証タグ期待値 */
+        0xdb, 0xd3, 0xfd, 0x79, 0x2b, 0xe9, 0x14, 0xa3,
+        0x51, 0x08, 0xab, 0xfc, 0xa6, 0x55, 0x2d, 0x3e
+    };
+    const uint8_t kccm[16] = {  /* RFC 5528 Packet Vector #1 キー */
+        0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+        0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf
+    };
+    const uint8_t nccm[13] = {  /* RFC 5528 Packet Vector #1 ナンス(平文は n の先頭31バイト, うち8バイトが AAD) */
+        0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xa0,
+        0xa1, 0xa2, 0xa3, 0xa4, 0xa5
+    };
+    const uint8_t rccm[31] = {  /* RFC 5528 Packet Vector #1 暗号文と認証タグ(8バイト)期待値 */
+        0xba, 0x73, 0x71, 0x85, 0xe7, 0x19, 0x31, 0x04,
+        0x92, 0xf3, 0x8a, 0x5f, 0x12, 0x51, 0xda, 0x55,
+        0xfa, 0xfb, 0xc9, 0x49, 0x84, 0x8a, 0x0d, 0xfc,
+        0xae, 0xce, 0x74, 0x6b, 0x3d, 0xb9, 0xad
+    };
+    const uint8_t tcmac[3][16] = {  /* CMAC 動作確認用認証タグ期待値(メッセージは n*7+3 の先頭100, 96, 0バイト) */
+        { 0x52, 0xed, 0x66, 0x25, 0x88, 0xba, 0xf0, 0xd4,
+          0x5a, 0xa6, 0xa8, 0x39, 0x4a, 0xfd, 0x84, 0x4d },
+        { 0x47, 0x08, 0x74, 0xae, 0x14, 0x31, 0xf1, 0x1b,
+          0xeb, 0xcb, 0xae, 0x97, 0xcc, 0x96, 0x6f, 0x99 },
+        { 0x85, 0x7e, 0xbd, 0xbf, 0x5d, 0xa9, 0xe5, 0x5e,
+          0x81, 0x38, 0xca, 0x9c, 0xca, 0x91, 0x02, 0xda }
+    };
+    const uint8_t ivcbc[16] = {  /* CBC モード動作確認用初期化ベクタ */
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+    };
+    const uint8_t ccbc[96] = {  /* CBC モード動作確認用暗号文期待値(平文は n*7+3) */
+        0x92, 0xf3, 0x08, 0xba, 0xbb, 0xf5, 0xf0, 0x11,
+        0x51, 0xeb, 0x5c, 0xd7, 0xb8, 0x68, 0xb7, 0x89,
+        0x7a, 0xcc, 0x61, 0xa7, 0x65, 0xcc, 0x85, 0xb0,
+        0x2a, 0xbe, 0xb6, 0xdc, 0x78, 0xb9, 0x44, 0x27,
+        0xed, 0x3b, 0x06, 0xcd, 0x07, 0x74, 0xb2, 0xf3,
+        0x7b, 0x03, 0x06, 0x42, 0xba, 0x88, 0xf3, 0x8f,
+        0xb7, 0x85, 0x16, 0x5c, 0xdd, 0xaa, 0x55, 0xe3,
+        0xb0, 0x50, 0xf1, 0x36, 0x4c, 0x2b, 0x31, 0xbd,
+        0xdf, 0x65, 0xd7, 0x2f, 0x59, 0xf6, 0xab, 0xe6,
+        0xd3, 0x6d, 0xe4, 0x95, 0x02, 0x23, 0xe5, 0x1a,
+        0x51, 0x40, 0xee, 0x26, 0x5b, 0x3f, 0x13, 0xa5,
+        0xf3, 0x73, 0x10, 0xcc, 0x62, 0x70, 0x12, 0xce
+    };
+    const uint8_t cxts[100] = {  /* XTS モード動作確認用暗号文期待値(平文は n*7+3, セクタ番号 0x0123456789) */
+        0xf7, 0x36, 0xfa, 0x44, 0xb7, 0xe7, 0xf0, 0x55,
+        0xf4, 0x09, 0xcb, 0x1c, 0x6f, 0xb0, 0x6d, 0xbe,
+        0x1e, 0xc4, 0x7a, 0xe8, 0x39, 0xc4, 0x62, 0x54,
+        0x79, 0xde, 0x32, 0x24, 0x76, 0x87, 0xae, 0xce,
+        0x36, 0xf6, 0x36, 0x77, 0x87, 0x88, 0xbd, 0xe0,
+        0x03, 0x12, 0xf0, 0x5e, 0x1d, 0xe6, 0x4a, 0xe9,
+        0x20, 0x08, 0x22, 0x94, 0x4a, 0x0e, 0xcf, 0x26,
+        0x90, 0x79, 0xeb, 0x10, 0xea, 0x38, 0xda, 0x5e,
+        0x59, 0x17, 0x0b, 0xcd, 0xac, 0x0b, 0x8f, 0x91,
+        0x87, 0xa0, 0xe1, 0x06, 0xd0, 0x1e, 0x4e, 0xc6,
+        0x0e, 0x76, 0x88, 0x6e, 0x13, 0xf1, 0x27, 0x87,
+        0xed, 0xf6, 0x08, 0x1e, 0xe7, 0x74, 0x1f, 0x37,
+        0x99, 0x12, 0x4e, 0xa1
+    };
+    const uint8_t necb[3][16] = {  /* NESSIE Set 2 (キーは0, 平文は1ビットのみ1の128ブロック)の暗号文の排他的論理和期待値(128bit, 192bit, 256bit) */
+        {0xa7, 0xd3, 0x38, 0x95, 0x30, 0x7b, 0x45, 0x29,
+         0xbe, 0x47, 0x41, 0xba, 0x55, 0xd1, 0x0e, 0x37},
+        {0x46, 0xa3, 0xab, 0x82, 0x98, 0xb9, 0xbe, 0x3d,
+         0x89, 0xb4, 0x6b, 0x48, 0x24, 0x0a, 0x8e, 0x80},
+        {0x69, 0xb3, 0x3b, 0xe9, 0x93, 0xce, 0x6b, 0x2f,
+         0x18, 0xf9, 0xc2, 0x52, 0xd2, 0x29, 0x00, 0x08}
+    };
+    const uint8_t mecb[3][16] = {  /* NESSIE Set 2 を1000回反復して暗号化した暗号文の排他的論理和期待値(128bit, 192bit, 256bit) */
+        {0xa4, 0x5b, 0xb8, 0xc4, 0x21, 0xb2, 0x01, 0xd7,
+         0x0a, 0x00, 0x1d, 0x69, 0x6d, 0x5b, 0x6e, 0xf1},
+        {0xec, 0xb9, 0x9f, 0x57, 0x40, 0x2b, 0x8a, 0x22,
+         0xc8, 0x3d, 0xcc, 0xf6, 0x02, 0xd0, 0x47, 0x91},
+        {0xdc, 0xd5, 0xd6, 0x1b, 0x39, 0xee, 0xe9, 0x6a,
+         0x78, 0x1d, 0xda, 0x8b, 0x75, 0x2a, 0xed, 0x5e}
+    };
+    const uint8_t kctr[3][16] = {  /* RFC 5528 Camellia-CTR Test Vector #1 ～ #3 キー */
+        {0xae, 0x68, 0x52, 0xf8, 0x12, 0x10, 0x67, 0xcc,
+         0x4b, 0xf7, 0xa5, 0x76, 0x55, 0x77, 0xf3, 0x9e},
+        {0x7e, 0x24, 0x06, 0x78, 0x17, 0xfa, 0xe0, 0xd7,
+         0x43, 0xd6, 0xce, 0x1f, 0x32, 0x53, 0x91, 0x63},
+        {0x76, 0x91, 0xbe, 0x03, 0x5e, 0x50, 0x20, 0xa8,
+         0xac, 0x6e, 0x61, 0x85, 0x29, 0xf9, 0xa0, 0xdc}
+    };
+    const uint8_t ivrctr[3][16] = {  /* RFC 5528 Camellia-CTR Test Vector #1 ～ #3 カウンタブロック初期値(ナンス, IV, カウンタ) */
+        {0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00,
+         0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01},
+        {0x00, 0x6c, 0xb6, 0xdb, 0xc0, 0x54, 0x3b, 0x59,
+         0xda, 0x48, 0xd9, 0x0b, 0x00, 0x00, 0x00, 0x01},
+        {0x00, 0xe0, 0x01, 0x7b, 0x27, 0x77, 0x7f, 0x3f,
+         0x4a, 0x17, 0x86, 0xf0, 0x00, 0x00, 0x00, 0x01}
+    };
+    const uint8_t rctr[84] = {  /* RFC 5528 Camellia-CTR Test Vector #1 ～ #3 暗号文期待値(16, 32, 36バイト) */
+        0xd0, 0x9d, 0xc2, 0x9a, 0x82, 0x14, 0x61, 0x9a,
+        0x20, 0x87, 0x7c, 0x76, 0xdb, 0x1f, 0x0b, 0x3f,
+        0xdb, 0xf3, 0xc7, 0x8d, 0xc0, 0x83, 0x96, 0xd4,
+        0xda, 0x7c, 0x90, 0x77, 0x65, 0xbb, 0xcb, 0x44,
+        0x2b, 0x8e, 0x8e, 0x0f, 0x31, 0xf0, 0xdc, 0xa7,
+        0x2c, 0x74, 0x17, 0xe3, 0x53, 0x60, 0xe0, 0x48,
+        0xb1, 0x9d, 0x1f, 0xcd, 0xcb, 0x75, 0xeb, 0x88,
+        0x2f, 0x84, 0x9c, 0xe2, 0x4d, 0x85, 0xcf, 0x73,
+        0x9c, 0xe6, 0x4b, 0x2b, 0x5c, 0x9d, 0x73, 0xf1,
+        0x4f, 0x2d, 0x5d, 0x9d, 0xce, 0x98, 0x89, 0xcd,
+        0xdf, 0x50, 0x86, 0x96
+    };
+    const uint8_t fccm[16] = {  /* RFC 5528 Packet Vector #1 ～ #12 の暗号文と認証タグを連結した排他的論理和期待値 */
+        0xb3, 0x73, 0xf5, 0x5d, 0xc7, 0x4b, 0xf8, 0xe2,
+        0x40, 0x32, 0x96, 0x06, 0x74, 0x36, 0x72, 0xbd
+    };
+    const uint8_t mmode[6][16] = {  /* Monte-Carlo (1000回反復)の結果の排他的論理和期待値(CBC, CTR, GCM, CCM, CMAC, XTS) */
+        {0xa4, 0xc3, 0xad, 0xe9, 0xfb, 0x2a, 0xa1, 0xd6,
+         0xa1, 0xe9, 0x22, 0x1a, 0x0f, 0x30, 0x20, 0x5e},
+        {0xf4, 0x1f, 0x8e, 0xa4, 0x3d, 0x7e, 0x05, 0xaf,
+         0xc5, 0xda, 0xd8, 0x37, 0x62, 0xe4, 0xf1, 0xae},
+        {0x8e, 0xd8, 0xb9, 0x0d, 0xa6, 0x2c, 0x2e, 0x88,
+         0x65, 0x0d, 0xb4, 0x6c, 0x0b, 0x82, 0x67, 0x0e},
+        {0xcb, 0x2c, 0x9e, 0x5e, 0x56, 0xbd, 0xdd, 0x02,
+         0xe6, 0x52, 0x14, 0xb3, 0x10, 0x04, 0xdc, 0x92},
+        {0x71, 0xc0, 0x97, 0x2c, 0x92, 0xab, 0x5e, 0x3f,
+         0x6b, 0xee, 0x3d, 0xfd, 0xfd, 0xf3, 0x17, 0x41},
+        {0x4c, 0xa5, 0x6c, 0xd7, 0xf8, 0x2b, 0x38, 0xf6,
+         0x0b, 0xf3, 0x68, 0x64, 0xca, 0x69, 0x30, 0x6f}
+    };
+    const size_t lctr[3] = {16, 32, 36};  /* RFC 5528 Camellia-CTR Test Vector #1 ～ #3 平文のバイト数 */
+    const CamelliaKeytype types[3] = {Camellia128Encrypt, Camellia192Encrypt, Camellia256Encrypt};
     CamelliaData data;  /* 変換テーブル */
+    CamelliaData keys[3];  /* 変換テーブル(CBC モード複数ストリーム用) */
+    CamelliaData bulk[67];  /* 変換テーブル(複数キー一括キースケジューリング用) */
+    CamelliaCbcStream stream[96];  /* CBC モード ストリーム */
+    CamelliaCtr ctr;  /* CTR モード 状態 */
+    CamelliaCtrJob job[70];  /* CTR モード ジョブ */
+    CamelliaCcm ccm;  /* CCM モード 状態 */
+    CamelliaCmacKey cmkey[3];  /* CMAC 鍵 */
+    CamelliaCmac cmac;  /* CMAC 状態 */
+    CamelliaCmacJob mjob[70];  /* CMAC 検証ジョブ */
+    uint8_t tags[70][16];  /* CMAC 認証タグ(複数メッセージ一括検証用) */
+    CamelliaGcm gcm;  /* GCM モード 状態 */
+    CamelliaMt *mt = NULL;  /* 並列処理エンジン */
+    CamelliaUring *uring = NULL;  /* 非同期暗号化パイプライン */
+    CamelliaUringCipher cipher;  /* 非同期暗号化パイプラインの暗号化/復号の条件 */
+    FILE *file = NULL;
+    CamelliaCache *cache = NULL;  /* 変換テーブルのキャッシュ */
+    CamelliaCacheStats stats;  /* キャッシュの統計 */
+    const CamelliaData *cached[3];  /* キャッシュから取得した変換テーブル */
+    CamelliaStats rstats;  /* 実行時統計 */
     uint8_t v[16];
+    uint8_t w[137][16];
+    uint8_t u[100];
+    uint8_t t[16];
+    uint8_t z[2][2048];
+    uint8_t x[2][16 * 300 + 16];
+    uint8_t y[16 * 300];
+    uint8_t key[32];
+    uint8_t *in, *out;
+    size_t off, i, blocks;
+    uint64_t seed = 0x0123456789abcdef;
+    uint64_t total;
+    CamelliaKernel kernel;
+    int n;
     int status = -1;
 
     /* Encrypt */
@@ -70,6 +321,11 @@ int main(int argc, char *argv[]) {
     if (camelliaDatarand(p, &data, v) < 0) goto error;
     if (memcmp(v, c128, sizeof(v))) goto error;
 
+    /* Decrypt (逆変換) */
+    memset(v, 0, sizeof(v));
+    if (camelliaDatarandInv(c128, &data, v) < 0) goto error;
+    if (memcmp(v, p, sizeof(v))) goto error;
+
     /* Decrypt */
     if (camelliaKeyswap(&data) < 0) goto error;
     memset(v, 0, sizeof(v));
@@ -82,6 +338,11 @@ int main(int argc, char *argv[]) {
     if (camelliaDatarand(p, &data, v) < 0) goto error;
     if (memcmp(v, c192, sizeof(v))) goto error;
 
+    /* Decrypt (逆変換) */
+    memset(v, 0, sizeof(v));
+    if (camelliaDatarandInv(c192, &data, v) < 0) goto error;
+    if (memcmp(v, p, sizeof(v))) goto error;
+
     /* Decrypt */
     if (camelliaKeyswap(&data) < 0) goto error;
     memset(v, 0, sizeof(v));
@@ -94,14 +355,635 @@ int main(int argc, char *argv[]) {
     if (camelliaDatarand(p, &data, v) < 0) goto error;
     if (memcmp(v, c256, sizeof(v))) goto error;
 
+    /* Decrypt (逆変換) */
+    memset(v, 0, sizeof(v));
+    if (camelliaDatarandInv(c256, &data, v) < 0) goto error;
+    if (memcmp(v, p, sizeof(v))) goto error;
+
     /* Decrypt */
     if (camelliaKeyswap(&data) < 0) goto error;
     memset(v, 0, sizeof(v));
     if (camelliaDatarand(c256, &data, v) < 0) goto error;
     if (memcmp(v, p, sizeof(v))) goto error;
 
+    for (kernel = CamelliaKernelGeneric; camelliaKernelName(kernel) != NULL; ++kernel) {
+        if (!camelliaKernelSupported(kernel)) continue;
+        if (camelliaKernelSelect(kernel) < 0) goto error;
+
+        /* Encrypt (選択中のカーネルでのキースケジューリングと1ブロックの処理) */
+        if (camelliaKeysche(Camellia128Encrypt, k128, &data) < 0) goto error;
+        if (camelliaDatarand(p, &data, v) < 0) goto error;
+        if (memcmp(v, c128, sizeof(v))) goto error;
+        if (camelliaKeysche(Camellia192Encrypt, k192, &data) < 0) goto error;
+        if (camelliaDatarand(p, &data, v) < 0) goto error;
+        if (memcmp(v, c192, sizeof(v))) goto error;
+        if (camelliaKeysche(Camellia256Encrypt, k256, &data) < 0) goto error;
+        if (camelliaDatarandInv(c256, &data, v) < 0) goto error;
+        if (memcmp(v, p, sizeof(v))) goto error;
+
+        /* Encrypt (Bulk) */
+        if (camelliaKeysche(Camellia256Encrypt, k256, &data) < 0) goto error;
+        for (n = 0; n < 137; ++n)
+            memcpy(w[n], p, sizeof(w[n])), w[n][15] ^= n;
+        if (camelliaDatarandBulk(w[0], &data, w[0], 137) < 0) goto error;
+        for (n = 0; n < 137; ++n) {
+            memcpy(v, p, sizeof(v)), v[15] ^= n;
+            if (camelliaDatarand(v, &data, v) < 0) goto error;
+            if (memcmp(w[n], v, sizeof(v))) goto error;
+        }
+
+        /* Decrypt (Bulk, 逆変換) */
+        if (camelliaDatarandInvBulk(w[0], &data, w[0], 137) < 0) goto error;
+        for (n = 0; n < 137; ++n) {
+            memcpy(v, p, sizeof(v)), v[15] ^= n;
+            if (memcmp(w[n], v, sizeof(v))) goto error;
+        }
+        if (camelliaDatarandBulk(w[0], &data, w[0], 137) < 0) goto error;
+
+        /* Decrypt (Bulk) */
+        if (camelliaKeyswap(&data) < 0) goto error;
+        if (camelliaDatarandBulk(w[0], &data, w[0], 137) < 0) goto error;
+        for (n = 0; n < 137; ++n) {
+            memcpy(v, p, sizeof(v)), v[15] ^= n;
+            if (memcmp(w[n], v, sizeof(v))) goto error;
+        }
+
+        /* Encrypt (CCM) */
+        if (camelliaKeysche(Camellia128Encrypt, k128, &data) < 0) goto error;
+        for (n = 0; n < 100; ++n)
+            u[n] = n * 7 + 3;
+        if (camelliaCcmSeal(&data, ivgcm, sizeof(ivgcm), aadgcm, sizeof(aadgcm), u, u, sizeof(u), t, sizeof(t)) < 0) goto error;
+        if (memcmp(u, cccm, sizeof(u))) goto error;
+        if (memcmp(t, tccm, sizeof(t))) goto error;
+
+        /* Decrypt (CCM) */
+        if (camelliaCcmOpen(&data, ivgcm, sizeof(ivgcm), aadgcm, sizeof(aadgcm), u, u, sizeof(u), t, sizeof(t)) < 0) goto error;
+        for (n = 0; n < 100; ++n)
+            if (u[n] != (uint8_t)(n * 7 + 3)) goto error;
+
+        /* Key schedule (Bulk) */
+        for (n = 0; n < 137; ++n)
+            memcpy(w[n], k256, sizeof(w[n])), w[n][0] ^= n;
+        if (camelliaKeyscheBulk(Camellia128Encrypt, w[0], bulk, 67) < 0) goto error;
+        for (n = 0; n < 67; ++n) {
+            if (camelliaKeysche(Camellia128Encrypt, w[0] + 16 * n, &data) < 0) goto error;
+            if (memcmp(bulk[n].sk, data.sk, sizeof(data.sk)) || bulk[n].type != data.type) goto error;
+        }
+        if (camelliaKeyscheBulk(Camellia192Encrypt, w[0], bulk, 67) < 0) goto error;
+        for (n = 0; n < 67; ++n) {
+            if (camelliaKeysche(Camellia192Encrypt, w[0] + 24 * n, &data) < 0) goto error;
+            if (memcmp(bulk[n].sk, data.sk, sizeof(data.sk)) || bulk[n].type != data.type) goto error;
+        }
+        if (camelliaKeyscheBulk(Camellia256Encrypt, w[0], bulk, 67) < 0) goto error;
+        for (n = 0; n < 67; ++n) {
+            if (camelliaKeysche(Camellia256Encrypt, w[0] + 32 * n, &data) < 0) goto error;
+            if (memcmp(bulk[n].sk, data.sk, sizeof(data.sk)) || bulk[n].type != data.type) goto error;
+        }
+
+        /* Encrypt (CTR, Jobs) */
+        if (camelliaKeysche(Camellia128Encrypt, k128, &bulk[0]) < 0) goto error;
+        if (camelliaKeysche(Camellia192Encrypt, k192, &bulk[1]) < 0) goto error;
+        if (camelliaKeysche(Camellia256Encrypt, k256, &bulk[2]) < 0) goto error;
+        for (n = 0; n < (int)sizeof(z[0]); ++n)
+            z[0][n] = n * 7 + 3;
+        for (n = 0, off = 0; n < 70; ++n) {
+            job[n].data = &bulk[n % 3];
+            memcpy(job[n].iv, ivctr, sizeof(job[n].iv)), job[n].iv[15] ^= n;
+            job[n].in = z[0] + off, job[n].out = z[1] + off, job[n].len = n * 37 % 50;
+            off += job[n].len;
+        }
+        if (camelliaCtrJobs(job, 70) < 0) goto error;
+        for (n = 0; n < 70; ++n) {
+            memcpy(v, ivctr, sizeof(v)), v[15] ^= n;
+            if (camelliaCtrInit(&ctr, job[n].data, v) < 0) goto error;
+            if (camelliaCtrUpdate(&ctr, job[n].in, (uint8_t *)job[n].in, job[n].len) < 0) goto error;
+            if (memcmp(job[n].in, job[n].out, job[n].len)) goto error;
+            if (memcmp(job[n].iv, ctr.ctr, sizeof(ctr.ctr))) goto error;
+        }
+
+        /* Encrypt (Bulk, 参照実装との比較) */
+        for (n = 0, seed = 0x0123456789abcdef; n < 48; ++n) {  /* 乱数のキー, ブロック数, アライメント */
+            for (i = 0; i < sizeof(key); ++i)
+                key[i] = rnd(&seed);
+            if (camelliaKeysche(types[n % 3], key, &data) < 0) goto error;
+            if (n / 3 & 4 && camelliaKeyswap(&data) < 0) goto error;  /* 復号キー */
+            blocks = n < 3 ? 300 : rnd(&seed) % 300;
+            in = x[0] + rnd(&seed) % 16;
+            out = n / 3 & 1 ? in : x[1] + rnd(&seed) % 16;  /* 同一領域/別領域 */
+            for (i = 0; i < 16 * blocks; ++i)
+                y[i] = in[i] = rnd(&seed);
+            if ((n / 3 & 2 ? camelliaDatarandInvBulk : camelliaDatarandBulk)(in, &data, out, blocks) < 0) goto error;
+            for (i = 0; i < blocks; ++i) {
+                if ((n / 3 & 2 ? camelliaDatarandInv : camelliaDatarand)(y + 16 * i, &data, v) < 0) goto error;
+                if (memcmp(out + 16 * i, v, sizeof(v))) goto error;
+            }
+        }
+
+        /* Encrypt (Bulk, NESSIE Set 2, 1000回反復) */
+        for (n = 0; n < 3; ++n) {
+            memset(key, 0, sizeof(key));
+            if (camelliaKeysche(types[n], key, &data) < 0) goto error;
+            memset(x[0], 0, 16 * 128);
+            for (i = 0; i < 128; ++i)
+                x[0][16 * i + i / 8] = 0x80 >> i % 8;
+            if (camelliaDatarandBulk(x[0], &data, x[0], 128) < 0) goto error;
+            memset(v, 0, sizeof(v)), fold(x[0], 16 * 128, v);
+            if (memcmp(v, necb[n], sizeof(v))) goto error;
+            for (i = 1; i < 1000; ++i)
+                if (camelliaDatarandBulk(x[0], &data, x[0], 128) < 0) goto error;
+            memset(v, 0, sizeof(v)), fold(x[0], 16 * 128, v);
+            if (memcmp(v, mecb[n], sizeof(v))) goto error;
+        }
+
+        /* Encrypt (CTR, RFC 5528 Test Vector #1 ～ #3) */
+        for (n = 0, off = 0; n < 3; off += lctr[n++]) {
+            if (camelliaKeysche(Camellia128Encrypt, kctr[n], &data) < 0) goto error;
+            for (i = 0; i < lctr[n]; ++i)
+                u[i] = n == 0 ? (uint8_t)"Single block msg"[i] : (uint8_t)i;
+            if (camelliaCtrInit(&ctr, &data, ivrctr[n]) < 0) goto error;
+            if (camelliaCtrUpdate(&ctr, u, u, lctr[n]) < 0) goto error;
+            if (memcmp(u, rctr + off, lctr[n])) goto error;
+        }
+
+        /* Encrypt (CCM, RFC 5528 Packet Vector #1 ～ #12) */
+        if (camelliaKeysche(Camellia128Encrypt, kccm, &data) < 0) goto error;
+        memset(v, 0, sizeof(v));
+        for (n = 0; n < 12; ++n) {
+            memcpy(t, nccm, sizeof(nccm)), t[3] = n + 3, t[4] = n + 2, t[5] = n + 1, t[6] = n;
+            for (i = 0; i < 33; ++i)
+                u[i] = i;
+            off = n % 6 < 3 ? 8 : 12;  /* AAD のバイト数 */
+            blocks = 31 + n % 3;  /* AAD と平文のバイト数 */
+            if (camelliaCcmSeal(&data, t, sizeof(nccm), u, off, u + off, u + off, blocks - off, u + blocks, n < 6 ? 8 : 10) < 0) goto error;
+            fold(u + off, blocks - off + (n < 6 ? 8 : 10), v);
+        }
+        if (memcmp(v, fccm, sizeof(v))) goto error;
+
+        /* Monte-Carlo (CBC, 1000回反復) */
+        if (camelliaKeysche(Camellia128Encrypt, k128, &keys[0]) < 0) goto error;
+        for (n = 0; n < 100; ++n)
+            u[n] = n * 7 + 3;
+        memcpy(v, ivcbc, sizeof(v));
+        for (n = 0; n < 1000; ++n)
+            if (camelliaCbcEncrypt(&keys[0], v, u, u, 6) < 0) goto error;
+        memset(t, 0, sizeof(t)), fold(u, 96, t);
+        if (memcmp(t, mmode[0], sizeof(t))) goto error;
+
+        /* Monte-Carlo (CTR, 1000回反復) */
+        for (n = 0; n < 100; ++n)
+            u[n] = n * 7 + 3;
+        if (camelliaCtrInit(&ctr, &keys[0], ivctr) < 0) goto error;
+        for (n = 0; n < 1000; ++n)
+            if (camelliaCtrUpdate(&ctr, u, u, sizeof(u)) < 0) goto error;
+        memset(t, 0, sizeof(t)), fold(u, sizeof(u), t);
+        if (memcmp(t, mmode[1], sizeof(t))) goto error;
+
+        /* Monte-Carlo (GCM, 1000回反復, 前回の認証タグの先頭12バイトを初期化ベクタにする, 汎用カーネルではテーブル参照の GHASH) */
+        for (n = 0; n < 100; ++n)
+            u[n] = n * 7 + 3;
+        memset(t, 0, sizeof(t)), memcpy(t, ivgcm, sizeof(ivgcm));
+        for (n = 0; n < 1000; ++n) {
+            if (camelliaGcmInit(&gcm, &keys[0], t, sizeof(ivgcm)) < 0) goto error;
+            if (camelliaGcmAad(&gcm, aadgcm, sizeof(aadgcm)) < 0) goto error;
+            if (camelliaGcmEncrypt(&gcm, u, u, sizeof(u)) < 0) goto error;
+            if (camelliaGcmFinal(&gcm, t, sizeof(t)) < 0) goto error;
+        }
+        fold(u, sizeof(u), t);
+        if (memcmp(t, mmode[2], sizeof(t))) goto error;
+
+        /* Monte-Carlo (CCM, 1000回反復, 前回の認証タグの先頭12バイトをナンスにする) */
+        for (n = 0; n < 100; ++n)
+            u[n] = n * 7 + 3;
+        memset(t, 0, sizeof(t)), memcpy(t, ivgcm, sizeof(ivgcm));
+        for (n = 0; n < 1000; ++n) {
+            memcpy(v, t, sizeof(ivgcm));
+            if (camelliaCcmSeal(&keys[0], v, sizeof(ivgcm), aadgcm, sizeof(aadgcm), u, u, sizeof(u), t, sizeof(t)) < 0) goto error;
+        }
+        fold(u, sizeof(u), t);
+        if (memcmp(t, mmode[3], sizeof(t))) goto error;
+
+        /* Monte-Carlo (CMAC, 1000回反復, 認証タグをメッセージの末尾に連結する) */
+        for (n = 0; n < 100; ++n)
+            u[n] = n * 7 + 3;
+        if (camelliaCmacKeyInit(&cmkey[0], &keys[0]) < 0) goto error;
+        for (n = 0; n < 1000; ++n) {
+            if (camelliaCmac(&cmkey[0], u, sizeof(u), t, sizeof(t)) < 0) goto error;
+            memmove(u, u + 16, sizeof(u) - 16), memcpy(u + sizeof(u) - 16, t, sizeof(t));
+        }
+        memset(t, 0, sizeof(t)), fold(u, sizeof(u), t);
+        if (memcmp(t, mmode[4], sizeof(t))) goto error;
+
+        /* Monte-Carlo (XTS, 1000回反復, セクタ番号は反復回数) */
+        for (n = 0; n < 16; ++n)
+            v[n] = k128[n < 8 ? n + 8 : n - 8];
+        if (camelliaKeysche(Camellia128Encrypt, v, &keys[1]) < 0) goto error;
+        for (n = 0; n < 100; ++n)
+            u[n] = n * 7 + 3;
+        for (n = 0; n < 1000; ++n)
+            if (camelliaXtsEncrypt(&keys[0], &keys[1], n, u, u, sizeof(u)) < 0) goto error;
+        memset(t, 0, sizeof(t)), fold(u, sizeof(u), t);
+        if (memcmp(t, mmode[5], sizeof(t))) goto error;
+
+        /* Encrypt, Decrypt (XTS, 連続したセクタ, セクタごとの処理と比較) */
+        for (i = 0; i < sizeof(y); ++i)
+            x[0][i] = y[i] = rnd(&seed);
+        if (camelliaXtsEncryptSectors(&keys[0], &keys[1], 0x0123456789, 16, y, y, sizeof(y)) < 0) goto error;  /* 300セクタ(調整値は2回に分けて一括処理) */
+        for (off = 0; off < sizeof(y); off += 16)
+            if (camelliaXtsEncrypt(&keys[0], &keys[1], 0x0123456789 + off / 16, x[0] + off, x[0] + off, 16) < 0) goto error;
+        if (memcmp(x[0], y, sizeof(y))) goto error;
+        if (camelliaXtsDecryptSectors(&keys[0], &keys[1], 0x0123456789, 40, y, y, sizeof(y) - 8) < 0) goto error;  /* 最後のセクタは32バイト(暗号文窃取) */
+        for (off = 0; off < sizeof(y) - 8; off += 40)
+            if (camelliaXtsDecrypt(&keys[0], &keys[1], 0x0123456789 + off / 40, x[0] + off, x[0] + off,
+                                   sizeof(y) - 8 - off < 40 ? sizeof(y) - 8 - off : 40 ) < 0) goto error;
+        if (memcmp(x[0], y, sizeof(y))) goto error;
+
+        /* Encrypt (CBC, 複数ストリーム, カーネルの列数以上のストリームをストリームごとの暗号化と比較) */
+        if (camelliaKeysche(Camellia128Encrypt, k128, &keys[0]) < 0) goto error;
+        if (camelliaKeysche(Camellia192Encrypt, k192, &keys[1]) < 0) goto error;
+        if (camelliaKeysche(Camellia256Encrypt, k256, &keys[2]) < 0) goto error;
+        for (i = 0; i < sizeof(y); ++i)
+            x[0][i] = y[i] = rnd(&seed);
+        for (n = 0, off = 0; n < 96; ++n) {
+            stream[n].data = &keys[n % 8 == 0 ? 0 : n % 2 ? 2 : 1];
+            memset(stream[n].iv, n, sizeof(stream[n].iv));
+            stream[n].in = y + off, stream[n].out = y + off;
+            stream[n].n = n / 4 % 3 * 2 + 1;
+            off += 16 * stream[n].n;
+        }
+        if (camelliaCbcEncryptStreams(stream, 96) < 0) goto error;
+        for (n = 0, off = 0; n < 96; ++n) {
+            memset(v, n, sizeof(v));
+            if (camelliaCbcEncrypt(stream[n].data, v, x[0] + off, x[0] + off, stream[n].n) < 0) goto error;
+            if (memcmp(v, stream[n].iv, sizeof(v))) goto error;
+            off += 16 * stream[n].n;
+        }
+        if (memcmp(x[0], y, off)) goto error;
+    }
+    if (camelliaKernelSelect(CamelliaKernelAuto) < 0) goto error;
+
+    /* Encrypt (CTR) */
+    if (camelliaKeysche(Camellia128Encrypt, k128, &data) < 0) goto error;
+    for (n = 0; n < 100; ++n)
+        u[n] = n * 7 + 3;
+    if (camelliaCtrInit(&ctr, &data, ivctr) < 0) goto error;
+    if (camelliaCtrUpdate(&ctr, u +  0, u +  0,  1) < 0) goto error;
+    if (camelliaCtrUpdate(&ctr, u +  1, u +  1, 20) < 0) goto error;
+    if (camelliaCtrUpdate(&ctr, u + 21, u + 21, 79) < 0) goto error;
+    if (memcmp(u, cctr, sizeof(u))) goto error;
+
+    /* Decrypt (CTR) */
+    if (camelliaCtrInit(&ctr, &data, ivctr) < 0) goto error;
+    if (camelliaCtrUpdate(&ctr, u, u, sizeof(u)) < 0) goto error;
+    for (n = 0; n < 100; ++n)
+        if (u[n] != (uint8_t)(n * 7 + 3)) goto error;
+    if (camelliaKeyswap(&data) < 0) goto error;  /* 復号キーは受け付けない */
+    if (camelliaCtrInit(&ctr, &data, ivctr) >= 0) goto error;
+    job[0].data = &data, memcpy(job[0].iv, ivctr, sizeof(job[0].iv));
+    job[0].in = u, job[0].out = u, job[0].len = sizeof(u);
+    if (camelliaCtrJobs(job, 1) >= 0) goto error;
+
+    /* Encrypt (GCM) */
+    if (camelliaKeysche(Camellia128Encrypt, k128, &data) < 0) goto error;
+    for (n = 0; n < 100; ++n)
+        u[n] = n * 7 + 3;
+    if (camelliaGcmInit(&gcm, &data, ivgcm, sizeof(ivgcm)) < 0) goto error;
+    if (camelliaGcmAad(&gcm, aadgcm +  0,  3) < 0) goto error;
+    if (camelliaGcmAad(&gcm, aadgcm +  3, 17) < 0) goto error;
+    if (camelliaGcmEncrypt(&gcm, u +  0, u +  0,  5) < 0) goto error;
+    if (camelliaGcmEncrypt(&gcm, u +  5, u +  5, 95) < 0) goto error;
+    if (camelliaGcmFinal(&gcm, t, sizeof(t)) < 0) goto error;
+    if (memcmp(u, cgcm, sizeof(u))) goto error;
+    if (memcmp(t, tgcm, sizeof(t))) goto error;
+
+    /* Decrypt (GCM) */
+    if (camelliaGcmInit(&gcm, &data, ivgcm, sizeof(ivgcm)) < 0) goto error;
+    if (camelliaGcmAad(&gcm, aadgcm, sizeof(aadgcm)) < 0) goto error;
+    if (camelliaGcmDecrypt(&gcm, u, u, sizeof(u)) < 0) goto error;
+    if (camelliaGcmVerify(&gcm, tgcm, sizeof(tgcm)) < 0) goto error;
+    for (n = 0; n < 100; ++n)
+        if (u[n] != (uint8_t)(n * 7 + 3)) goto error;
+    t[0] = tgcm[0] ^ 0x01, memcpy(t + 1, tgcm + 1, sizeof(t) - 1);
+    if (camelliaGcmInit(&gcm, &data, ivgcm, sizeof(ivgcm)) < 0) goto error;
+    if (camelliaGcmAad(&gcm, aadgcm, sizeof(aadgcm)) < 0) goto error;
+    if (camelliaGcmDecrypt(&gcm, cgcm, u, sizeof(u)) < 0) goto error;
+    if (camelliaGcmVerify(&gcm, t, sizeof(t)) >= 0) goto error;
+
+    if (camelliaKeyswap(&data) < 0) goto error;  /* 復号キーは受け付けない */
+    if (camelliaGcmInit(&gcm, &data, ivgcm, sizeof(ivgcm)) >= 0) goto error;
+
+    /* Encrypt (CCM) */
+    if (camelliaKeysche(Camellia128Encrypt, kccm, &data) < 0) goto error;
+    for (n = 0; n < 31; ++n)
+        u[n] = n;
+    if (camelliaCcmSeal(&data, nccm, sizeof(nccm), u, 8, u + 8, u + 8, 23, u + 31, 8) < 0) goto error;
+    if (memcmp(u + 8, rccm, sizeof(rccm))) goto error;
+    if (camelliaKeysche(Camellia128Encrypt, k128, &data) < 0) goto error;
+    for (n = 0; n < 100; ++n)
+        u[n] = n * 7 + 3;
+    if (camelliaCcmInit(&ccm, &data, ivgcm, sizeof(ivgcm), sizeof(aadgcm), sizeof(u), sizeof(t)) < 0) goto error;
+    if (camelliaCcmAad(&ccm, aadgcm +  0,  3) < 0) goto error;
+    if (camelliaCcmAad(&ccm, aadgcm +  3, 17) < 0) goto error;
+    if (camelliaCcmEncrypt(&ccm, u +  0, u +  0,  5) < 0) goto error;
+    if (camelliaCcmEncrypt(&ccm, u +  5, u +  5, 60) < 0) goto error;
+    if (camelliaCcmEncrypt(&ccm, u + 65, u + 65, 35) < 0) goto error;
+    if (camelliaCcmFinal(&ccm, t) < 0) goto error;
+    if (memcmp(u, cccm, sizeof(u))) goto error;
+    if (memcmp(t, tccm, sizeof(t))) goto error;
+
+    /* Decrypt (CCM) */
+    if (camelliaCcmInit(&ccm, &data, ivgcm, sizeof(ivgcm), sizeof(aadgcm), sizeof(u), sizeof(t)) < 0) goto error;
+    if (camelliaCcmAad(&ccm, aadgcm, sizeof(aadgcm)) < 0) goto error;
+    if (camelliaCcmDecrypt(&ccm, u +  0, u +  0, 33) < 0) goto error;
+    if (camelliaCcmDecrypt(&ccm, u + 33, u + 33, 67) < 0) goto error;
+    if (camelliaCcmVerify(&ccm, tccm) < 0) goto error;
+    for (n = 0; n < 100; ++n)
+        if (u[n] != (uint8_t)(n * 7 + 3)) goto error;
+    t[0] = tccm[0] ^ 0x01, memcpy(t + 1, tccm + 1, sizeof(t) - 1);
+    if (camelliaCcmOpen(&data, ivgcm, sizeof(ivgcm), aadgcm, sizeof(aadgcm), cccm, u, sizeof(u), t, sizeof(t)) >= 0) goto error;
+    for (n = 0; n < 100; ++n)
+        if (u[n] != 0) goto error;
+    if (camelliaCcmOpen(&data, ivgcm, sizeof(ivgcm), aadgcm, sizeof(aadgcm), cccm, u, sizeof(u), tccm, sizeof(tccm)) < 0) goto error;
+    for (n = 0; n < 100; ++n)
+        if (u[n] != (uint8_t)(n * 7 + 3)) goto error;
+    if (camelliaKeyswap(&data) < 0) goto error;  /* 復号キーは受け付けない */
+    if (camelliaCcmInit(&ccm, &data, ivgcm, sizeof(ivgcm), sizeof(aadgcm), sizeof(u), sizeof(t)) >= 0) goto error;
+
+    /* CMAC */
+    if (camelliaKeysche(Camellia128Encrypt, k128, &data) < 0) goto error;
+    if (camelliaCmacKeyInit(&cmkey[0], &data) < 0) goto error;
+    for (n = 0; n < 100; ++n)
+        u[n] = n * 7 + 3;
+    camelliaCmacInit(&cmac, &cmkey[0]);
+    camelliaCmacUpdate(&cmac, u +  0,  7);
+    camelliaCmacUpdate(&cmac, u +  7, 25);
+    camelliaCmacUpdate(&cmac, u + 32, 68);
+    if (camelliaCmacFinal(&cmac, t, sizeof(t)) < 0) goto error;
+    if (memcmp(t, tcmac[0], sizeof(t))) goto error;
+    if (camelliaCmac(&cmkey[0], u, 96, t, sizeof(t)) < 0) goto error;
+    if (memcmp(t, tcmac[1], sizeof(t))) goto error;
+    if (camelliaCmac(&cmkey[0], u, 0, t, sizeof(t)) < 0) goto error;
+    if (memcmp(t, tcmac[2], sizeof(t))) goto error;
+    camelliaCmacInit(&cmac, &cmkey[0]);
+    camelliaCmacUpdate(&cmac, u +  0, 16);
+    camelliaCmacUpdate(&cmac, u + 16, 80);
+    if (camelliaCmacVerify(&cmac, tcmac[1], 12) < 0) goto error;
+    t[0] = tcmac[1][0] ^ 0x01, memcpy(t + 1, tcmac[1] + 1, sizeof(t) - 1);
+    camelliaCmacInit(&cmac, &cmkey[0]);
+    camelliaCmacUpdate(&cmac, u, 96);
+    if (camelliaCmacVerify(&cmac, t, sizeof(t)) >= 0) goto error;
+
+    /* CMAC (複数メッセージ一括検証) */
+    if (camelliaKeysche(Camellia128Encrypt, k128, &keys[0]) < 0) goto error;
+    if (camelliaKeysche(Camellia192Encrypt, k192, &keys[1]) < 0) goto error;
+    if (camelliaKeysche(Camellia256Encrypt, k256, &keys[2]) < 0) goto error;
+    for (n = 0; n < 3; ++n)
+        if (camelliaCmacKeyInit(&cmkey[n], &keys[n]) < 0) goto error;
+    for (n = 0; n < (int)sizeof(z[0]); ++n)
+        z[0][n] = n * 7 + 3;
+    for (n = 0, off = 0; n < 70; ++n) {
+        mjob[n].key = &cmkey[n % 3];
+        mjob[n].in = z[0] + off, mjob[n].len = n * 37 % 50;
+        mjob[n].tag = tags[n], mjob[n].taglen = 16 - n % 8;
+        if (camelliaCmac(mjob[n].key, mjob[n].in, mjob[n].len, tags[n], mjob[n].taglen) < 0) goto error;
+        off += mjob[n].len;
+    }
+    if (camelliaCmacVerifyJobs(mjob, 70) < 0) goto error;
+    tags[5][0] ^= 0x01;
+    if (camelliaCmacVerifyJobs(mjob, 70) >= 0) goto error;
+    for (n = 0; n < 70; ++n)
+        if ((mjob[n].status < 0) != (n == 5)) goto error;
+    for (n = 0; n < 70; n += 3)  /* 全ジョブ同じ鍵 */
+        mjob[n / 3] = mjob[n];
+    if (camelliaCmacVerifyJobs(mjob, 24) < 0) goto error;
+    tags[3][0] ^= 0x01;
+    if (camelliaCmacVerifyJobs(mjob, 24) >= 0) goto error;
+    for (n = 0; n < 24; ++n)
+        if ((mjob[n].status < 0) != (n == 1)) goto error;
+    if (camelliaKeyswap(&keys[0]) < 0) goto error;  /* 復号キーは受け付けない */
+    if (camelliaCmacVerifyJobs(mjob, 24) >= 0) goto error;
+    if (mjob[0].status >= 0) goto error;
+    if (camelliaCmacKeyInit(&cmkey[0], &keys[0]) >= 0) goto error;
+
+    /* Encrypt (CBC) */
+    if (camelliaKeysche(Camellia128Encrypt, k128, &data) < 0) goto error;
+    for (n = 0; n < 96; ++n)
+        u[n] = n * 7 + 3;
+    memcpy(v, ivcbc, sizeof(v));
+    if (camelliaCbcEncrypt(&data, v, u +  0, u +  0, 1) < 0) goto error;
+    if (camelliaCbcEncrypt(&data, v, u + 16, u + 16, 5) < 0) goto error;
+    if (memcmp(u, ccbc, sizeof(ccbc))) goto error;
+
+    /* Decrypt (CBC, 逆変換) */
+    memcpy(v, ivcbc, sizeof(v));
+    if (camelliaCbcDecrypt(&data, v, ccbc, u, 6) < 0) goto error;
+    for (n = 0; n < 96; ++n)
+        if (u[n] != (uint8_t)(n * 7 + 3)) goto error;
+
+    /* Decrypt (CBC) */
+    if (camelliaKeyswap(&data) < 0) goto error;
+    memcpy(v, ivcbc, sizeof(v));
+    if (camelliaCbcDecrypt(&data, v, ccbc, u, 6) < 0) goto error;
+    for (n = 0; n < 96; ++n)
+        if (u[n] != (uint8_t)(n * 7 + 3)) goto error;
+    memcpy(v, ivcbc, sizeof(v));
+    memcpy(u, ccbc, sizeof(ccbc));
+    if (camelliaCbcDecrypt(&data, v, u +  0, u +  0, 2) < 0) goto error;
+    if (camelliaCbcDecrypt(&data, v, u + 32, u + 32, 4) < 0) goto error;
+    for (n = 0; n < 96; ++n)
+        if (u[n] != (uint8_t)(n * 7 + 3)) goto error;
+    if (camelliaCbcEncrypt(&data, v, u, u, 6) >= 0) goto error;  /* 復号キーでは暗号化しない */
+
+    /* Encrypt (CBC, 複数ストリーム) */
+    if (camelliaKeysche(Camellia128Encrypt, k128, &keys[0]) < 0) goto error;
+    if (camelliaKeysche(Camellia192Encrypt, k192, &keys[1]) < 0) goto error;
+    if (camelliaKeysche(Camellia256Encrypt, k256, &keys[2]) < 0) goto error;
+    for (n = 0; n < 61; ++n)
+        memcpy(w[n], p, sizeof(w[n])), w[n][15] ^= n;
+    for (n = 0; n < 5; ++n) {
+        stream[n].data = &keys[n % 3];
+        memcpy(stream[n].iv, ivcbc, sizeof(stream[n].iv)), stream[n].iv[0] ^= n;
+        stream[n].in = w[n * 12], stream[n].out = w[n * 12];
+        stream[n].n = 12 - n * 2;
+    }
+    if (camelliaCbcEncryptStreams(stream, 5) < 0) goto error;
+
+    /* Decrypt (CBC, 複数ストリーム) */
+    for (n = 0; n < 3; ++n)
+        if (camelliaKeyswap(&keys[n]) < 0) goto error;
+    for (n = 0; n < 5; ++n) {
+        memcpy(v, ivcbc, sizeof(v)), v[0] ^= n;
+        if (camelliaCbcDecrypt(&keys[n % 3], v, w[n * 12], w[n * 12], 12 - n * 2) < 0) goto error;
+        if (memcmp(v, stream[n].iv, sizeof(v))) goto error;
+    }
+    for (n = 0; n < 61; ++n) {
+        memcpy(v, p, sizeof(v)), v[15] ^= n;
+        if (memcmp(w[n], v, sizeof(v))) goto error;
+    }
+    if (camelliaCbcEncryptStreams(stream, 5) >= 0) goto error;  /* 復号キーでは暗号化しない */
+
+    /* Encrypt (XTS) */
+    if (camelliaKeysche(Camellia128Encrypt, k128, &keys[0]) < 0) goto error;
+    for (n = 0; n < 16; ++n)
+        v[n] = k128[n < 8 ? n + 8 : n - 8];
+    if (camelliaKeysche(Camellia128Encrypt, v, &keys[1]) < 0) goto error;
+    for (n = 0; n < 100; ++n)
+        u[n] = n * 7 + 3;
+    if (camelliaXtsEncrypt(&keys[0], &keys[1], 0x0123456789, u, u, sizeof(u)) < 0) goto error;
+    if (memcmp(u, cxts, sizeof(u))) goto error;
+
+    /* Decrypt (XTS, 逆変換) */
+    if (camelliaXtsDecrypt(&keys[0], &keys[1], 0x0123456789, cxts, u, sizeof(u)) < 0) goto error;
+    for (n = 0; n < 100; ++n)
+        if (u[n] != (uint8_t)(n * 7 + 3)) goto error;
+
+    /* Decrypt (XTS) */
+    if (camelliaKeyswap(&keys[0]) < 0) goto error;
+    if (camelliaXtsDecrypt(&keys[0], &keys[1], 0x0123456789, cxts, u, sizeof(u)) < 0) goto error;
+    for (n = 0; n < 100; ++n)
+        if (u[n] != (uint8_t)(n * 7 + 3)) goto error;
+    if (camelliaXtsEncrypt(&keys[0], &keys[1], 0x0123456789, u, u, sizeof(u)) >= 0) goto error;  /* 復号キーでは暗号化しない */
+    if (camelliaXtsDecrypt(&keys[1], &keys[0], 0x0123456789, cxts, u, sizeof(u)) >= 0) goto error;  /* 調整値用キーは暗号キーのみ */
+    if (camelliaXtsDecryptSectors(&keys[0], &keys[1], 0x0123456789, 40, cxts, u, 88) >= 0) goto error;  /* 最後のセクタが16バイト未満 */
+
+    /* 並列処理 (3スレッド, 2ブロック単位に分割) */
+    if ((mt = camelliaMtCreate(3, 32)) == NULL) goto error;
+    if (camelliaMtThreads(mt) != 3) goto error;
+
+    /* Encrypt (並列処理) */
+    if (camelliaKeysche(Camellia256Encrypt, k256, &data) < 0) goto error;
+    for (n = 0; n < 61; ++n)
+        memcpy(w[n], p, sizeof(w[n])), w[n][15] ^= n;
+    if (camelliaMtDatarand(mt, w[0], &data, w[0], 61) < 0) goto error;
+    for (n = 0; n < 61; ++n) {
+        memcpy(v, p, sizeof(v)), v[15] ^= n;
+        if (camelliaDatarand(v, &data, v) < 0) goto error;
+        if (memcmp(w[n], v, sizeof(v))) goto error;
+    }
+
+    /* Decrypt (並列処理, 逆変換) */
+    if (camelliaMtDatarandInv(mt, w[0], &data, w[0], 61) < 0) goto error;
+    for (n = 0; n < 61; ++n) {
+        memcpy(v, p, sizeof(v)), v[15] ^= n;
+        if (memcmp(w[n], v, sizeof(v))) goto error;
+    }
+
+    /* Encrypt (並列処理, 参照実装との比較) */
+    for (n = 0; n < 16; ++n) {  /* 乱数のブロック数, アライメント */
+        blocks = rnd(&seed) % 300;
+        in = x[0] + rnd(&seed) % 16;
+        for (i = 0; i < 16 * blocks; ++i)
+            y[i] = in[i] = rnd(&seed);
+        if (camelliaMtDatarand(mt, in, &data, in, blocks) < 0) goto error;
+        if (camelliaDatarandBulk(y, &data, y, blocks) < 0) goto error;
+        if (memcmp(in, y, 16 * blocks)) goto error;
+    }
+
+    /* Encrypt (CTR, 並列処理) */
+    if (camelliaKeysche(Camellia128Encrypt, k128, &data) < 0) goto error;
+    for (n = 0; n < 100; ++n)
+        u[n] = n * 7 + 3;
+    if (camelliaCtrInit(&ctr, &data, ivctr) < 0) goto error;
+    if (camelliaMtCtr(mt, &ctr, u +  0, u +  0,  1) < 0) goto error;
+    if (camelliaMtCtr(mt, &ctr, u +  1, u +  1, 70) < 0) goto error;
+    if (camelliaMtCtr(mt, &ctr, u + 71, u + 71, 29) < 0) goto error;
+    if (memcmp(u, cctr, sizeof(u))) goto error;
+
+    /* Encrypt (XTS, 並列処理) */
+    if (camelliaMtXtsEncrypt(mt, &keys[0], &keys[1], 0x0123456789, 40, u, u, sizeof(u)) >= 0) goto error;  /* 復号キーでは暗号化しない */
+    if (camelliaKeyswap(&keys[0]) < 0) goto error;
+    for (n = 0; n < 100; ++n)
+        u[n] = n * 7 + 3;
+    memcpy(w, u, sizeof(u));
+    if (camelliaMtXtsEncrypt(mt, &keys[0], &keys[1], 0x0123456789, 40, u, u, sizeof(u)) < 0) goto error;
+    for (n = 0; n < 100; n += 40)
+        if (camelliaXtsEncrypt(&keys[0], &keys[1], 0x0123456789 + n / 40, (uint8_t *)w + n, (uint8_t *)w + n, n + 40 < 100 ? 40 : 100 - n) < 0) goto error;
+    if (memcmp(u, w, sizeof(u))) goto error;
+
+    /* Decrypt (XTS, 並列処理) */
+    if (camelliaMtXtsDecrypt(mt, &keys[0], &keys[1], 0x0123456789, 40, u, u, sizeof(u)) < 0) goto error;
+    for (n = 0; n < 100; ++n)
+        if (u[n] != (uint8_t)(n * 7 + 3)) goto error;
+
+    /* 非同期暗号化パイプライン (io_uring が利用できる場合のみ, 3バッファ, 4ブロック単位) */
+    if ((uring = camelliaUringCreate(3, 64, 2)) != NULL) {
+        if ((file = tmpfile()) == NULL) goto error;
+
+        /* Encrypt (CTR, io_uring) */
+        for (n = 0; n < 100; ++n)
+            u[n] = n * 7 + 3;
+        if (pwrite(fileno(file), u, sizeof(u), 0) != sizeof(u)) goto error;
+        memset(&cipher, 0, sizeof(cipher));
+        cipher.mode = CamelliaUringCtr, cipher.data = &data;
+        memcpy(cipher.iv, ivctr, sizeof(cipher.iv));
+        if (camelliaUringRun(uring, &cipher, fileno(file), 0, fileno(file), 100, 100) < 0) goto error;
+        if (pread(fileno(file), u, sizeof(u), 100) != sizeof(u)) goto error;
+        if (memcmp(u, cctr, sizeof(u))) goto error;
+
+        /* Encrypt (XTS, io_uring) */
+        cipher.mode = CamelliaUringXtsEncrypt, cipher.data = &keys[0], cipher.data2 = &keys[1];
+        cipher.sector = 0x0123456789, cipher.size = 40;
+        if (camelliaUringRun(uring, &cipher, fileno(file), 0, fileno(file), 0, 100) < 0) goto error;
+        if (pread(fileno(file), u, sizeof(u), 0) != sizeof(u)) goto error;
+        if (memcmp(u, w, sizeof(u))) goto error;
+
+        /* Decrypt (XTS, io_uring) */
+        cipher.mode = CamelliaUringXtsDecrypt;
+        if (camelliaUringRun(uring, &cipher, fileno(file), 0, fileno(file), 0, 100) < 0) goto error;
+        if (pread(fileno(file), u, sizeof(u), 0) != sizeof(u)) goto error;
+        for (n = 0; n < 100; ++n)
+            if (u[n] != (uint8_t)(n * 7 + 3)) goto error;
+
+        /* 入力が短い */
+        if (camelliaUringRun(uring, &cipher, fileno(file), 100, fileno(file), 200, 101) >= 0) goto error;
+    }
+
+    /* 変換テーブルのキャッシュ (2個) */
+    if ((cache = camelliaCacheCreate(2)) == NULL) goto error;
+    if ((cached[0] = camelliaCacheGet(cache, Camellia128Encrypt, k128)) == NULL) goto error;
+    if (camelliaCacheGet(cache, Camellia128Encrypt, k128) != cached[0]) goto error;
+    if (camelliaDatarand(p, cached[0], v) < 0) goto error;
+    if (memcmp(v, c128, sizeof(v))) goto error;
+    if ((cached[1] = camelliaCacheGet(cache, Camellia128Decrypt, k128)) == NULL) goto error;
+    if (camelliaDatarand(c128, cached[1], v) < 0) goto error;
+    if (memcmp(v, p, sizeof(v))) goto error;
+    if (camelliaCacheGet(cache, Camellia256Encrypt, k256) != NULL) goto error;  /* 全て取得中 */
+    camelliaCacheRelease(cache, cached[0]);
+    camelliaCacheRelease(cache, cached[0]);
+    if ((cached[2] = camelliaCacheGet(cache, Camellia256Encrypt, k256)) == NULL) goto error;  /* 128bit 暗号キーを消去 */
+    if (camelliaDatarand(p, cached[2], v) < 0) goto error;
+    if (memcmp(v, c256, sizeof(v))) goto error;
+    camelliaCacheStats(cache, &stats);
+    if (stats.hits != 1 || stats.misses != 4 || stats.evictions != 1 || stats.entries != 2) goto error;
+    camelliaCacheRelease(cache, cached[1]);
+    camelliaCacheRelease(cache, cached[2]);
+
+    /* 実行時統計 (configure --enable-stats でビルドした場合のみ) */
+    camelliaStatsReset();
+    if (camelliaStatsGet(&rstats) >= 0) {
+        if (rstats.bulk != 0 || rstats.kernelBytes[camelliaKernelCurrent()] != 0) goto error;
+        if (camelliaKeysche(Camellia192Encrypt, k192, &data) < 0) goto error;
+        if (camelliaDatarand(p, &data, v) < 0) goto error;
+        if (camelliaDatarandBulk(w[0], &data, w[0], 100) < 0) goto error;
+        if (camelliaMtDatarand(mt, w[0], &data, w[0], 61) < 0) goto error;
+        camelliaMtDestroy(mt), mt = NULL;  /* 終了したスレッドの集計値も残る */
+        if (camelliaStatsGet(&rstats) < 0) goto error;
+        if (rstats.keysche[0] != 0 || rstats.keysche[1] != 1 || rstats.keysche[2] != 0) goto error;
+        if (rstats.single != 1 || rstats.bulkBlocks != 161 || rstats.batch[6] != 1) goto error;
+        for (n = 0, total = 0; n < CAMELLIA_STATS_KERNELS; ++n)
+            total += rstats.kernelBytes[n];
+        if (total != 16 * 161) goto error;
+    }
+    else {
+        if (rstats.bulk != 0) goto error;
+    }
+
     status = 0;
 error:
+    camelliaCacheDestroy(cache);
+    if (file != NULL)
+        fclose(file);
+    camelliaUringDestroy(uring);
+    camelliaMtDestroy(mt);
     printf("%s\n", status < 0 ? "NG" : "OK");
     return status < 0 ? 1 : 0;
 }
@@ -0,0 +1,168 @@
+/* example.cpp - Last modified: 16-Oct-2026 (kobayasy)
+ *
+ * Copyright (c) 2021 by Yuichi Kobayashi <kobayasy@kobayasy.com>
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation files
+ * (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS
+ * BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ * ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "camellia.h"
+#include "camellia_ctr.h"
+#include "camellia_gcm.h"
+#include "camellia.hpp"
+
+static_assert(camellia::Camellia128::rounds == 18 && camellia::Camellia192::rounds == 24 && camellia::Camellia256::rounds == 24);
+static_assert(!std::is_copy_constructible_v<camellia::Camellia128> && std::is_nothrow_move_constructible_v<camellia::Camellia128>);
+
+int main(int argc, char *argv[]) {
+    const std::uint8_t k128[16] = {  /* 128bitサイズキー */
+        0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef,
+        0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10
+    };
+    const std::uint8_t k192[24] = {  /* 192bitサイズキー */
+        0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef,
+        0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10,
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77
+    };
+    const std::uint8_t k256[32] = {  /* 256bitサイズキー */
+        0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef,
+        0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10,
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+    };
+    const std::uint8_t p[16] = {  /* 動作確認用平文(128bit固定) */
+        0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef,
+        0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10
+    };
+    const std::uint8_t c128[16] = {  /* 動作確認用暗号文期待値(128bit固定) */
+        0x67, 0x67, 0x31, 0x38, 0x54, 0x96, 0x69, 0x73,
+        0x08, 0x57, 0x06, 0x56, 0x48, 0xea, 0xbe, 0x43
+    };
+    const std::uint8_t c192[16] = {  /* 動作確認用暗号文期待値(128bit固定) */
+        0xb4, 0x99, 0x34, 0x01, 0xb3, 0xe9, 0x96, 0xf8,
+        0x4e, 0xe5, 0xce, 0xe7, 0xd7, 0x9b, 0x09, 0xb9
+    };
+    const std::uint8_t c256[16] = {  /* 動作確認用暗号文期待値(128bit固定) */
+        0x9a, 0xcc, 0x23, 0x7d, 0xff, 0x16, 0xd7, 0x6c,
+        0x20, 0xef, 0x7c, 0x91, 0x9e, 0x3a, 0x75, 0x09
+    };
+    camellia::Camellia128 key128(k128);
+    camellia::Camellia192 key192(k192);
+    camellia::Camellia256 key256(k256);
+    CamelliaData data;  /* 変換テーブル(C の API との比較用) */
+    CamelliaCtr ctr;    /* CTR モード 状態 */
+    CamelliaGcm gcm;    /* GCM モード 状態 */
+    std::uint8_t t[16];
+    std::uint8_t v[16];
+    std::uint8_t w[2][100][16];
+    int n;
+    int status = -1;
+
+    /* Encrypt, Decrypt (128bit, 192bit, 256bit) */
+    key128.encrypt(p, v);
+    if (std::memcmp(v, c128, sizeof(v))) goto error;
+    key128.decrypt(v, v);
+    if (std::memcmp(v, p, sizeof(v))) goto error;
+    key192.encrypt(p, v);
+    if (std::memcmp(v, c192, sizeof(v))) goto error;
+    key192.decrypt(v, v);
+    if (std::memcmp(v, p, sizeof(v))) goto error;
+    key256.encrypt(p, v);
+    if (std::memcmp(v, c256, sizeof(v))) goto error;
+    key256.decrypt(v, v);
+    if (std::memcmp(v, p, sizeof(v))) goto error;
+
+    /* Encrypt, Decrypt (カーネルごと, ビットスライスのカーネル選択中は C の API で処理する) */
+    for (n = CamelliaKernelGeneric; camelliaKernelName((CamelliaKernel)n) != NULL; ++n) {
+        if (!camelliaKernelSupported((CamelliaKernel)n)) continue;
+        if (camelliaKernelSelect((CamelliaKernel)n) < 0) goto error;
+        key256.encrypt(p, v);
+        if (std::memcmp(v, c256, sizeof(v))) goto error;
+        key256.decrypt(v, v);
+        if (std::memcmp(v, p, sizeof(v))) goto error;
+    }
+    if (camelliaKernelSelect(CamelliaKernelAuto) < 0) goto error;
+
+    /* C の API と同じ結果 (連鎖させた1000ブロック) */
+    if (camelliaKeysche(Camellia192Encrypt, k192, &data) < 0) goto error;
+    std::memcpy(v, p, sizeof(v)), std::memcpy(w[0][0], p, sizeof(v));
+    for (n = 0; n < 1000; ++n) {
+        key192.encrypt(v, v);
+        if (camelliaDatarand(w[0][0], &data, w[0][0]) < 0) goto error;
+    }
+    if (std::memcmp(v, w[0][0], sizeof(v))) goto error;
+
+    /* Encrypt, Decrypt (複数ブロック一括) */
+    for (n = 0; n < 100; ++n)
+        std::memcpy(w[0][n], p, sizeof(w[0][n])), w[0][n][15] ^= n;
+    if (key256.encrypt(w[0][0], w[1][0], 100) < 0) goto error;
+    for (n = 0; n < 100; ++n) {
+        key256.encrypt(w[0][n], v);
+        if (std::memcmp(w[1][n], v, sizeof(v))) goto error;
+    }
+    if (key256.decrypt(w[1][0], w[1][0], 100) < 0) goto error;
+    if (std::memcmp(w[0], w[1], sizeof(w[0]))) goto error;
+#if __cplusplus >= 202002L
+    if (key256.encrypt(std::span(&w[0][0][0], sizeof(w[0])), std::span(&w[1][0][0], sizeof(w[1]))) < 0) goto error;
+    if (key256.decrypt(std::span(&w[1][0][0], sizeof(w[1])), std::span(&w[1][0][0], sizeof(w[1]))) < 0) goto error;
+    if (std::memcmp(w[0], w[1], sizeof(w[0]))) goto error;
+    if (key256.encrypt(std::span(&w[0][0][0], 40), std::span(&w[1][0][0], 40)) >= 0) goto error;  /* 16の倍数でない */
+    camellia::Camellia256(std::span<const std::uint8_t, 32>(k256)).encrypt(p, v);
+    if (std::memcmp(v, c256, sizeof(v))) goto error;
+#endif  /* #if __cplusplus >= 202002L */
+
+    /* 暗号利用モード (C の API に変換テーブルを渡す) */
+    std::memset(v, 0, sizeof(v));
+    if (camelliaCtrInit(&ctr, &key192.data(), p) < 0) goto error;
+    if (camelliaCtrUpdate(&ctr, v, v, sizeof(v)) < 0) goto error;
+    if (std::memcmp(v, c192, sizeof(v))) goto error;  /* 最初の鍵ストリームは初期カウンタの暗号文 */
+    if (camelliaGcmInit(&gcm, &key128.data(), p, 12) < 0) goto error;
+    if (camelliaGcmAad(&gcm, k256, sizeof(k256)) < 0) goto error;
+    if (camelliaGcmEncrypt(&gcm, w[0][0], w[1][0], sizeof(w[0])) < 0) goto error;
+    if (camelliaGcmFinal(&gcm, t, sizeof(t)) < 0) goto error;
+    if (camelliaGcmInit(&gcm, &key128.data(), p, 12) < 0) goto error;
+    if (camelliaGcmAad(&gcm, k256, sizeof(k256)) < 0) goto error;
+    if (camelliaGcmDecrypt(&gcm, w[1][0], w[1][0], sizeof(w[1])) < 0) goto error;
+    if (camelliaGcmVerify(&gcm, t, sizeof(t)) < 0) goto error;
+    if (std::memcmp(w[0], w[1], sizeof(w[0]))) goto error;
+
+    /* ムーブ (ムーブ元の変換テーブルは消去する) */
+    {
+        camellia::Camellia128 moved(std::move(key128));
+
+        moved.encrypt(p, v);
+        if (std::memcmp(v, c128, sizeof(v))) goto error;
+        if (key128.data().type != CamelliaUnknown || key128.data().sk[0] != 0) goto error;
+        key128 = std::move(moved);
+        key128.encrypt(p, v);
+        if (std::memcmp(v, c128, sizeof(v))) goto error;
+    }
+
+    status = 0;
+error:
+    std::printf("%s\n", status < 0 ? "NG" : "OK");
+    return status < 0 ? 1 : 0;
+}